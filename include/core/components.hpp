@@ -1,16 +1,29 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <deque>
+#include <limits>
 #include <memory>
+#include <queue>
+#include <random>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
+#include "core/tower_grid.hpp"
 
-namespace towerforge::core {
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define TOWERFORGE_NEEDS_SSE 1
+#include <xmmintrin.h>
+#endif
 
-    // Forward declaration
-    class TowerGrid;
+namespace towerforge::core {
 
     /**
  * @brief Component for entities with a position in 2D space
@@ -57,7 +70,9 @@ namespace towerforge::core {
         Walking,               // Moving horizontally on same floor
         WaitingForElevator,    // Waiting for elevator to arrive
         InElevator,            // Currently in an elevator
-        AtDestination          // Reached final destination
+        AtDestination,         // Reached final destination
+        UsingStairs,           // Climbing or descending stairs/an escalator
+        Evacuating             // Heading for an exit during an evacuation
     };
 
     /**
@@ -78,6 +93,15 @@ namespace towerforge::core {
         Leaving                // Exiting the tower
     };
 
+    /**
+ * @brief A visitor's claim on a place at a facility
+ */
+    enum class FacilityHold {
+        None,                  // No place held
+        Reserved,              // Place held while walking there
+        Occupying              // Inside, counted in current_occupancy
+    };
+
     /**
  * @brief Component for Person entities with state machine and movement tracking
  * 
@@ -131,6 +155,8 @@ namespace towerforge::core {
                 case PersonState::WaitingForElevator:  return "WaitingForElevator";
                 case PersonState::InElevator:          return "InElevator";
                 case PersonState::AtDestination:       return "AtDestination";
+                case PersonState::UsingStairs:         return "UsingStairs";
+                case PersonState::Evacuating:          return "Evacuating";
                 default:                               return "Unknown";
             }
         }
@@ -181,80 +207,153 @@ namespace towerforge::core {
         Casual             // General visitor with balanced needs
     };
 
+    /**
+ * @brief Kinds of visitor need, in the order they are packed in VisitorNeeds
+ */
+    enum class NeedType : std::uint8_t {
+        Hunger,           // Satisfied by restaurants
+        Entertainment,    // Satisfied by arcades and theaters
+        Comfort,          // Satisfied by hotels
+        Shopping          // Satisfied by retail shops and flagship stores
+    };
+
     /**
  * @brief Component tracking visitor needs
  * 
  * Each need ranges from 0.0 (fully satisfied) to 100.0 (critical).
  * Visitors seek facilities to reduce their needs.
+ * 
+ * The four levels are packed in one 16-byte aligned float4 and grow at
+ * per-archetype constant rates, clamped at max_level. Because growth is
+ * linear and clamped, one Grow() over any interval gives exactly the same
+ * result as many small ones, so visitors that skip ticks catch up exactly
+ * the next time they are touched.
  */
     struct VisitorNeeds {
-        float hunger;         // Need for food/restaurants
-        float entertainment;  // Need for fun/arcades/theaters
-        float comfort;        // Need for rest/hotels
-        float shopping;       // Desire to shop/browse retail
+        static constexpr std::size_t need_count = 4;
+        static constexpr float max_level = 100.0f;
+
+        // Seconds of world time over which a need grows by its rate. The original once-a-second
+        // step grew needs by one 60 fps frame's worth, so the rates work out per minute.
+        static constexpr float growth_period = 60.0f;
 
+        // Growth per growth_period, per archetype (rows) and NeedType (columns)
+        alignas(16) static constexpr std::array<std::array<float, need_count>, 4> growth_rates = {{
+            {3.0f, 1.5f, 1.0f, 1.0f},   // BusinessPerson: busy people get hungry faster
+            {2.0f, 2.5f, 2.0f, 1.0f},   // Tourist: wants more fun and more rest
+            {2.0f, 1.5f, 1.0f, 2.5f},   // Shopper: wants to shop
+            {2.0f, 1.5f, 1.0f, 1.0f}    // Casual: default rates
+        }};
+
+        alignas(16) std::array<float, need_count> levels;  // Indexed by NeedType
         VisitorArchetype archetype;  // Visitor personality type
+        double updated_at;           // World time the levels were last grown to (negative until first touched)
 
         VisitorNeeds(const VisitorArchetype type = VisitorArchetype::Casual)
-            : hunger(0.0f),
-              entertainment(0.0f),
-              comfort(0.0f),
-              shopping(0.0f),
-              archetype(type) {
-            // Initialize random needs based on archetype
-            InitializeForArchetype();
+            : levels{},
+              archetype(type),
+              updated_at(-1.0) {
+            // Start in the middle of the archetype's ranges; spawning draws within them
+            FillForArchetype([](const float base, const int spread) {
+                return base + static_cast<float>(spread - 1) * 0.5f;
+            });
+        }
+
+        float& operator[](const NeedType need) {
+            return levels[static_cast<std::size_t>(need)];
+        }
+
+        const float& operator[](const NeedType need) const {
+            return levels[static_cast<std::size_t>(need)];
         }
 
         /**
-     * @brief Initialize needs based on visitor archetype
+     * @brief Initialize needs based on visitor archetype, drawing each from its range
+     * @param rng Random source (the spawner's, so a seeded tower spawns the same visitors)
      */
-        void InitializeForArchetype() {
-            switch (archetype) {
-                case VisitorArchetype::BusinessPerson:
-                    hunger = 30.0f + (rand() % 20);      // Moderate hunger
-                    entertainment = 10.0f + (rand() % 10); // Low entertainment need
-                    comfort = 20.0f + (rand() % 15);      // Some comfort need
-                    shopping = 5.0f + (rand() % 10);      // Low shopping interest
-                    break;
-                case VisitorArchetype::Tourist:
-                    hunger = 20.0f + (rand() % 15);       // Moderate hunger
-                    entertainment = 40.0f + (rand() % 30); // High entertainment need
-                    comfort = 25.0f + (rand() % 20);      // Moderate comfort need
-                    shopping = 30.0f + (rand() % 20);     // Moderate shopping interest
-                    break;
-                case VisitorArchetype::Shopper:
-                    hunger = 15.0f + (rand() % 15);       // Low hunger initially
-                    entertainment = 20.0f + (rand() % 15); // Moderate entertainment
-                    comfort = 15.0f + (rand() % 10);      // Low comfort need
-                    shopping = 50.0f + (rand() % 30);     // High shopping desire
-                    break;
-                case VisitorArchetype::Casual:
-                default:
-                    hunger = 25.0f + (rand() % 20);       // Balanced needs
-                    entertainment = 25.0f + (rand() % 20);
-                    comfort = 25.0f + (rand() % 20);
-                    shopping = 25.0f + (rand() % 20);
-                    break;
+        void InitializeForArchetype(std::mt19937& rng) {
+            FillForArchetype([&rng](const float base, const int spread) {
+                return base + static_cast<float>(std::uniform_int_distribution<int>(0, spread - 1)(rng));
+            });
+        }
+
+        /**
+     * @brief Get the growth rates for this visitor's archetype
+     */
+        const std::array<float, need_count>& GetGrowthRates() const {
+            return growth_rates[static_cast<std::size_t>(archetype)];
+        }
+
+        /**
+     * @brief Grow all needs over an interval of any length
+     * 
+     * levels = min(levels + rates * seconds / growth_period, max_level), as
+     * one float4 operation where SSE is available.
+     */
+        void Grow(const float seconds) {
+            const std::array<float, need_count>& rates = GetGrowthRates();
+            const float periods = seconds / growth_period;
+#if defined(TOWERFORGE_NEEDS_SSE)
+            const __m128 grown = _mm_add_ps(_mm_load_ps(levels.data()),
+                                            _mm_mul_ps(_mm_load_ps(rates.data()), _mm_set1_ps(periods)));
+            _mm_store_ps(levels.data(), _mm_min_ps(grown, _mm_set1_ps(max_level)));
+#else
+            for (std::size_t i = 0; i < need_count; ++i) {
+                levels[i] = std::min(max_level, levels[i] + rates[i] * periods);
+            }
+#endif
+        }
+
+        /**
+     * @brief Bring the levels up to a world time, growing over whatever was skipped
+     * 
+     * The first call only stamps the time.
+     */
+        void CatchUp(const double now) {
+            if (updated_at >= 0.0 && now > updated_at) {
+                Grow(static_cast<float>(now - updated_at));
             }
+            updated_at = std::max(updated_at, now);
         }
 
         /**
      * @brief Get the highest need value
      */
         float GetHighestNeed() const {
-            return std::max({hunger, entertainment, comfort, shopping});
+            return std::max({levels[0], levels[1], levels[2], levels[3]});
+        }
+
+        /**
+     * @brief Get the mean of the four needs
+     */
+        float GetAverageNeed() const {
+            return (levels[0] + levels[1] + levels[2] + levels[3]) / static_cast<float>(need_count);
+        }
+
+        /**
+     * @brief Get the type of the highest need (the first one on ties)
+     */
+        NeedType GetHighestNeedType() const {
+            std::size_t highest = 0;
+            for (std::size_t i = 1; i < need_count; ++i) {
+                if (levels[i] > levels[highest]) {
+                    highest = i;
+                }
+            }
+            return static_cast<NeedType>(highest);
         }
 
         /**
-     * @brief Get the type of the highest need
+     * @brief Get a need's display name, for the UI
      */
-        const char* GetHighestNeedType() const {
-            const float max_need = GetHighestNeed();
-            if (max_need == hunger) return "Hunger";
-            if (max_need == entertainment) return "Entertainment";
-            if (max_need == comfort) return "Comfort";
-            if (max_need == shopping) return "Shopping";
-            return "None";
+        static const char* GetNeedName(const NeedType need) {
+            switch (need) {
+                case NeedType::Hunger: return "Hunger";
+                case NeedType::Entertainment: return "Entertainment";
+                case NeedType::Comfort: return "Comfort";
+                case NeedType::Shopping: return "Shopping";
+                default: return "None";
+            }
         }
 
         /**
@@ -271,57 +370,47 @@ namespace towerforge::core {
         }
 
         /**
-     * @brief Update needs over time (they increase)
+     * @brief Reduce a specific need
      */
-        void UpdateNeeds(const float delta_time) {
-            // Needs grow at different rates based on archetype
-            float hunger_rate = 2.0f;
-            float entertainment_rate = 1.5f;
-            float comfort_rate = 1.0f;
-            float shopping_rate = 1.0f;
+        void ReduceNeed(const NeedType need, const float amount) {
+            float& level = (*this)[need];
+            level = std::max(0.0f, level - amount);
+        }
 
+    private:
+        /**
+     * @brief Set each need from its archetype's base and spread
+     */
+        template<typename Roll>
+        void FillForArchetype(Roll roll) {
+            auto& needs = *this;
             switch (archetype) {
                 case VisitorArchetype::BusinessPerson:
-                    hunger_rate = 3.0f;  // Busy people get hungry faster
+                    needs[NeedType::Hunger] = roll(30.0f, 20);        // Moderate hunger
+                    needs[NeedType::Entertainment] = roll(10.0f, 10); // Low entertainment need
+                    needs[NeedType::Comfort] = roll(20.0f, 15);       // Some comfort need
+                    needs[NeedType::Shopping] = roll(5.0f, 10);       // Low shopping interest
                     break;
                 case VisitorArchetype::Tourist:
-                    entertainment_rate = 2.5f;  // Tourists want more fun
-                    comfort_rate = 2.0f;         // And more rest
+                    needs[NeedType::Hunger] = roll(20.0f, 15);        // Moderate hunger
+                    needs[NeedType::Entertainment] = roll(40.0f, 30); // High entertainment need
+                    needs[NeedType::Comfort] = roll(25.0f, 20);       // Moderate comfort need
+                    needs[NeedType::Shopping] = roll(30.0f, 20);      // Moderate shopping interest
                     break;
                 case VisitorArchetype::Shopper:
-                    shopping_rate = 2.5f;  // Shoppers want to shop
+                    needs[NeedType::Hunger] = roll(15.0f, 15);        // Low hunger initially
+                    needs[NeedType::Entertainment] = roll(20.0f, 15); // Moderate entertainment
+                    needs[NeedType::Comfort] = roll(15.0f, 10);       // Low comfort need
+                    needs[NeedType::Shopping] = roll(50.0f, 30);      // High shopping desire
                     break;
                 case VisitorArchetype::Casual:
                 default:
-                    // Use default rates
+                    needs[NeedType::Hunger] = roll(25.0f, 20);        // Balanced needs
+                    needs[NeedType::Entertainment] = roll(25.0f, 20);
+                    needs[NeedType::Comfort] = roll(25.0f, 20);
+                    needs[NeedType::Shopping] = roll(25.0f, 20);
                     break;
             }
-
-            hunger += hunger_rate * delta_time;
-            entertainment += entertainment_rate * delta_time;
-            comfort += comfort_rate * delta_time;
-            shopping += shopping_rate * delta_time;
-
-            // Clamp to maximum
-            hunger = std::min(100.0f, hunger);
-            entertainment = std::min(100.0f, entertainment);
-            comfort = std::min(100.0f, comfort);
-            shopping = std::min(100.0f, shopping);
-        }
-
-        /**
-     * @brief Reduce a specific need
-     */
-        void ReduceNeed(const char* need_type, const float amount) {
-            if (strcmp(need_type, "Hunger") == 0) {
-                hunger = std::max(0.0f, hunger - amount);
-            } else if (strcmp(need_type, "Entertainment") == 0) {
-                entertainment = std::max(0.0f, entertainment - amount);
-            } else if (strcmp(need_type, "Comfort") == 0) {
-                comfort = std::max(0.0f, comfort - amount);
-            } else if (strcmp(need_type, "Shopping") == 0) {
-                shopping = std::max(0.0f, shopping - amount);
-            }
         }
     };
 
@@ -335,6 +424,8 @@ namespace towerforge::core {
         float visit_duration;          // How long they've been in the tower (seconds)
         float max_visit_duration;      // When they'll leave (seconds)
         int target_facility_floor;     // Floor of facility they're visiting (-1 if none)
+        std::uint64_t target_facility_id; // Facility they hold a place at (0 if none)
+        FacilityHold facility_hold;    // Whether that place is reserved or occupied
         float time_at_destination;     // Time spent at current destination (seconds)
         bool is_interacting;           // Currently using a facility
         float interaction_time;        // Time spent at current facility
@@ -345,6 +436,8 @@ namespace towerforge::core {
               visit_duration(0.0f),
               max_visit_duration(300.0f),  // 5 minutes default
               target_facility_floor(-1),
+              target_facility_id(0),
+              facility_hold(FacilityHold::None),
               time_at_destination(0.0f),
               is_interacting(false),
               interaction_time(0.0f),
@@ -371,6 +464,148 @@ namespace towerforge::core {
         }
     };
 
+    /**
+ * @brief Aggregate of off-screen visitors sharing a floor and archetype
+ * 
+ * Used by the statistical crowd mode: members are not entities, only a
+ * count with averaged needs, satisfaction and remaining visit time.
+ */
+    struct CrowdCohort {
+        int floor;
+        float count;                  // Members (fractional while departures accrue)
+        VisitorNeeds needs;           // Average needs; archetype is shared by all members
+        float satisfaction;           // Average satisfaction score
+        float remaining_visit_time;   // Average seconds left before members leave
+        float column;                 // Average column, used when members are re-materialized
+
+        CrowdCohort(const int f = 0, const VisitorArchetype type = VisitorArchetype::Casual)
+            : floor(f),
+              count(0.0f),
+              needs(type),
+              satisfaction(75.0f),
+              remaining_visit_time(0.0f),
+              column(0.0f) {}
+
+        /**
+     * @brief Fold one visitor into the running averages
+     */
+        void Absorb(const VisitorNeeds& visitor_needs, const float satisfaction_score,
+                    const float remaining_time, const float current_column) {
+            count += 1.0f;
+            const float weight = 1.0f / count;
+            for (std::size_t i = 0; i < VisitorNeeds::need_count; ++i) {
+                needs.levels[i] += (visitor_needs.levels[i] - needs.levels[i]) * weight;
+            }
+            satisfaction += (satisfaction_score - satisfaction) * weight;
+            remaining_visit_time += (remaining_time - remaining_visit_time) * weight;
+            column += (current_column - column) * weight;
+        }
+
+        /**
+     * @brief Advance the cohort over a span in one step
+     *
+     * Departures are linear in the remaining visit time, as in the per-second
+     * update. Satisfaction relaxes toward the needs at the end of the span.
+     * @return Members who left during the span
+     */
+        float CatchUp(const float seconds) {
+            needs.Grow(seconds);
+            const float target = 100.0f - needs.GetAverageNeed();
+            satisfaction = target + (satisfaction - target) * std::pow(0.95f, seconds);
+
+            const float remaining = std::max(0.0f, remaining_visit_time - seconds);
+            const float departures = remaining > 0.0f ? count * (seconds / remaining_visit_time) : count;
+            count -= departures;
+            remaining_visit_time = remaining;
+            return departures;
+        }
+    };
+
+    /**
+ * @brief Global singleton for the statistical crowd mode
+ * 
+ * When the individual visitor population exceeds the threshold, visitors
+ * on floors outside the camera view that aren't using elevators are folded
+ * into per-floor, per-archetype cohorts. Cohorts become individual entities
+ * again when their floor scrolls into view or is inspected.
+ */
+    struct CrowdSimulation {
+        bool enabled;                   // Whether crowd aggregation is active
+        int population_threshold;       // Individual visitors above this are folded into cohorts
+        int visible_floor_min;          // Lowest floor in the camera view
+        int visible_floor_max;          // Highest floor in the camera view (below min = nothing visible)
+        std::vector<CrowdCohort> cohorts;
+        std::unordered_map<std::int64_t, size_t> cohort_index;  // (floor, archetype) key -> slot in cohorts
+        std::vector<int> materialize_requests;                   // Floors inspected since the last pass
+        float total_members;            // Sum of cohort counts
+        float total_departed;           // Cohort members who left the tower (fractional, like the counts)
+
+        CrowdSimulation(const int threshold = 5000, const bool enable = true)
+            : enabled(enable),
+              population_threshold(threshold),
+              visible_floor_min(0),
+              visible_floor_max(-1),
+              total_members(0.0f),
+              total_departed(0.0f) {}
+
+        void SetVisibleFloors(const int min_floor, const int max_floor) {
+            visible_floor_min = min_floor;
+            visible_floor_max = max_floor;
+        }
+
+        bool IsFloorVisible(const int floor) const {
+            return floor >= visible_floor_min && floor <= visible_floor_max;
+        }
+
+        /**
+     * @brief Ask for a floor's cohorts to become individuals (e.g. the player inspected it)
+     */
+        void RequestMaterialize(const int floor) {
+            materialize_requests.push_back(floor);
+        }
+
+        bool IsMaterializeRequested(const int floor) const {
+            return std::find(materialize_requests.begin(), materialize_requests.end(), floor) != materialize_requests.end();
+        }
+
+        /**
+     * @brief Get (or create) the cohort for a floor and archetype
+     */
+        CrowdCohort& GetCohort(const int floor, const VisitorArchetype archetype) {
+            const std::int64_t key = (static_cast<std::int64_t>(floor) << 8) | static_cast<std::int64_t>(archetype);
+            const auto it = cohort_index.find(key);
+            if (it != cohort_index.end()) {
+                return cohorts[it->second];
+            }
+            cohort_index[key] = cohorts.size();
+            cohorts.emplace_back(floor, archetype);
+            return cohorts.back();
+        }
+
+        /**
+     * @brief Remove the cohort at a slot in O(1) (swap with the last slot)
+     */
+        void RemoveCohort(const size_t slot) {
+            const auto key_of = [](const CrowdCohort& cohort) {
+                return (static_cast<std::int64_t>(cohort.floor) << 8) | static_cast<std::int64_t>(cohort.needs.archetype);
+            };
+            cohort_index.erase(key_of(cohorts[slot]));
+            if (slot + 1 != cohorts.size()) {
+                cohorts[slot] = cohorts.back();
+                cohort_index[key_of(cohorts[slot])] = slot;
+            }
+            cohorts.pop_back();
+        }
+
+        int GetMemberCount() const {
+            return static_cast<int>(total_members + 0.5f);
+        }
+
+        int GetDepartedCount() const {
+            return static_cast<int>(total_departed + 0.5f);
+        }
+    };
+
     /**
  * @brief Component for employee NPCs
  * 
@@ -380,6 +615,7 @@ namespace towerforge::core {
         std::string job_title;         // Job title (e.g., "Office Worker", "Shop Clerk")
         int workplace_floor;           // Floor where they work
         int workplace_column;          // Column where workplace is located
+        std::uint64_t workplace_facility_id;  // Facility entity holding this position (0 if none)
     
         // Shift schedule (simple 5-day week)
         float shift_start_hour;        // Hour when shift starts (e.g., 9.0 for 9 AM)
@@ -396,6 +632,7 @@ namespace towerforge::core {
             : job_title(title),
               workplace_floor(floor),
               workplace_column(col),
+              workplace_facility_id(0),
               shift_start_hour(start_hour),
               shift_end_hour(end_hour),
               currently_on_shift(false) {
@@ -450,6 +687,7 @@ namespace towerforge::core {
  * - Restaurant: Food service facility. Requires cooks and servers.
  * - Hotel: Temporary lodging. Requires receptionists and cleaning staff.
  * - Elevator: Vertical transportation.
+ * - Stairs / Escalator: Walk-on link to the floor above for short trips.
  * - Gym: Fitness and wellness center. Requires trainers/attendants.
  * - Arcade: Entertainment venue. Requires clerks.
  * - Theater: Entertainment venue. Requires ushers.
@@ -471,23 +709,91 @@ namespace towerforge::core {
             ConferenceHall,   // Conference/event space
             FlagshipStore,    // Large retail store
             ManagementOffice, // Tower management office (generates tower points)
-            SatelliteOffice   // Satellite management office (boosts tower points generation)
+            SatelliteOffice,  // Satellite management office (boosts tower points generation)
+            Stairs,           // Stairs to the floor above
+            Escalator         // Escalator to the floor above
         };
 
+        static constexpr std::size_t type_count = static_cast<std::size_t>(Type::Escalator) + 1;
+
         Type type;
         int floor;              // Which floor this component is on
         int column;             // Which column this component starts at
         int width;              // Width in tiles
         int capacity;           // Maximum occupancy
         int current_occupancy;  // Current number of people
+        int reserved_slots;     // Places held by visitors on their way here
         int job_openings;       // Number of unfilled jobs at this facility
         int current_staff;      // Current number of staff assigned
         float operating_start_hour;  // Start of operating hours (e.g., 9.0 for 9 AM)
         float operating_end_hour;    // End of operating hours (e.g., 21.0 for 9 PM)
 
         BuildingComponent(const Type t = Type::Office, const int f = 0, const int col = 0, const int w = 1, const int cap = 10)
-            : type(t), floor(f), column(col), width(w), capacity(cap), current_occupancy(0), job_openings(0),
-              current_staff(0), operating_start_hour(9.0f), operating_end_hour(17.0f) {}
+            : type(t), floor(f), column(col), width(w), capacity(cap), current_occupancy(0), reserved_slots(0),
+              job_openings(0), current_staff(0), operating_start_hour(9.0f), operating_end_hour(17.0f) {}
+
+        /**
+     * @brief Get the places left once occupants and reservations are counted
+     */
+        int GetFreeSlots() const {
+            return std::max(0, capacity - current_occupancy - reserved_slots);
+        }
+
+        /**
+     * @brief Hold a place for a visitor on their way here
+     * 
+     * @return false if the facility is full
+     */
+        bool Reserve() {
+            if (GetFreeSlots() <= 0) {
+                return false;
+            }
+            reserved_slots++;
+            return true;
+        }
+
+        /**
+     * @brief Take a place without a reservation
+     * @return false if the facility is full
+     */
+        bool Enter() {
+            if (GetFreeSlots() <= 0) {
+                return false;
+            }
+            current_occupancy++;
+            return true;
+        }
+
+        /**
+     * @brief A visitor with a reservation arrived and takes their place
+     */
+        void ClaimReservation() {
+            reserved_slots = std::max(0, reserved_slots - 1);
+            current_occupancy++;
+        }
+
+        /**
+     * @brief A visitor with a reservation went elsewhere
+     */
+        void CancelReservation() {
+            reserved_slots = std::max(0, reserved_slots - 1);
+        }
+
+        /**
+     * @brief An occupant left
+     */
+        void Vacate() {
+            current_occupancy = std::max(0, current_occupancy - 1);
+        }
+
+        /**
+     * @brief Check if a position lies inside this facility
+     */
+        bool Contains(const int at_floor, const float at_column) const {
+            return at_floor == floor &&
+                   at_column >= static_cast<float>(column) &&
+                   at_column < static_cast<float>(column + width);
+        }
     
         /**
      * @brief Get the number of employees needed for this facility type
@@ -516,6 +822,13 @@ namespace towerforge::core {
             return type == Type::ManagementOffice || type == Type::SatelliteOffice;
         }
     
+        /**
+     * @brief Check if this facility links its floor to the one above (stairs or escalator)
+     */
+        bool IsFloorConnector() const {
+            return type == Type::Stairs || type == Type::Escalator;
+        }
+    
         /**
      * @brief Check if this facility has job openings
      */
@@ -548,94 +861,763 @@ namespace towerforge::core {
     };
 
     /**
- * @brief Global singleton component for tower-wide NPC spawning
+ * @brief The visitor need a facility type satisfies, if any
+ */
+    struct FacilityNeed {
+        bool serves_need;
+        NeedType need;
+    };
+
+    /**
+ * @brief Facility types that satisfy one need
+ */
+    struct NeedFacilityTypes {
+        std::array<BuildingComponent::Type, BuildingComponent::type_count> types;
+        std::size_t count;
+    };
+
+    /**
+ * @brief Need served by each facility type, indexed by BuildingComponent::Type
  * 
- * Manages spawning of visitors and tracking of available jobs.
+ * Built at compile time; the single source for which facilities satisfy
+ * which needs.
  */
-    struct NPCSpawner {
-        float time_since_last_spawn;        // Time since last visitor spawn
-        float spawn_interval;               // Base interval between spawns (seconds)
-        int total_visitors_spawned;         // Total count of spawned visitors
-        int total_employees_hired;          // Total count of employees hired
-        int next_visitor_id;                // ID counter for naming visitors
-        int max_active_visitors;            // Maximum number of active visitors at once
-    
-        NPCSpawner(const float interval = 30.0f, const int max_visitors = 50)
-            : time_since_last_spawn(0.0f),
-              spawn_interval(interval),
-              total_visitors_spawned(0),
-              total_employees_hired(0),
-              next_visitor_id(1),
-              max_active_visitors(max_visitors) {}
-    
-        /**
-     * @brief Calculate dynamic spawn rate based on tower state
-     */
-        float GetDynamicSpawnInterval(const int facility_count) const {
-            // More facilities = more visitors
-            // Base: 30 seconds, decreases to 10 seconds with 10+ facilities
-            const float adjusted = spawn_interval * (1.0f - (facility_count * 0.02f));
-            return std::max(10.0f, std::min(60.0f, adjusted));
+    inline constexpr std::array<FacilityNeed, BuildingComponent::type_count> facility_need_table = [] {
+        std::array<FacilityNeed, BuildingComponent::type_count> table{};
+        const auto serve = [&table](const BuildingComponent::Type type, const NeedType need) {
+            table[static_cast<std::size_t>(type)] = {true, need};
+        };
+        serve(BuildingComponent::Type::Restaurant, NeedType::Hunger);
+        serve(BuildingComponent::Type::Arcade, NeedType::Entertainment);
+        serve(BuildingComponent::Type::Theater, NeedType::Entertainment);
+        serve(BuildingComponent::Type::Hotel, NeedType::Comfort);
+        serve(BuildingComponent::Type::RetailShop, NeedType::Shopping);
+        serve(BuildingComponent::Type::FlagshipStore, NeedType::Shopping);
+        return table;
+    }();
+
+    /**
+ * @brief Facility types serving each need, indexed by NeedType; the inverse of facility_need_table
+ */
+    inline constexpr std::array<NeedFacilityTypes, VisitorNeeds::need_count> need_facility_table = [] {
+        std::array<NeedFacilityTypes, VisitorNeeds::need_count> table{};
+        for (std::size_t type = 0; type < BuildingComponent::type_count; ++type) {
+            if (facility_need_table[type].serves_need) {
+                NeedFacilityTypes& entry = table[static_cast<std::size_t>(facility_need_table[type].need)];
+                entry.types[entry.count++] = static_cast<BuildingComponent::Type>(type);
+            }
         }
-    };
+        return table;
+    }();
 
     /**
- * @brief Global singleton component for managing simulation time
+ * @brief Look up the need a facility type serves
+ */
+    constexpr const FacilityNeed& GetFacilityNeed(const BuildingComponent::Type type) {
+        return facility_need_table[static_cast<std::size_t>(type)];
+    }
+
+    /**
+ * @brief Look up the facility types that serve a need
+ */
+    constexpr const NeedFacilityTypes& GetNeedFacilityTypes(const NeedType need) {
+        return need_facility_table[static_cast<std::size_t>(need)];
+    }
+
+    /**
+ * @brief Global singleton index of open positions at staffed facilities
  * 
- * This component tracks the current simulation time, including hours,
- * days, and weeks. It also manages the simulation speed for pause
- * and fast-forward functionality.
+ * Postings are keyed by facility entity ID and updated incrementally when
+ * facilities are placed or removed and when employees are hired, fired or
+ * despawned, so hiring never has to scan every facility and employee.
+ * Open slots are handed out through a priority queue that favours the most
+ * understaffed facilities; stale entries are discarded lazily when popped.
  */
-    struct TimeManager {
-        float current_hour;        // Current hour of the day (0.0 - 24.0)
-        int current_day;           // Current day of the week (0 = Monday, 6 = Sunday)
-        int current_week;          // Current week number
-        float simulation_speed;    // Speed multiplier (0.0 = paused, 1.0 = normal, 2.0 = 2x speed)
-        float hours_per_second;    // How many in-game hours pass per real-time second
-    
-        TimeManager(const float hours_per_sec = 1.0f)
-            : current_hour(8.0f),      // Start at 8 AM
-              current_day(0),          // Start on Monday
-              current_week(1),         // Start at week 1
-              simulation_speed(1.0f),  // Normal speed
-              hours_per_second(hours_per_sec) {}
-    
+    struct JobBoard {
+        struct Posting {
+            BuildingComponent::Type type;
+            int floor;
+            int column;
+            int width;
+            int required;        // Positions the facility needs filled
+            int filled;          // Positions currently held by employees
+            bool hireable;       // Whether job seekers can be hired here
+
+            int GetOpenPositions() const {
+                return std::max(0, required - filled);
+            }
+        };
+
+        struct OpenSlot {
+            std::uint64_t facility_id;
+            int filled_when_posted;   // Staffing level when the slot was posted
+            std::uint64_t sequence;   // Posting order, for FIFO among equals
+
+            // std::priority_queue is a max-heap: the "largest" slot is the least staffed, oldest one
+            bool operator<(const OpenSlot& other) const {
+                if (filled_when_posted != other.filled_when_posted) {
+                    return filled_when_posted > other.filled_when_posted;
+                }
+                return sequence > other.sequence;
+            }
+        };
+
+        std::unordered_map<std::uint64_t, Posting> postings;
+        std::priority_queue<OpenSlot> open_slots;
+        std::uint64_t next_sequence;
+        int total_open_positions;     // Open positions across all postings
+
+        JobBoard()
+            : next_sequence(0),
+              total_open_positions(0) {}
+
         /**
-     * @brief Get the current time as a formatted string (HH:MM)
+     * @brief Add or refresh the posting for a facility
+     * 
+     * Facilities that need no employees are not tracked. When the number of
+     * required employees grows, one queue entry is pushed per new opening.
      */
-        std::string GetTimeString() const {
-            const int hours = static_cast<int>(current_hour);
-            const int minutes = static_cast<int>((current_hour - hours) * 60.0f);
-            char buffer[6];
-            snprintf(buffer, sizeof(buffer), "%02d:%02d", hours, minutes);
-            return std::string(buffer);
+        void PostFacility(const std::uint64_t facility_id, const BuildingComponent& facility, const bool hireable) {
+            const int required = facility.GetRequiredEmployees();
+            auto it = postings.find(facility_id);
+            if (it == postings.end()) {
+                if (required <= 0) {
+                    return;
+                }
+                it = postings.emplace(facility_id, Posting{facility.type, facility.floor, facility.column,
+                                                           facility.width, 0, 0, hireable}).first;
+            }
+
+            Posting& posting = it->second;
+            const int previous_open = posting.GetOpenPositions();
+            posting.type = facility.type;
+            posting.floor = facility.floor;
+            posting.column = facility.column;
+            posting.width = facility.width;
+            posting.required = required;
+            posting.hireable = hireable;
+
+            const int open = posting.GetOpenPositions();
+            total_open_positions += open - previous_open;
+            for (int i = previous_open; i < open; ++i) {
+                PushSlot(facility_id, posting);
+            }
         }
-    
+
         /**
-     * @brief Get the current day name
+     * @brief Drop the posting for a removed facility
      */
-        const char* GetDayName() const {
-            static const char* day_names[] = {
-                "Monday", "Tuesday", "Wednesday", "Thursday", 
-                "Friday", "Saturday", "Sunday"
-            };
-            return day_names[current_day % 7];
+        void RemoveFacility(const std::uint64_t facility_id) {
+            const auto it = postings.find(facility_id);
+            if (it == postings.end()) {
+                return;
+            }
+            total_open_positions -= it->second.GetOpenPositions();
+            postings.erase(it);
         }
-    
+
         /**
-     * @brief Check if current time is within business hours (9 AM - 5 PM)
+     * @brief Claim the most urgent open hireable position
+     * 
+     * @param facility_id Receives the facility entity ID of the claimed position
+     * @return true if a position was claimed, false if none are open
      */
-        bool IsBusinessHours() const {
-            return current_hour >= 9.0f && current_hour < 17.0f;
+        bool ClaimOpening(std::uint64_t& facility_id) {
+            while (!open_slots.empty()) {
+                const OpenSlot slot = open_slots.top();
+                open_slots.pop();
+
+                const auto it = postings.find(slot.facility_id);
+                if (it == postings.end() || !it->second.hireable || it->second.GetOpenPositions() <= 0) {
+                    continue;  // Stale entry: facility removed or already staffed
+                }
+
+                it->second.filled++;
+                total_open_positions--;
+                facility_id = slot.facility_id;
+                return true;
+            }
+            return false;
         }
-    
+
         /**
-     * @brief Check if it's a weekend
+     * @brief Count an employee placed at a facility without going through ClaimOpening
+     * 
+     * Used for employees given their EmploymentInfo directly. The position is
+     * counted even if the facility is already fully staffed.
+     * 
+     * @return false if the facility has no posting
      */
-        bool IsWeekend() const {
-            return current_day == 5 || current_day == 6;  // Saturday or Sunday
+        bool FillPosition(const std::uint64_t facility_id) {
+            const auto it = postings.find(facility_id);
+            if (it == postings.end()) {
+                return false;
+            }
+
+            Posting& posting = it->second;
+            const int previous_open = posting.GetOpenPositions();
+            posting.filled++;
+            total_open_positions -= previous_open - posting.GetOpenPositions();
+            return true;
         }
-    };
+
+        /**
+     * @brief Return a position to the board when its employee leaves
+     */
+        void ReleasePosition(const std::uint64_t facility_id) {
+            const auto it = postings.find(facility_id);
+            if (it == postings.end() || it->second.filled <= 0) {
+                return;
+            }
+
+            Posting& posting = it->second;
+            const int previous_open = posting.GetOpenPositions();
+            posting.filled--;
+            if (posting.GetOpenPositions() > previous_open) {
+                total_open_positions++;
+                PushSlot(facility_id, posting);
+            }
+        }
+
+        /**
+     * @brief Get the posting for a facility, or nullptr if it is not tracked
+     */
+        const Posting* GetPosting(const std::uint64_t facility_id) const {
+            const auto it = postings.find(facility_id);
+            return it != postings.end() ? &it->second : nullptr;
+        }
+
+        /**
+     * @brief Get the number of open positions at a facility
+     */
+        int GetOpenPositions(const std::uint64_t facility_id) const {
+            const Posting* posting = GetPosting(facility_id);
+            return posting ? posting->GetOpenPositions() : 0;
+        }
+
+    private:
+        void PushSlot(const std::uint64_t facility_id, const Posting& posting) {
+            if (posting.hireable) {
+                open_slots.push({facility_id, posting.filled, next_sequence++});
+            }
+        }
+    };
+
+    /**
+ * @brief Singleton index of facilities by type, each list sorted by floor
+ * 
+ * Kept current by BuildingComponent observers. Needs-driven visitors ask it
+ * for the best facility of a type near them instead of scanning every
+ * facility: the search starts at the visitor's floor (binary search) and
+ * widens floor by floor until no farther facility could beat the best one
+ * found, so a query scores a handful of candidates rather than all of them.
+ */
+    struct FacilityTypeIndex {
+        struct Entry {
+            std::uint64_t facility_id;
+            int floor;
+            float center_column;
+            int capacity;
+        };
+
+        /**
+     * @brief Live state of a candidate, read from its entity while scoring
+     */
+        struct Condition {
+            bool available;   // False if the facility is gone or closed to visitors
+            int occupancy;    // People inside plus places reserved by others
+            float quality;    // 0.0 to 100.0 (facility satisfaction or upkeep)
+        };
+
+        /**
+     * @brief Columns a facility covers on its floor, for position lookups
+     */
+        struct Placement {
+            std::uint64_t facility_id;
+            int column;
+            int width;
+        };
+
+        struct Choice {
+            std::uint64_t facility_id = 0;
+            BuildingComponent::Type type = BuildingComponent::Type::Office;
+            int floor = -1;
+            float column = -1.0f;
+            float score = -std::numeric_limits<float>::infinity();
+
+            bool IsValid() const { return facility_id != 0; }
+        };
+
+        std::unordered_map<BuildingComponent::Type, std::vector<Entry>> by_type;
+        std::unordered_map<std::uint64_t, BuildingComponent::Type> types;
+        std::unordered_map<int, std::vector<Placement>> by_floor;
+
+        // Utility weights: score = need - travel + free capacity + quality
+        float floor_penalty;      // Score lost per floor between visitor and facility
+        float column_penalty;     // Score lost per column walked on the facility's floor
+        float capacity_weight;    // Score of an empty facility, scaled down as it fills
+        float quality_weight;     // Score per quality point above (or below) 50
+        int max_candidates;       // Most candidates scored per type in one query
+
+        FacilityTypeIndex()
+            : floor_penalty(4.0f),
+              column_penalty(0.1f),
+              capacity_weight(20.0f),
+              quality_weight(0.2f),
+              max_candidates(16) {}
+
+        /**
+     * @brief Add or move a facility in the index
+     */
+        void Add(const std::uint64_t facility_id, const BuildingComponent& facility) {
+            Remove(facility_id);
+            std::vector<Entry>& entries = by_type[facility.type];
+            const auto position = std::upper_bound(entries.begin(), entries.end(), facility.floor,
+                                                   [](const int floor, const Entry& entry) {
+                                                       return floor < entry.floor;
+                                                   });
+            entries.insert(position, Entry{facility_id, facility.floor,
+                                           static_cast<float>(facility.column) + static_cast<float>(facility.width) / 2.0f,
+                                           facility.capacity});
+            types[facility_id] = facility.type;
+            by_floor[facility.floor].push_back(Placement{facility_id, facility.column, facility.width});
+        }
+
+        /**
+     * @brief Drop a removed facility from the index
+     */
+        void Remove(const std::uint64_t facility_id) {
+            const auto it = types.find(facility_id);
+            if (it == types.end()) {
+                return;
+            }
+            std::vector<Entry>& entries = by_type[it->second];
+            const auto entry = std::find_if(entries.begin(), entries.end(), [facility_id](const Entry& candidate) {
+                return candidate.facility_id == facility_id;
+            });
+            if (entry != entries.end()) {
+                std::erase_if(by_floor[entry->floor], [facility_id](const Placement& placement) {
+                    return placement.facility_id == facility_id;
+                });
+                entries.erase(entry);
+            }
+            types.erase(it);
+        }
+
+        /**
+     * @brief Get the facility covering a position, or 0 if there is none
+     */
+        std::uint64_t FindAt(const int floor, const float column) const {
+            const auto it = by_floor.find(floor);
+            if (it == by_floor.end()) {
+                return 0;
+            }
+            for (const Placement& placement : it->second) {
+                if (column >= static_cast<float>(placement.column) &&
+                    column < static_cast<float>(placement.column + placement.width)) {
+                    return placement.facility_id;
+                }
+            }
+            return 0;
+        }
+
+        /**
+     * @brief Get the number of indexed facilities of a type
+     */
+        std::size_t GetCount(const BuildingComponent::Type type) const {
+            const auto it = by_type.find(type);
+            return it != by_type.end() ? it->second.size() : 0;
+        }
+
+        /**
+     * @brief Utility of a facility for a visitor, or -infinity if it can't take them
+     */
+        float Score(const float need_level, const Entry& entry, const int floor, const float column,
+                    const Condition& condition) const {
+            if (!condition.available || (entry.capacity > 0 && condition.occupancy >= entry.capacity)) {
+                return -std::numeric_limits<float>::infinity();
+            }
+            const float free_share = entry.capacity > 0
+                                         ? 1.0f - static_cast<float>(condition.occupancy) / static_cast<float>(entry.capacity)
+                                         : 1.0f;
+            const float column_distance = entry.floor == floor ? std::abs(entry.center_column - column) : 0.0f;
+            return need_level
+                   - floor_penalty * static_cast<float>(std::abs(entry.floor - floor))
+                   - column_penalty * column_distance
+                   + capacity_weight * free_share
+                   + quality_weight * (condition.quality - 50.0f);
+        }
+
+        /**
+     * @brief Best score any facility this many floors away could reach
+     */
+        float GetScoreBound(const float need_level, const int floor_distance) const {
+            return need_level - floor_penalty * static_cast<float>(floor_distance)
+                   + capacity_weight + quality_weight * 50.0f;
+        }
+
+        /**
+     * @brief Score the facilities of one type nearest to a visitor
+     * 
+     * Replaces best when a candidate scores higher, so several types (and
+     * several needs) can be folded into one choice. Candidates are visited
+     * nearest floor first; ties keep the nearer one.
+     * 
+     * @param get_condition Callable taking a facility ID and returning its Condition
+     */
+        template <typename GetCondition>
+        void FindBest(const BuildingComponent::Type type, const float need_level, const int floor,
+                      const float column, GetCondition&& get_condition, Choice& best) const {
+            const auto it = by_type.find(type);
+            if (it == by_type.end() || it->second.empty()) {
+                return;
+            }
+            const std::vector<Entry>& entries = it->second;
+
+            // above walks up from the visitor's floor, below walks down
+            std::size_t above = static_cast<std::size_t>(
+                std::lower_bound(entries.begin(), entries.end(), floor, [](const Entry& entry, const int value) {
+                    return entry.floor < value;
+                }) - entries.begin());
+            std::size_t below = above;
+
+            int scored = 0;
+            while (scored < max_candidates && (above < entries.size() || below > 0)) {
+                const int above_distance = above < entries.size() ? entries[above].floor - floor
+                                                                  : std::numeric_limits<int>::max();
+                const int below_distance = below > 0 ? floor - entries[below - 1].floor
+                                                     : std::numeric_limits<int>::max();
+                const bool take_above = above_distance <= below_distance;
+                const Entry& entry = take_above ? entries[above] : entries[below - 1];
+                if (GetScoreBound(need_level, std::min(above_distance, below_distance)) <= best.score) {
+                    break;  // Everything left is farther away and can't win
+                }
+                if (take_above) {
+                    above++;
+                } else {
+                    below--;
+                }
+
+                const float score = Score(need_level, entry, floor, column, get_condition(entry.facility_id));
+                scored++;
+                if (score > best.score) {
+                    best.facility_id = entry.facility_id;
+                    best.type = type;
+                    best.floor = entry.floor;
+                    best.column = entry.center_column;
+                    best.score = score;
+                }
+            }
+        }
+    };
+
+    /**
+ * @brief Visitor arrival rates by day of week and hour of day
+ * 
+ * Rates are expected arrivals per simulated hour. Arrivals follow a
+ * non-homogeneous Poisson process whose rate is constant within each hour,
+ * so the expected count over any span is the integral of the rate across
+ * the hours it covers.
+ */
+    struct ArrivalProfile {
+        std::array<std::array<float, 24>, 7> hourly_rates;  // [day][hour], 0 = Monday
+
+        ArrivalProfile() {
+            UseDefaultProfile();
+        }
+
+        /**
+     * @brief Weekdays peak at the morning commute, lunch and evening; weekends peak mid-afternoon
+     */
+        void UseDefaultProfile() {
+            static constexpr std::array<float, 24> weekday = {
+                2.0f, 1.0f, 1.0f, 1.0f, 2.0f, 4.0f,           // 00:00 - 05:59
+                12.0f, 45.0f, 120.0f, 80.0f, 50.0f, 70.0f,    // 06:00 - 11:59
+                110.0f, 85.0f, 50.0f, 50.0f, 60.0f, 95.0f,    // 12:00 - 17:59
+                75.0f, 50.0f, 30.0f, 15.0f, 6.0f, 3.0f        // 18:00 - 23:59
+            };
+            static constexpr std::array<float, 24> weekend = {
+                3.0f, 2.0f, 1.0f, 1.0f, 1.0f, 2.0f,           // 00:00 - 05:59
+                4.0f, 8.0f, 20.0f, 40.0f, 65.0f, 85.0f,       // 06:00 - 11:59
+                100.0f, 110.0f, 105.0f, 90.0f, 75.0f, 60.0f,  // 12:00 - 17:59
+                55.0f, 45.0f, 35.0f, 20.0f, 10.0f, 5.0f       // 18:00 - 23:59
+            };
+            for (int day = 0; day < 7; ++day) {
+                hourly_rates[day] = day >= 5 ? weekend : weekday;
+            }
+        }
+
+        /**
+     * @brief Replace the arrival curve for one day of the week
+     */
+        void SetDailyRates(const int day, const std::array<float, 24>& rates) {
+            hourly_rates[((day % 7) + 7) % 7] = rates;
+        }
+
+        /**
+     * @brief Arrival rate (per sim-hour) in effect at a given time
+     */
+        float GetRate(const int day, const float hour) const {
+            const int hour_index = std::clamp(static_cast<int>(hour), 0, 23);
+            return hourly_rates[((day % 7) + 7) % 7][hour_index];
+        }
+
+        /**
+     * @brief Expected number of arrivals over a span starting at (day, hour)
+     * 
+     * Integrates the piecewise-constant rate exactly, crossing hour and day
+     * boundaries as needed.
+     */
+        float GetExpectedArrivals(int day, float hour, float span_hours) const {
+            float expected = 0.0f;
+            while (span_hours > 0.0f) {
+                const float hour_end = std::floor(hour) + 1.0f;
+                const float step = std::min(span_hours, hour_end - hour);
+                expected += GetRate(day, hour) * step;
+                span_hours -= step;
+                hour += step;
+                if (hour >= 24.0f) {
+                    hour -= 24.0f;
+                    day = (day + 1) % 7;
+                }
+            }
+            return expected;
+        }
+    };
+
+    /**
+ * @brief Global singleton component for tower-wide NPC spawning
+ * 
+ * Manages spawning of visitors and tracking of available jobs.
+ */
+    struct NPCSpawner {
+        float arrival_rate_scale;           // Multiplier applied to the arrival profile
+        ArrivalProfile arrival_profile;     // Expected arrivals per sim-hour by day and hour
+        std::mt19937 arrival_rng;           // Random source for arrival counts and new visitors' plans
+        int total_visitors_spawned;         // Total count of spawned visitors
+        int total_employees_hired;          // Total count of employees hired
+        int next_visitor_id;                // ID counter for naming visitors
+        int max_active_visitors;            // Maximum number of active visitors at once
+        int last_batch_size;                // Visitors created in the most recent batch
+
+        // Live counters maintained by observers on VisitorInfo and BuildingComponent
+        bool counters_initialized;          // False until counters are seeded from the world
+        int active_visitor_count;           // Entities currently carrying VisitorInfo
+        int facility_count;                 // Entities currently carrying BuildingComponent
+        std::vector<std::uint64_t> visitable_facilities;                // Facilities visitors can target
+        std::unordered_map<std::uint64_t, size_t> visitable_index;      // Facility ID -> slot in visitable_facilities
+    
+        NPCSpawner(const float rate_scale = 1.0f, const int max_visitors = 2000)
+            : arrival_rate_scale(rate_scale),
+              arrival_rng(0x70FF0A11u),
+              total_visitors_spawned(0),
+              total_employees_hired(0),
+              next_visitor_id(1),
+              max_active_visitors(max_visitors),
+              last_batch_size(0),
+              counters_initialized(false),
+              active_visitor_count(0),
+              facility_count(0) {}
+    
+        /**
+     * @brief Demand multiplier based on tower state
+     */
+        static float GetFacilityDemandMultiplier(const int facility_count) {
+            // More facilities = more visitors: +5% per facility, up to 3x
+            return std::min(3.0f, 1.0f + static_cast<float>(facility_count) * 0.05f);
+        }
+
+        /**
+     * @brief Sample how many visitors arrive over a span of simulated time
+     * 
+     * Counts over disjoint spans of a Poisson process are independent, so
+     * sampling once per tick with the integrated rate is exact.
+     */
+        int SampleArrivals(const int day, const float hour, const float span_hours) {
+            const float expected = arrival_profile.GetExpectedArrivals(day, hour, span_hours) *
+                                   arrival_rate_scale * GetFacilityDemandMultiplier(facility_count);
+            if (expected <= 0.0f) {
+                return 0;
+            }
+            std::poisson_distribution<int> distribution(expected);
+            return distribution(arrival_rng);
+        }
+
+        /**
+     * @brief Check if visitors spawned by the tower can target this facility type
+     */
+        static bool IsVisitable(const BuildingComponent::Type type) {
+            return type == BuildingComponent::Type::RetailShop ||
+                   type == BuildingComponent::Type::Restaurant ||
+                   type == BuildingComponent::Type::Arcade ||
+                   type == BuildingComponent::Type::Theater ||
+                   type == BuildingComponent::Type::FlagshipStore;
+        }
+
+        /**
+     * @brief Add or drop a facility from the visitable set after its type is set
+     */
+        void UpdateVisitableFacility(const std::uint64_t facility_id, const BuildingComponent::Type type) {
+            const bool indexed = visitable_index.contains(facility_id);
+            if (IsVisitable(type) && !indexed) {
+                visitable_index[facility_id] = visitable_facilities.size();
+                visitable_facilities.push_back(facility_id);
+            } else if (!IsVisitable(type) && indexed) {
+                RemoveVisitableFacility(facility_id);
+            }
+        }
+
+        /**
+     * @brief Drop a facility from the visitable set in O(1) (swap with the last slot)
+     */
+        void RemoveVisitableFacility(const std::uint64_t facility_id) {
+            const auto it = visitable_index.find(facility_id);
+            if (it == visitable_index.end()) {
+                return;
+            }
+            const size_t slot = it->second;
+            const std::uint64_t last = visitable_facilities.back();
+            visitable_facilities[slot] = last;
+            visitable_index[last] = slot;
+            visitable_facilities.pop_back();
+            visitable_index.erase(facility_id);
+        }
+
+        /**
+     * @brief Forget all counters so they are re-seeded from the world
+     */
+        void ResetCounters() {
+            counters_initialized = false;
+            active_visitor_count = 0;
+            facility_count = 0;
+            visitable_facilities.clear();
+            visitable_index.clear();
+        }
+    };
+
+    /**
+ * @brief Global singleton holding departed visitor entities for reuse
+ * 
+ * Departing visitors are disabled instead of destroyed, and new arrivals
+ * re-enable them with their components reset in place. Short-lived
+ * visitors therefore don't create and delete entities (or churn archetype
+ * tables) on every visit. Visitors are unnamed; Person::name carries the
+ * display name.
+ */
+    struct VisitorPool {
+        std::vector<std::uint64_t> free_visitors;  // Disabled visitor entities ready for reuse
+        bool enabled;                              // Recycle visitors instead of destroying them
+        int total_recycled;                        // Arrivals served from the pool
+        int total_released;                        // Departures returned to the pool
+
+        VisitorPool(const bool enable_pool = true)
+            : enabled(enable_pool),
+              total_recycled(0),
+              total_released(0) {}
+
+        /**
+     * @brief Take a pooled entity ID, or 0 if the pool is empty
+     */
+        std::uint64_t Acquire() {
+            if (free_visitors.empty()) {
+                return 0;
+            }
+            const std::uint64_t visitor_id = free_visitors.back();
+            free_visitors.pop_back();
+            total_recycled++;
+            return visitor_id;
+        }
+
+        /**
+     * @brief Return a (disabled) visitor entity to the pool
+     */
+        void Release(const std::uint64_t visitor_id) {
+            free_visitors.push_back(visitor_id);
+            total_released++;
+        }
+    };
+
+    /**
+ * @brief Global singleton component for managing simulation time
+ * 
+ * This component tracks the current simulation time, including hours,
+ * days, and weeks. It also manages the simulation speed for pause
+ * and fast-forward functionality.
+ */
+    struct TimeManager {
+        float current_hour;        // Current hour of the day (0.0 - 24.0)
+        int current_day;           // Current day of the week (0 = Monday, 6 = Sunday)
+        int current_week;          // Current week number
+        float simulation_speed;    // Speed multiplier (0.0 = paused, 1.0 = normal, 2.0 = 2x speed)
+        float hours_per_second;    // How many in-game hours pass per real-time second
+    
+        TimeManager(const float hours_per_sec = 1.0f)
+            : current_hour(8.0f),      // Start at 8 AM
+              current_day(0),          // Start on Monday
+              current_week(1),         // Start at week 1
+              simulation_speed(1.0f),  // Normal speed
+              hours_per_second(hours_per_sec) {}
+    
+        /**
+     * @brief Get the current time as a formatted string (HH:MM)
+     */
+        std::string GetTimeString() const {
+            const int hours = static_cast<int>(current_hour);
+            const int minutes = static_cast<int>((current_hour - hours) * 60.0f);
+            char buffer[6];
+            snprintf(buffer, sizeof(buffer), "%02d:%02d", hours, minutes);
+            return std::string(buffer);
+        }
+    
+        /**
+     * @brief Get the current day name
+     */
+        const char* GetDayName() const {
+            static const char* day_names[] = {
+                "Monday", "Tuesday", "Wednesday", "Thursday", 
+                "Friday", "Saturday", "Sunday"
+            };
+            return day_names[current_day % 7];
+        }
+    
+        /**
+     * @brief Check if current time is within business hours (9 AM - 5 PM)
+     */
+        bool IsBusinessHours() const {
+            return current_hour >= 9.0f && current_hour < 17.0f;
+        }
+    
+        /**
+     * @brief Check if it's a weekend
+     */
+        bool IsWeekend() const {
+            return current_day == 5 || current_day == 6;  // Saturday or Sunday
+        }
+
+        /**
+     * @brief Hours elapsed since the start of week 0, for keying per-hour statistics
+     */
+        std::int64_t GetAbsoluteHour() const {
+            return (static_cast<std::int64_t>(current_week) * 7 + current_day) * 24 + static_cast<int>(current_hour);
+        }
+
+        /**
+     * @brief Fractional hours elapsed since the start of week 0, for measuring spans of sim time
+     */
+        double GetAbsoluteHours() const {
+            return (static_cast<double>(current_week) * 7 + current_day) * 24 + current_hour;
+        }
+
+        /**
+     * @brief Move the clock to a point in absolute hours (inverse of GetAbsoluteHours)
+     */
+        void SetAbsoluteHours(const double hours) {
+            const auto days = static_cast<std::int64_t>(std::floor(hours / 24.0));
+            current_week = static_cast<int>(days / 7);
+            current_day = static_cast<int>(days % 7);
+            current_hour = static_cast<float>(hours - static_cast<double>(days) * 24.0);
+        }
+    };
 
     /**
  * @brief Scheduled action that can be triggered at a specific time
@@ -821,6 +1803,39 @@ namespace towerforge::core {
             if (max_tenants == 0) return 0.0f;
             return (static_cast<float>(current_tenants) / max_tenants) * 100.0f;
         }
+
+        /**
+     * @brief Advance tenant churn over a span of steady satisfaction in one step
+     *
+     * Matches the once-a-second economics and revenue systems: one tenant moves in
+     * per second above 70 satisfaction while there is room, one moves out per second
+     * below 30, and each second earns a day's rent at that second's tenant count.
+     * @param seconds Span to cover
+     * @param satisfaction_score Facility satisfaction, held for the whole span
+     * @param has_room Whether the facility has room for new tenants
+     * @return Revenue earned over the span
+     */
+        float CatchUp(const float seconds, const float satisfaction_score, const bool has_room) {
+            quality_multiplier = 0.5f + (satisfaction_score / 100.0f) * 1.5f;
+
+            int target = current_tenants;
+            if (satisfaction_score > 70.0f && has_room) {
+                target = std::max(current_tenants, max_tenants);
+            } else if (satisfaction_score < 30.0f) {
+                target = 0;
+            }
+
+            // Tenants ramp one per tick toward the target, then hold
+            const auto ticks = static_cast<std::int64_t>(seconds);
+            const std::int64_t ramp = std::min<std::int64_t>(ticks, std::abs(target - current_tenants));
+            const std::int64_t step = target > current_tenants ? 1 : -1;
+            const std::int64_t final_tenants = current_tenants + step * ramp;
+            const double tenant_seconds = static_cast<double>(ramp * current_tenants + step * ramp * (ramp + 1) / 2 +
+                                                              (ticks - ramp) * final_tenants);
+
+            current_tenants = static_cast<int>(final_tenants);
+            return static_cast<float>(base_rent * quality_multiplier * tenant_seconds / (24.0 * 3600.0));
+        }
     };
 
     /**
@@ -933,6 +1948,32 @@ namespace towerforge::core {
             daily_expenses = 0.0f;
         }
     
+        /**
+     * @brief Book a span of revenue and expenses in one step
+     *
+     * Equivalent to the daily processing running at every day boundary in the
+     * span: everything earned before the last boundary is closed into the totals,
+     * and the share earned after it stays on the open day.
+     * @param revenue Revenue earned over the span
+     * @param expenses Expenses incurred over the span
+     * @param days_closed Day boundaries crossed during the span
+     * @param open_day_share Share of the span after the last boundary (0.0 - 1.0)
+     */
+        void AccrueSpan(const float revenue, const float expenses, const int days_closed, const float open_day_share) {
+            if (days_closed <= 0) {
+                daily_revenue += revenue;
+                daily_expenses += expenses;
+                return;
+            }
+
+            const float open_share = std::clamp(open_day_share, 0.0f, 1.0f);
+            daily_revenue += revenue * (1.0f - open_share);
+            daily_expenses += expenses * (1.0f - open_share);
+            ProcessDailyTransactions();
+            daily_revenue = revenue * open_share;
+            daily_expenses = expenses * open_share;
+        }
+
         /**
      * @brief Get the current profit/loss status
      */
@@ -963,16 +2004,165 @@ namespace towerforge::core {
     };
 
     /**
- * @brief Component for Elevator Shaft entities
+ * @brief Set of floors stored as bits relative to a word-aligned base floor
  * 
- * Represents a vertical shaft that contains one or more elevator cars.
- * The shaft defines the physical space and floors served by the elevator system.
+ * Grows in either direction as floors are set, so basements and very tall
+ * shafts need no configuration. Finding the next set floor in a travel
+ * direction scans 64 floors per step.
+ */
+    struct FloorBitset {
+        static constexpr int npos = std::numeric_limits<int>::min();
+
+        int base;                           // Floor of bit 0; always a multiple of 64
+        std::vector<std::uint64_t> words;
+        int count;
+
+        FloorBitset()
+            : base(0),
+              count(0) {}
+
+        void Set(const int floor) {
+            Reserve(floor);
+            std::uint64_t& word = words[WordIndex(floor)];
+            const std::uint64_t bit = BitMask(floor);
+            if ((word & bit) == 0) {
+                word |= bit;
+                count++;
+            }
+        }
+
+        void Reset(const int floor) {
+            if (!Covers(floor)) return;
+            std::uint64_t& word = words[WordIndex(floor)];
+            const std::uint64_t bit = BitMask(floor);
+            if ((word & bit) != 0) {
+                word &= ~bit;
+                count--;
+            }
+        }
+
+        bool Test(const int floor) const {
+            return Covers(floor) && (words[WordIndex(floor)] & BitMask(floor)) != 0;
+        }
+
+        bool Any() const {
+            return count > 0;
+        }
+
+        void Clear() {
+            std::fill(words.begin(), words.end(), 0);
+            count = 0;
+        }
+
+        /**
+     * @brief Get the lowest set floor at or above a floor (npos if none)
+     */
+        int FindNextSet(const int from) const {
+            if (count == 0 || from >= End()) return npos;
+            const int index = std::max(from - base, 0);
+            size_t word = static_cast<size_t>(index / 64);
+            std::uint64_t bits = words[word] & (~std::uint64_t{0} << (index % 64));
+            while (true) {
+                if (bits != 0) {
+                    return base + static_cast<int>(word) * 64 + std::countr_zero(bits);
+                }
+                if (++word == words.size()) return npos;
+                bits = words[word];
+            }
+        }
+
+        /**
+     * @brief Get the highest set floor at or below a floor (npos if none)
+     */
+        int FindPrevSet(const int from) const {
+            if (count == 0 || from < base) return npos;
+            const int index = std::min(from - base, End() - base - 1);
+            size_t word = static_cast<size_t>(index / 64);
+            const int bit = index % 64;
+            std::uint64_t bits = words[word] & (bit == 63 ? ~std::uint64_t{0} : (std::uint64_t{1} << (bit + 1)) - 1);
+            while (true) {
+                if (bits != 0) {
+                    return base + static_cast<int>(word) * 64 + 63 - std::countl_zero(bits);
+                }
+                if (word-- == 0) return npos;
+                bits = words[word];
+            }
+        }
+
+        int FindFirst() const {
+            return FindNextSet(base);
+        }
+
+        int FindLast() const {
+            return count == 0 ? npos : FindPrevSet(End() - 1);
+        }
+
+        /**
+     * @brief Call a function for every set floor in ascending order
+     */
+        template <typename Fn>
+        void ForEach(Fn&& fn) const {
+            for (size_t word = 0; word < words.size(); ++word) {
+                for (std::uint64_t bits = words[word]; bits != 0; bits &= bits - 1) {
+                    fn(base + static_cast<int>(word) * 64 + std::countr_zero(bits));
+                }
+            }
+        }
+
+        /**
+     * @brief Get the set floors in ascending order
+     */
+        std::vector<int> ToVector() const {
+            std::vector<int> floors;
+            floors.reserve(count);
+            ForEach([&floors](const int floor) { floors.push_back(floor); });
+            return floors;
+        }
+
+    private:
+        int End() const {
+            return base + static_cast<int>(words.size()) * 64;
+        }
+
+        bool Covers(const int floor) const {
+            return floor >= base && floor < End();
+        }
+
+        size_t WordIndex(const int floor) const {
+            return static_cast<size_t>((floor - base) / 64);
+        }
+
+        std::uint64_t BitMask(const int floor) const {
+            return std::uint64_t{1} << ((floor - base) % 64);
+        }
+
+        void Reserve(const int floor) {
+            // Round down to a multiple of 64, also for negative floors
+            const int aligned = floor >= 0 ? floor / 64 * 64 : -((-floor + 63) / 64 * 64);
+            if (words.empty()) {
+                base = aligned;
+                words.assign(1, 0);
+            } else if (floor < base) {
+                words.insert(words.begin(), static_cast<size_t>((base - aligned) / 64), 0);
+                base = aligned;
+            } else if (floor >= End()) {
+                words.resize(static_cast<size_t>((aligned - base) / 64 + 1), 0);
+            }
+        }
+    };
+
+    /**
+ * @brief Component for Elevator Shaft entities
+ * 
+ * Represents a vertical shaft that contains one or more elevator cars.
+ * The shaft defines the physical space and floors served by the elevator system.
  */
     struct ElevatorShaft {
         int column;              // Grid column where shaft is located
         int bottom_floor;        // Lowest floor served
         int top_floor;           // Highest floor served
         int car_count;           // Number of cars in this shaft
+        FloorBitset served_floors;  // Floors cars stop at; empty means every floor in range
     
         ElevatorShaft(const int col = 0, const int bottom = 0, const int top = 0, const int cars = 1)
             : column(col),
@@ -991,7 +2181,93 @@ namespace towerforge::core {
      * @brief Check if a floor is served by this shaft
      */
         bool ServesFloor(const int floor) const {
-            return floor >= bottom_floor && floor <= top_floor;
+            return floor >= bottom_floor && floor <= top_floor &&
+                   (!served_floors.Any() || served_floors.Test(floor));
+        }
+
+        /**
+     * @brief Limit the shaft to the given floors (express or zoned service)
+     * 
+     * Floors outside bottom_floor..top_floor are ignored. An empty list
+     * restores service to every floor in range.
+     */
+        void SetServedFloors(const std::vector<int>& floors) {
+            served_floors = FloorBitset();
+            for (const int floor : floors) {
+                if (floor >= bottom_floor && floor <= top_floor) {
+                    served_floors.Set(floor);
+                }
+            }
+        }
+
+        /**
+     * @brief Whether cars stop at every floor between bottom and top
+     */
+        bool ServesAllFloors() const {
+            return !served_floors.Any() || served_floors.count == GetFloorRange();
+        }
+
+        /**
+     * @brief Number of floors cars stop at
+     */
+        int GetServedFloorCount() const {
+            return served_floors.Any() ? served_floors.count : GetFloorRange();
+        }
+
+        /**
+     * @brief Number of served floors strictly between two floors
+     */
+        int CountServedFloorsBetween(const int a, const int b) const {
+            const int low = std::max(std::min(a, b) + 1, bottom_floor);
+            const int high = std::min(std::max(a, b) - 1, top_floor);
+            if (low > high) return 0;
+            if (!served_floors.Any()) return high - low + 1;
+
+            int served = 0;
+            for (int floor = served_floors.FindNextSet(low);
+                 floor != FloorBitset::npos && floor <= high;
+                 floor = served_floors.FindNextSet(floor + 1)) {
+                served++;
+            }
+            return served;
+        }
+    };
+
+    /**
+ * @brief Per-floor counters that grow in either direction as floors are used
+ */
+    struct FloorCounts {
+        int base;
+        std::vector<std::uint16_t> counts;
+        int total;
+
+        FloorCounts()
+            : base(0),
+              total(0) {}
+
+        void Add(const int floor) {
+            if (counts.empty()) {
+                base = floor;
+                counts.assign(1, 0);
+            } else if (floor < base) {
+                counts.insert(counts.begin(), static_cast<size_t>(base - floor), 0);
+                base = floor;
+            } else if (floor >= base + static_cast<int>(counts.size())) {
+                counts.resize(static_cast<size_t>(floor - base + 1), 0);
+            }
+            counts[static_cast<size_t>(floor - base)]++;
+            total++;
+        }
+
+        void Remove(const int floor) {
+            if (Get(floor) == 0) return;
+            counts[static_cast<size_t>(floor - base)]--;
+            total--;
+        }
+
+        int Get(const int floor) const {
+            if (floor < base || floor >= base + static_cast<int>(counts.size())) return 0;
+            return counts[static_cast<size_t>(floor - base)];
         }
     };
 
@@ -1002,7 +2278,7 @@ namespace towerforge::core {
  * Handles passenger transport, movement, and scheduling.
  */
     struct ElevatorCar {
-        int shaft_entity_id;      // Reference to the shaft this car belongs to
+        std::uint64_t shaft_entity_id;  // Full entity id of the shaft this car belongs to (0 if none)
         float current_floor;      // Current position (float for smooth movement between floors)
         int target_floor;         // Next floor destination
         ElevatorState state;      // Current state in the state machine
@@ -1011,9 +2287,18 @@ namespace towerforge::core {
         int max_capacity;         // Maximum number of passengers
         int current_occupancy;    // Current number of passengers
     
-        // Queue management
-        std::vector<int> stop_queue;      // Floors where car needs to stop (sorted)
-        std::vector<int> passenger_destinations;  // Destination floors of current passengers
+        // Stop management: separate sets for stops served travelling up and down
+        FloorBitset up_stops;
+        FloorBitset down_stops;
+        int travel_direction;             // 1 up, -1 down, 0 when idle with nothing to do
+        FloorCounts passenger_counts;     // Riders on board per destination floor
+        struct Rider {
+            std::uint64_t person_id;
+            int destination_floor;
+            float wait_time;          // Seconds spent in the hall queue
+            double board_time;        // World time when the rider boarded
+        };
+        std::vector<Rider> riders;                // People on board, in boarding order
     
         // Timing
         float state_timer;        // Timer for current state (doors, movement)
@@ -1021,13 +2306,14 @@ namespace towerforge::core {
         float door_transition_duration;  // How long it takes doors to open/close (seconds)
         float floors_per_second;  // Movement speed
     
-        ElevatorCar(const int shaft_id = -1, const int start_floor = 0, const int capacity = 8)
+        ElevatorCar(const std::uint64_t shaft_id = 0, const int start_floor = 0, const int capacity = 8)
             : shaft_entity_id(shaft_id),
               current_floor(static_cast<float>(start_floor)),
               target_floor(start_floor),
               state(ElevatorState::Idle),
               max_capacity(capacity),
               current_occupancy(0),
+              travel_direction(0),
               state_timer(0.0f),
               door_open_duration(2.0f),      // 2 seconds
               door_transition_duration(1.0f), // 1 second
@@ -1070,55 +2356,149 @@ namespace towerforge::core {
         }
     
         /**
-     * @brief Add a stop to the queue (maintains sorted order)
+     * @brief Check if the car has any pending stops
+     */
+        bool HasStops() const {
+            return up_stops.Any() || down_stops.Any();
+        }
+
+        /**
+     * @brief Add a stop served while travelling in the given direction
+     */
+        void AddStop(const int floor, const bool going_up) {
+            (going_up ? up_stops : down_stops).Set(floor);
+        }
+
+        /**
+     * @brief Add a stop, serving it in the direction the car must travel to reach it
      */
         void AddStop(const int floor) {
-            // Check if floor is already in queue
-            for (const int f : stop_queue) {
-                if (f == floor) return;
-            }
-        
-            // Add and sort based on direction
-            stop_queue.push_back(floor);
-            std::sort(stop_queue.begin(), stop_queue.end());
+            const int current = GetCurrentFloorInt();
+            AddStop(floor, floor > current || (floor == current && travel_direction >= 0));
         }
-    
+
         /**
-     * @brief Get the next stop in the queue
+     * @brief Get the lowest pending stop (FloorBitset::npos if none)
      */
-        int GetNextStop() const {
-            if (stop_queue.empty()) return GetCurrentFloorInt();
+        int GetLowestStop() const {
+            const int up = up_stops.FindFirst();
+            const int down = down_stops.FindFirst();
+            if (up == FloorBitset::npos) return down;
+            if (down == FloorBitset::npos) return up;
+            return std::min(up, down);
+        }
+
+        /**
+     * @brief Get the highest pending stop (FloorBitset::npos if none)
+     */
+        int GetHighestStop() const {
+            return std::max(up_stops.FindLast(), down_stops.FindLast());
+        }
 
+        /**
+     * @brief Get the next stop using LOOK scheduling
+     * 
+     * The car serves up stops ahead of it while travelling up, turns at the
+     * furthest stop above, then serves down stops on the way down, and vice
+     * versa. An idle car heads for the nearest stop.
+     */
+        int GetNextStop() const {
             const int current = GetCurrentFloorInt();
-        
-            // Find closest stop in current direction
-            if (state == ElevatorState::MovingUp || state == ElevatorState::Idle) {
-                // Look for stops above current floor
-                for (const int floor : stop_queue) {
-                    if (floor >= current) return floor;
-                }
+            if (!HasStops()) return current;
+
+            if (travel_direction == 0) {
+                const int up_above = up_stops.FindNextSet(current);
+                const int down_above = down_stops.FindNextSet(current);
+                const int above = up_above == FloorBitset::npos ? down_above
+                                  : down_above == FloorBitset::npos ? up_above
+                                  : std::min(up_above, down_above);
+                const int below = std::max(up_stops.FindPrevSet(current), down_stops.FindPrevSet(current));
+                if (above == FloorBitset::npos) return below;
+                if (below == FloorBitset::npos) return above;
+                return (above - current) <= (current - below) ? above : below;
             }
-        
-            if (state == ElevatorState::MovingDown || (state == ElevatorState::Idle && !stop_queue.empty())) {
-                // Look for stops below current floor (reverse order)
-                for (auto it = stop_queue.rbegin(); it != stop_queue.rend(); ++it) {
-                    if (*it <= current) return *it;
-                }
+
+            if (travel_direction > 0) {
+                if (const int next = up_stops.FindNextSet(current); next != FloorBitset::npos) return next;
+                if (const int top = GetHighestStop(); top > current) return top;
+                if (const int next = down_stops.FindPrevSet(current); next != FloorBitset::npos) return next;
+                return GetLowestStop();
             }
-        
-            // No stops in current direction, return any stop
-            return stop_queue.empty() ? current : stop_queue[0];
+
+            if (const int next = down_stops.FindPrevSet(current); next != FloorBitset::npos) return next;
+            if (const int bottom = GetLowestStop(); bottom < current) return bottom;
+            if (const int next = up_stops.FindNextSet(current); next != FloorBitset::npos) return next;
+            return GetHighestStop();
         }
-    
+
         /**
-     * @brief Remove current floor from stop queue
+     * @brief Clear the stop being served at the current floor
+     * 
+     * A stop for the opposite direction stays pending while the car still
+     * has stops ahead, so it is served on the way back.
      */
         void RemoveCurrentStop() {
             const int current = GetCurrentFloorInt();
-            stop_queue.erase(
-                std::remove(stop_queue.begin(), stop_queue.end(), current),
-                stop_queue.end()
-            );
+            if (travel_direction > 0) {
+                up_stops.Reset(current);
+                if (GetHighestStop() <= current) down_stops.Reset(current);
+            } else if (travel_direction < 0) {
+                down_stops.Reset(current);
+                const int lowest = GetLowestStop();
+                if (lowest == FloorBitset::npos || lowest >= current) up_stops.Reset(current);
+            } else {
+                RemoveStop(current);
+            }
+        }
+
+        /**
+     * @brief Remove a floor from both stop sets
+     */
+        void RemoveStop(const int floor) {
+            up_stops.Reset(floor);
+            down_stops.Reset(floor);
+        }
+
+        /**
+     * @brief Remove a floor from one direction's stop set
+     */
+        void RemoveStop(const int floor, const bool going_up) {
+            (going_up ? up_stops : down_stops).Reset(floor);
+        }
+
+        /**
+     * @brief Check if the car has a pending stop at a floor
+     */
+        bool HasStop(const int floor) const {
+            return up_stops.Test(floor) || down_stops.Test(floor);
+        }
+
+        /**
+     * @brief Get all pending stops in ascending order (for display and saving)
+     */
+        std::vector<int> GetStops() const {
+            std::vector<int> stops = up_stops.ToVector();
+            for (const int floor : down_stops.ToVector()) {
+                if (!up_stops.Test(floor)) stops.push_back(floor);
+            }
+            std::sort(stops.begin(), stops.end());
+            return stops;
+        }
+
+        /**
+     * @brief Get the direction the car is committed to
+     * @return 1 for up, -1 for down, 0 when idle with no stops
+     */
+        int GetTravelDirection() const {
+            if (state == ElevatorState::MovingUp) return 1;
+            if (state == ElevatorState::MovingDown) return -1;
+            if (!HasStops()) return 0;
+
+            const int next_stop = GetNextStop();
+            const int current = GetCurrentFloorInt();
+            if (next_stop > current) return 1;
+            if (next_stop < current) return -1;
+            return 0;
         }
     };
 
@@ -1128,20 +2508,1102 @@ namespace towerforge::core {
  * Attached to Person entities when they are waiting for or riding an elevator.
  */
     struct PersonElevatorRequest {
-        int shaft_entity_id;      // Which shaft the person is using
-        int car_entity_id;        // Which car the person is in (-1 if waiting)
+        std::uint64_t shaft_entity_id;  // Which shaft the person is using
+        std::uint64_t car_entity_id;    // Which car the person is in (0 if waiting)
         int call_floor;           // Floor where person called the elevator
         int destination_floor;    // Where person wants to go
-        float wait_time;          // How long person has been waiting
+        float wait_time;          // How long person waited before boarding (set on boarding)
         bool is_boarding;         // True if person is currently boarding
     
-        PersonElevatorRequest(const int shaft_id = -1, const int call = 0, const int dest = 0)
+        bool hall_call_registered; // True once the shaft's dispatcher knows about this person
+        bool riding;              // True after boarding
+    
+        PersonElevatorRequest(const std::uint64_t shaft_id = 0, const int call = 0, const int dest = 0)
             : shaft_entity_id(shaft_id),
-              car_entity_id(-1),
+              car_entity_id(0),
               call_floor(call),
               destination_floor(dest),
               wait_time(0.0f),
-              is_boarding(false) {}
+              is_boarding(false),
+              hall_call_registered(false),
+              riding(false) {}
+
+        /**
+     * @brief Check if the trip is upward
+     */
+        bool IsGoingUp() const {
+            return destination_floor > call_floor;
+        }
+    };
+
+    /**
+ * @brief A pending hall call at one floor in one direction
+ * 
+ * Waiting passengers are queued in arrival order and board first come,
+ * first served when an assigned car opens its doors.
+ */
+    struct HallCall {
+        struct QueuedPassenger {
+            std::uint64_t person_id;
+            double call_time;       // World time the passenger joined the queue
+        };
+
+        std::deque<QueuedPassenger> queue;
+        std::uint64_t assigned_car; // Car answering the call (0 = unassigned)
+        float assigned_cost;        // Estimated arrival time when last assigned (seconds)
+
+        HallCall()
+            : assigned_car(0),
+              assigned_cost(0.0f) {}
+
+        bool IsActive() const {
+            return !queue.empty();
+        }
+
+        int GetWaitingCount() const {
+            return static_cast<int>(queue.size());
+        }
+    };
+
+    /**
+ * @brief Per-shaft elevator dispatcher
+ * 
+ * Attached to ElevatorShaft entities by an observer. Owns the hall-call
+ * table for the floors the shaft serves (one entry per floor and direction)
+ * and the list of cars running in the shaft. The dispatch system assigns
+ * each call to the car with the lowest estimated time of arrival and
+ * reassigns calls when their car fills up or a clearly better car appears.
+ */
+    struct ElevatorDispatcher {
+        int bottom_floor;
+        int top_floor;
+        std::vector<HallCall> hall_calls;   // Index: (floor - bottom_floor) * 2 + (going up ? 1 : 0)
+        FloorBitset served_floors;          // The shaft's served-floor mask; empty serves every floor
+        std::vector<std::uint64_t> cars;    // Car entities in this shaft
+        float reassign_margin;              // Seconds a new car must beat the assigned one by
+        int total_calls_assigned;
+        int total_calls_reassigned;
+
+        ElevatorDispatcher(const int bottom = 0, const int top = 0)
+            : bottom_floor(bottom),
+              top_floor(top),
+              hall_calls(static_cast<size_t>(std::max(0, top - bottom + 1)) * 2),
+              reassign_margin(3.0f),
+              total_calls_assigned(0),
+              total_calls_reassigned(0) {}
+
+        explicit ElevatorDispatcher(const ElevatorShaft& shaft)
+            : ElevatorDispatcher(shaft.bottom_floor, shaft.top_floor) {
+            served_floors = shaft.served_floors;
+        }
+
+        bool ServesFloor(const int floor) const {
+            return floor >= bottom_floor && floor <= top_floor &&
+                   (!served_floors.Any() || served_floors.Test(floor));
+        }
+
+        /**
+     * @brief Get the hall call for a floor and direction (nullptr if the floor isn't served)
+     */
+        HallCall* GetCall(const int floor, const bool going_up) {
+            if (!ServesFloor(floor)) return nullptr;
+            return &hall_calls[static_cast<size_t>(floor - bottom_floor) * 2 + (going_up ? 1 : 0)];
+        }
+
+        const HallCall* GetCall(const int floor, const bool going_up) const {
+            if (!ServesFloor(floor)) return nullptr;
+            return &hall_calls[static_cast<size_t>(floor - bottom_floor) * 2 + (going_up ? 1 : 0)];
+        }
+
+        /**
+     * @brief Queue a waiting passenger on a hall call
+     * @return false if the shaft doesn't stop at the floor
+     */
+        bool RegisterCall(const int floor, const bool going_up, const std::uint64_t person_id, const double world_time) {
+            HallCall* call = GetCall(floor, going_up);
+            if (call == nullptr) return false;
+            call->queue.push_back({person_id, world_time});
+            return true;
+        }
+
+        /**
+     * @brief Remove a passenger who gave up waiting; clears the call when nobody is left
+     */
+        void CancelPassenger(const int floor, const bool going_up, const std::uint64_t person_id) {
+            HallCall* call = GetCall(floor, going_up);
+            if (call == nullptr) return;
+            const auto it = std::find_if(call->queue.begin(), call->queue.end(),
+                                         [person_id](const HallCall::QueuedPassenger& queued) {
+                                             return queued.person_id == person_id;
+                                         });
+            if (it != call->queue.end()) {
+                call->queue.erase(it);
+            }
+            if (call->queue.empty()) {
+                call->assigned_car = 0;
+            }
+        }
+
+        /**
+     * @brief Get the car assigned to a hall call (0 if none)
+     */
+        std::uint64_t GetAssignedCar(const int floor, const bool going_up) const {
+            const HallCall* call = GetCall(floor, going_up);
+            return call != nullptr ? call->assigned_car : 0;
+        }
+
+        void AddCar(const std::uint64_t car_id) {
+            if (std::find(cars.begin(), cars.end(), car_id) == cars.end()) {
+                cars.push_back(car_id);
+            }
+        }
+
+        /**
+     * @brief Remove a car; its calls become unassigned and are picked up on the next pass
+     */
+        void RemoveCar(const std::uint64_t car_id) {
+            cars.erase(std::remove(cars.begin(), cars.end(), car_id), cars.end());
+            for (auto& call : hall_calls) {
+                if (call.assigned_car == car_id) {
+                    call.assigned_car = 0;
+                }
+            }
+        }
+
+        /**
+     * @brief Estimate how long a car needs to reach a hall call
+     * 
+     * The car is assumed to follow LOOK scheduling: it finishes its sweep in
+     * the current direction, reverses at its furthest stop, and so on. Every
+     * stop served before the call adds a door cycle, and fuller cars are
+     * penalized for the extra boarding time. A full car never answers a call.
+     */
+        static float EstimateArrivalTime(const ElevatorCar& car, const int floor, const bool going_up) {
+            if (!car.HasCapacity()) {
+                return std::numeric_limits<float>::infinity();
+            }
+
+            const int direction = car.GetTravelDirection();
+            const float stop_time = car.door_open_duration + 2.0f * car.door_transition_duration;
+            const float load_penalty = stop_time * static_cast<float>(car.current_occupancy) /
+                                       static_cast<float>(std::max(1, car.max_capacity));
+
+            if (direction == 0) {
+                return std::abs(static_cast<float>(floor) - car.current_floor) / car.floors_per_second + load_penalty;
+            }
+
+            // Mirror downward sweeps so the math below only deals with upward travel
+            const float sign = direction > 0 ? 1.0f : -1.0f;
+            const bool along_sweep = going_up == (direction > 0);
+            const float start = car.current_floor * sign;
+            const float target = static_cast<float>(floor) * sign;
+
+            float top = std::max(start, target);
+            float bottom = std::min(start, target);
+            if (car.HasStops()) {
+                const float highest = static_cast<float>(car.GetHighestStop()) * sign;
+                const float lowest = static_cast<float>(car.GetLowestStop()) * sign;
+                top = std::max({top, highest, lowest});
+                bottom = std::min({bottom, highest, lowest});
+            }
+
+            // Distance along the sweep before the car passes a floor heading the given way
+            auto SweepDistance = [&](const float position, const bool with_direction) {
+                if (!with_direction) return (top - start) + (top - position);
+                if (position >= start) return position - start;
+                return (top - start) + (top - bottom) + (position - bottom);
+            };
+
+            const float call_distance = SweepDistance(target, along_sweep);
+            int stops_before = 0;
+            auto CountIfBefore = [&](const int stop) {
+                const float position = static_cast<float>(stop) * sign;
+                if (stop != floor && SweepDistance(position, position >= start) < call_distance) {
+                    stops_before++;
+                }
+            };
+            car.up_stops.ForEach(CountIfBefore);
+            car.down_stops.ForEach(CountIfBefore);
+
+            return call_distance / car.floors_per_second + static_cast<float>(stops_before) * stop_time + load_penalty;
+        }
+    };
+
+    /**
+ * @brief Fixed-bucket histogram of durations in seconds
+ * 
+ * One-second buckets up to linear_seconds, then each doubling of the
+ * duration is split into sub_buckets equal buckets, so precision stays
+ * within a few percent from short waits to hour-long rush queues. The last
+ * bucket also collects everything longer. Recording is a single increment,
+ * so the histogram can stay on in normal play. Percentiles are
+ * interpolated inside the bucket.
+ */
+    struct LatencyHistogram {
+        static constexpr int linear_seconds = 32;
+        static constexpr int sub_buckets = 16;
+        static constexpr int octaves = 9;           // Doublings above linear_seconds; covers up to 16384 s
+        static constexpr int bucket_count = linear_seconds + octaves * sub_buckets;
+
+        std::array<std::uint32_t, bucket_count> buckets{};
+        std::uint32_t count = 0;
+        double sum = 0.0;
+        float max = 0.0f;
+
+        static int GetBucketIndex(const float seconds) {
+            if (seconds < static_cast<float>(linear_seconds)) {
+                return std::max(0, static_cast<int>(seconds));
+            }
+            const auto whole = static_cast<std::uint32_t>(std::min(seconds, 1.0e9f));
+            const int octave = static_cast<int>(std::bit_width(whole / linear_seconds)) - 1;
+            if (octave >= octaves) return bucket_count - 1;
+
+            const float lower = static_cast<float>(linear_seconds << octave);
+            const int sub = static_cast<int>((seconds - lower) / (lower / sub_buckets));
+            return linear_seconds + octave * sub_buckets + std::min(sub, sub_buckets - 1);
+        }
+
+        /**
+     * @brief Shortest duration that lands in a bucket
+     */
+        static float GetBucketLowerBound(const int bucket) {
+            if (bucket < linear_seconds) return static_cast<float>(bucket);
+            const int octave = (bucket - linear_seconds) / sub_buckets;
+            const int sub = (bucket - linear_seconds) % sub_buckets;
+            const float lower = static_cast<float>(linear_seconds << octave);
+            return lower + static_cast<float>(sub) * lower / sub_buckets;
+        }
+
+        void Record(const float seconds) {
+            const float value = std::max(0.0f, seconds);
+            buckets[GetBucketIndex(value)]++;
+            count++;
+            sum += value;
+            max = std::max(max, value);
+        }
+
+        void Merge(const LatencyHistogram& other) {
+            for (int i = 0; i < bucket_count; i++) {
+                buckets[i] += other.buckets[i];
+            }
+            count += other.count;
+            sum += other.sum;
+            max = std::max(max, other.max);
+        }
+
+        void Clear() {
+            *this = LatencyHistogram{};
+        }
+
+        float GetMean() const {
+            return count > 0 ? static_cast<float>(sum / count) : 0.0f;
+        }
+
+        /**
+     * @brief Number of samples shorter than a duration, to bucket precision
+     */
+        std::uint32_t CountBelow(const float seconds) const {
+            std::uint32_t below = 0;
+            for (int i = 0; i < bucket_count && GetBucketLowerBound(i) < seconds; i++) {
+                below += buckets[i];
+            }
+            return below;
+        }
+
+        /**
+     * @brief Duration below which the given fraction (0-1) of samples fall
+     */
+        float GetPercentile(const float fraction) const {
+            if (count == 0) return 0.0f;
+
+            const float rank = std::clamp(fraction, 0.0f, 1.0f) * static_cast<float>(count);
+            std::uint32_t below = 0;
+            for (int i = 0; i < bucket_count; i++) {
+                if (buckets[i] == 0) continue;
+                if (static_cast<float>(below + buckets[i]) >= rank) {
+                    if (i == bucket_count - 1) return max;
+                    const float lower = GetBucketLowerBound(i);
+                    const float within = (rank - static_cast<float>(below)) / static_cast<float>(buckets[i]);
+                    return std::min(lower + within * (GetBucketLowerBound(i + 1) - lower), max);
+                }
+                below += buckets[i];
+            }
+            return max;
+        }
+    };
+
+    /**
+ * @brief Per-shaft elevator performance counters
+ * 
+ * Attached to ElevatorShaft entities next to the dispatcher. Completed
+ * elevator legs record their hall wait and ride time; cars add the time
+ * they spend busy. Lifetime totals are kept along with a ring of windows,
+ * one per sim-hour, covering the last day.
+ */
+    struct ElevatorTelemetry {
+        static constexpr int window_count = 24;
+
+        struct HourWindow {
+            std::int64_t hour = -1;       // Absolute sim-hour this window covers, -1 when unused
+            LatencyHistogram wait_times;
+            LatencyHistogram ride_times;
+            std::uint32_t trips = 0;
+            float car_seconds = 0.0f;
+            float busy_car_seconds = 0.0f;
+        };
+
+        /**
+     * @brief Learned hall-call origins for one hour of the day
+     * 
+     * Counts per floor; older days fade by demand_decay each time the hour
+     * comes round again, so the profile follows the tower as it changes.
+     */
+        struct CallOriginProfile {
+            std::int64_t day = -1;        // Last day this hour recorded a call
+            std::vector<float> calls;     // Index: floor - demand_base_floor
+        };
+
+        LatencyHistogram wait_times;
+        LatencyHistogram ride_times;
+        std::array<HourWindow, window_count> windows{};
+        std::uint64_t total_trips = 0;
+        double car_seconds = 0.0;         // Summed over every car in the shaft
+        double busy_car_seconds = 0.0;
+
+        std::array<CallOriginProfile, window_count> call_origins{};  // Index: hour of day
+        int demand_base_floor = 0;        // Shaft bottom floor when telemetry was attached
+        float demand_decay = 0.5f;        // Weight kept by previous days' calls
+
+        ElevatorTelemetry(const int base_floor = 0)
+            : demand_base_floor(base_floor) {}
+
+        /**
+     * @brief Window for a sim-hour, recycling the slot from a day earlier
+     */
+        HourWindow& GetWindow(const std::int64_t hour) {
+            HourWindow& window = windows[static_cast<std::size_t>(((hour % window_count) + window_count) % window_count)];
+            if (window.hour != hour) {
+                window = HourWindow{};
+                window.hour = hour;
+            }
+            return window;
+        }
+
+        void RecordTrip(const std::int64_t hour, const float wait_time, const float ride_time) {
+            wait_times.Record(wait_time);
+            ride_times.Record(ride_time);
+            total_trips++;
+
+            HourWindow& window = GetWindow(hour);
+            window.wait_times.Record(wait_time);
+            window.ride_times.Record(ride_time);
+            window.trips++;
+        }
+
+        void RecordCarTime(const std::int64_t hour, const float seconds, const bool busy) {
+            car_seconds += seconds;
+            HourWindow& window = GetWindow(hour);
+            window.car_seconds += seconds;
+            if (busy) {
+                busy_car_seconds += seconds;
+                window.busy_car_seconds += seconds;
+            }
+        }
+
+        void RecordCallOrigin(const std::int64_t hour, const int floor) {
+            const int index = floor - demand_base_floor;
+            if (index < 0 || hour < 0) return;
+
+            CallOriginProfile& profile = call_origins[static_cast<std::size_t>(hour % window_count)];
+            const std::int64_t day = hour / window_count;
+            if (profile.day != day) {
+                for (float& calls : profile.calls) {
+                    calls *= demand_decay;
+                }
+                profile.day = day;
+            }
+            if (static_cast<std::size_t>(index) >= profile.calls.size()) {
+                profile.calls.resize(static_cast<std::size_t>(index) + 1, 0.0f);
+            }
+            profile.calls[static_cast<std::size_t>(index)] += 1.0f;
+        }
+
+        /**
+     * @brief Floors with the most learned calls in an hour of the day, busiest first
+     * 
+     * @param hour_of_day 0-23
+     * @param max_floors Maximum number of floors to return
+     * @param min_calls Floors with fewer learned calls are left out
+     */
+        std::vector<int> GetBusiestCallFloors(const int hour_of_day, const int max_floors, const float min_calls) const {
+            const CallOriginProfile& profile = call_origins[static_cast<std::size_t>(
+                ((hour_of_day % window_count) + window_count) % window_count)];
+
+            std::vector<int> floors;
+            for (std::size_t i = 0; i < profile.calls.size(); i++) {
+                if (profile.calls[i] >= min_calls) {
+                    floors.push_back(demand_base_floor + static_cast<int>(i));
+                }
+            }
+            std::stable_sort(floors.begin(), floors.end(), [&](const int a, const int b) {
+                return profile.calls[static_cast<std::size_t>(a - demand_base_floor)] >
+                       profile.calls[static_cast<std::size_t>(b - demand_base_floor)];
+            });
+            if (static_cast<int>(floors.size()) > max_floors) {
+                floors.resize(static_cast<std::size_t>(std::max(0, max_floors)));
+            }
+            return floors;
+        }
+
+        /**
+     * @brief Fraction of car time (0-1) spent moving or at a stop
+     */
+        float GetUtilization() const {
+            return car_seconds > 0.0 ? static_cast<float>(busy_car_seconds / car_seconds) : 0.0f;
+        }
+
+        /**
+     * @brief Wait times from the windows within the last day, up to the given hour
+     */
+        LatencyHistogram GetRecentWaitTimes(const std::int64_t current_hour) const {
+            LatencyHistogram recent;
+            for (const auto& window : windows) {
+                if (window.hour >= 0 && window.hour <= current_hour && window.hour > current_hour - window_count) {
+                    recent.Merge(window.wait_times);
+                }
+            }
+            return recent;
+        }
+
+        /**
+     * @brief Average completed trips per sim-hour over the windows in use
+     */
+        float GetTripsPerHour() const {
+            std::uint32_t trips = 0;
+            int hours = 0;
+            for (const auto& window : windows) {
+                if (window.hour < 0) continue;
+                trips += window.trips;
+                hours++;
+            }
+            return hours > 0 ? static_cast<float>(trips) / static_cast<float>(hours) : 0.0f;
+        }
+    };
+
+    /**
+ * @brief Global singleton with the idle-car parking policy
+ * 
+ * Cars that sit idle with nothing to do are sent to the floors where their
+ * shaft's telemetry has learned calls come from in the upcoming hour, e.g.
+ * the lobby ahead of the morning rush or office floors before the evening
+ * one. Each parked floor gets at most one car.
+ */
+    struct ElevatorParkingPolicy {
+        bool enabled;
+        float lookahead_hours;        // Plan for the hour this far ahead
+        float idle_delay;             // Seconds a car must idle before it is moved
+        float min_calls;              // Learned calls a floor needs to attract a car
+        int total_repositions;
+
+        ElevatorParkingPolicy(const bool enable_parking = true)
+            : enabled(enable_parking),
+              lookahead_hours(0.25f),
+              idle_delay(5.0f),
+              min_calls(2.0f),
+              total_repositions(0) {}
+    };
+
+    /**
+ * @brief One elevator ride of a trip
+ */
+    struct TripLeg {
+        std::uint64_t shaft_id;
+        int column;         // Column of the shaft, where the person boards
+        int board_floor;
+        int alight_floor;
+    };
+
+    /**
+ * @brief Component holding a person's planned elevator trip
+ * 
+ * Attached when a person starts a trip between floors. Trips that no single
+ * shaft covers have several legs, with a walk between shafts at each
+ * transfer floor. The final column is kept here because walking to a shaft
+ * overwrites Person::destination_column.
+ */
+    struct TripItinerary {
+        std::vector<TripLeg> legs;
+        size_t current_leg;
+        int final_floor;
+        float final_column;
+
+        TripItinerary(std::vector<TripLeg> trip_legs = {}, const int floor = 0, const float column = 0.0f)
+            : legs(std::move(trip_legs)),
+              current_leg(0),
+              final_floor(floor),
+              final_column(column) {}
+
+        /**
+     * @brief Get the next leg boarding at a floor, advancing past completed legs (nullptr if none)
+     */
+        const TripLeg* AdvanceTo(const int floor) {
+            for (size_t i = current_leg; i < legs.size(); ++i) {
+                if (legs[i].board_floor == floor) {
+                    current_leg = i;
+                    return &legs[i];
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    /**
+ * @brief Global singleton caching per-floor flow fields for horizontal walking
+ * 
+ * A field holds, for every cell of one floor, the walking cost to a target
+ * column and the step (-1, 0 or +1) that leads there. Fields are generated
+ * from the TowerGrid on first use and shared by every walker heading to the
+ * same (floor, column): shaft columns, stairs, the lobby exit and facility
+ * entrances each end up with one field per floor. Unbuilt cells are gaps
+ * nobody can cross; facility footprints can be crossed but cost more.
+ * 
+ * Sync() reads the grid's change journal and drops only the floors that
+ * changed since the last sync.
+ */
+    struct FloorFlowFields {
+        struct Field {
+            std::vector<float> cost;          // Walking cost to the target per cell (infinity = unreachable)
+            std::vector<std::int8_t> step;    // Direction to walk from each cell
+        };
+
+        struct FloorCache {
+            std::vector<float> cell_costs;    // Cost to cross each cell (infinity = not built)
+            std::unordered_map<int, Field> fields;  // Keyed by target column
+        };
+
+        // Not owned: ECSWorld's TowerGrid, which is declared before its flecs world and so outlives
+        // this singleton. Must be set before the cache is used.
+        const TowerGrid* grid;
+        std::uint64_t synced_sequence;
+        float facility_cell_cost;     // Relative cost of crossing a facility footprint
+        std::unordered_map<int, FloorCache> floors;
+        int fields_built;
+        int floors_invalidated;
+
+        FloorFlowFields(const TowerGrid* tower_grid = nullptr)
+            : grid(tower_grid),
+              synced_sequence(0),
+              facility_cell_cost(1.5f),
+              fields_built(0),
+              floors_invalidated(0) {}
+
+        /**
+     * @brief Drop cached floors the grid changed since the last sync
+     */
+        void Sync();
+
+        /**
+     * @brief Get the cost of crossing a cell (1 for open floor, infinity for gaps)
+     */
+        float GetCellCost(int floor, int column);
+
+        /**
+     * @brief Get the field leading to a target column on a floor (nullptr for unbuilt targets)
+     */
+        const Field* GetField(int floor, int target_column);
+
+        /**
+     * @brief Get the furthest column toward a target reachable from a built column without crossing a gap
+     */
+        int GetReachableColumn(int floor, int from_column, int target_column);
+
+    private:
+        FloorCache& GetFloor(int floor);
+    };
+
+    /**
+ * @brief Global singleton counting people per grid cell, rebuilt every tick
+ * 
+ * One linear pass over everyone standing or walking in the tower (riders
+ * and people on the stairs are not in the hall). Walkers slow down in cells
+ * holding more than comfortable_per_cell people, and waiting passengers
+ * stand in hall queues that spill out from the shaft queue_slots_per_cell
+ * at a time. The counts can also drive heatmaps and crowding penalties.
+ */
+    struct CrowdDensity {
+        const TowerGrid* grid;
+        int min_floor;
+        int floor_count;
+        int columns;
+        std::vector<std::uint16_t> counts;   // Index: (floor - min_floor) * columns + column
+        float comfortable_per_cell;          // People a cell holds before walkers slow down
+        float min_speed_factor;              // Slowest walking speed in a packed cell, relative to free walking
+        int queue_slots_per_cell;            // Waiting passengers that fit in one cell of a hall queue
+        int peak_count;                      // Busiest cell in the last pass
+
+        CrowdDensity(const TowerGrid* tower_grid = nullptr)
+            : grid(tower_grid),
+              min_floor(0),
+              floor_count(0),
+              columns(0),
+              comfortable_per_cell(3.0f),
+              min_speed_factor(0.25f),
+              queue_slots_per_cell(4),
+              peak_count(0) {}
+
+        /**
+     * @brief Clear the counts, resizing to the grid's current extent
+     */
+        void Reset() {
+            if (grid != nullptr) {
+                min_floor = grid->GetLowestFloorIndex();
+                floor_count = grid->GetHighestFloorIndex() - min_floor + 1;
+                columns = grid->GetColumnCount();
+            }
+            counts.assign(static_cast<size_t>(floor_count) * columns, 0);
+            peak_count = 0;
+        }
+
+        /**
+     * @brief Count a person standing at a column of a floor
+     */
+        void Add(const int floor, const float column) {
+            const int cell = GetIndex(floor, static_cast<int>(std::floor(column)));
+            if (cell < 0 || counts[cell] == std::numeric_limits<std::uint16_t>::max()) return;
+            peak_count = std::max(peak_count, static_cast<int>(++counts[cell]));
+        }
+
+        /**
+     * @brief Get the number of people in a cell (0 outside the grid)
+     */
+        int GetCount(const int floor, const int column) const {
+            const int cell = GetIndex(floor, column);
+            return cell < 0 ? 0 : counts[cell];
+        }
+
+        /**
+     * @brief Get the walking speed multiplier for a cell (1 when it is not crowded)
+     */
+        float GetSpeedFactor(const int floor, const int column) const {
+            const float count = static_cast<float>(GetCount(floor, column));
+            if (count <= comfortable_per_cell) return 1.0f;
+            return std::max(min_speed_factor, comfortable_per_cell / count);
+        }
+
+        /**
+     * @brief Get where a passenger stands in a hall queue
+     * 
+     * The first queue_slots_per_cell passengers wait at the shaft; the rest
+     * line up away from it, up-callers to the left and down-callers to the right.
+     */
+        float GetQueueColumn(const int shaft_column, const bool going_up, const int position) const {
+            const int offset = position / std::max(1, queue_slots_per_cell);
+            const int column = shaft_column + (going_up ? -offset : offset);
+            if (columns == 0) return static_cast<float>(column);
+            return static_cast<float>(std::clamp(column, 0, columns - 1));
+        }
+
+    private:
+        int GetIndex(const int floor, const int column) const {
+            if (floor < min_floor || floor >= min_floor + floor_count || column < 0 || column >= columns) {
+                return -1;
+            }
+            return (floor - min_floor) * columns + column;
+        }
+    };
+
+    /**
+ * @brief Component for stairs and escalators linking a floor to the one above
+ * 
+ * FacilityManager adds it to Stairs and Escalator facilities. People cross
+ * between bottom_floor and bottom_floor + 1 at the connector's column in
+ * either direction, without calling an elevator.
+ */
+    struct StairsConnector {
+        int bottom_floor;
+        int column;
+        float seconds_per_floor;   // Time to climb or descend one floor
+
+        StairsConnector(const int floor = 0, const int col = 0, const float seconds = 5.0f)
+            : bottom_floor(floor),
+              column(col),
+              seconds_per_floor(seconds) {}
+
+        /**
+     * @brief Check if the connector links a floor to the next one in a direction
+     */
+        bool Connects(const int floor, const bool going_up) const {
+            return going_up ? floor == bottom_floor : floor == bottom_floor + 1;
+        }
+    };
+
+    /**
+ * @brief Component for a person crossing one floor on stairs or an escalator
+ * 
+ * Like TripItinerary, the final column is kept here because walking to the
+ * connector overwrites Person::destination_column.
+ */
+    struct StairsTrip {
+        int column;           // Column of the connector
+        int from_floor;
+        int to_floor;
+        float seconds;        // Time to cross
+        float elapsed;
+        float final_column;
+
+        StairsTrip(const int col = 0, const int from = 0, const int to = 0,
+                   const float duration = 0.0f, const float final_col = 0.0f)
+            : column(col),
+              from_floor(from),
+              to_floor(to),
+              seconds(duration),
+              elapsed(0.0f),
+              final_column(final_col) {}
+    };
+
+    /**
+ * @brief Component for a person taking part in an evacuation
+ * 
+ * Added to everyone in the tower when an evacuation starts and removed when
+ * it ends. Systems that hand out new destinations skip people carrying it.
+ */
+    struct Evacuee {
+        float stairs_remaining;   // Seconds left on the current flight of stairs (0 = not on the stairs)
+        int stairs_direction;     // +1 climbing, -1 descending
+        bool evacuated;           // Reached an exit
+        bool trapped;             // No route out from where the person stood
+
+        Evacuee()
+            : stairs_remaining(0.0f),
+              stairs_direction(0),
+              evacuated(false),
+              trapped(false) {}
+    };
+
+    /**
+ * @brief Multi-floor field leading everyone in the tower to the nearest exit
+ * 
+ * Built once when an evacuation starts, by a multi-source Dijkstra outward
+ * from every exit over built cells, with stairwells as the only links
+ * between floors. Each cell stores the seconds left to get out at walking
+ * pace, the next step to take, and the column where the walk along the
+ * floor ends (an exit or a stairwell) so a walker covers a whole run in one
+ * move.
+ */
+    struct EvacuationField {
+        enum class Step : std::int8_t {
+            None,     // No way out from this cell
+            Left,
+            Right,
+            Down,     // Take the stairwell here to the floor below
+            Up,       // Take the stairwell here to the floor above
+            Exit      // Leave the tower here
+        };
+
+        int min_floor;
+        int floor_count;
+        int columns;
+        std::vector<float> cell_costs;      // Relative cost of crossing each cell (infinity = not built)
+        std::vector<float> cost;            // Seconds to get out from each cell (infinity = trapped)
+        std::vector<Step> step;
+        std::vector<int> waypoint;          // Column where the walk along this floor ends
+        std::vector<float> stairs_seconds;  // Time on the stairwell for Down/Up cells
+        int exit_count;
+        int stairwell_count;
+
+        EvacuationField()
+            : min_floor(0),
+              floor_count(0),
+              columns(0),
+              exit_count(0),
+              stairwell_count(0) {}
+
+        /**
+     * @brief Get the flat index of a cell (-1 outside the field)
+     */
+        int GetIndex(const int floor, const int column) const {
+            if (floor < min_floor || floor >= min_floor + floor_count || column < 0 || column >= columns) {
+                return -1;
+            }
+            return (floor - min_floor) * columns + column;
+        }
+
+        /**
+     * @brief Compute the field for the grid's current layout
+     * 
+     * @param grid Tower layout; unbuilt cells are impassable
+     * @param stairwells Links between floors (stairs, escalators, fire stairs)
+     * @param exit_columns Ground-floor columns leading outside
+     * @param walk_speed Nominal walking speed in columns per second
+     * @param facility_cell_cost Relative cost of crossing a facility footprint
+     */
+        void Build(const TowerGrid& grid, const std::vector<StairsConnector>& stairwells,
+                   const std::vector<int>& exit_columns, float walk_speed, float facility_cell_cost);
+    };
+
+    /**
+ * @brief Global singleton running a tower evacuation
+ * 
+ * Begin() asks for an evacuation on the next tick: the field is built once
+ * from TowerGrid, cars let their riders out at the nearest floor, and
+ * everyone in the tower walks to the nearest exit over stairs, escalators
+ * and (with shafts_have_fire_stairs) the fire stairs beside each elevator
+ * shaft. Each stairwell door admits stairwell_entries_per_second people.
+ * time_to_clear is set once everyone who can get out has.
+ */
+    struct Evacuation {
+        bool active;
+        bool start_requested;
+        bool end_requested;
+        float elapsed;                      // Seconds since the evacuation started
+        int evacuees;                       // People taking part (grows if cohorts materialize)
+        int evacuated;
+        int trapped;                        // People with no route out
+        float time_to_clear;                // Seconds until everyone reachable was out (-1 while in progress)
+
+        float walk_speed;                   // Nominal pace the field is costed at (columns per second)
+        float fire_stairs_seconds_per_floor;
+        float stairwell_entries_per_second; // Door throughput of one stairwell on one floor
+        bool shafts_have_fire_stairs;
+
+        EvacuationField field;
+        std::vector<float> stairwell_open_at;   // Per cell: when the stairwell door there admits the next person
+
+        Evacuation()
+            : active(false),
+              start_requested(false),
+              end_requested(false),
+              elapsed(0.0f),
+              evacuees(0),
+              evacuated(0),
+              trapped(0),
+              time_to_clear(-1.0f),
+              walk_speed(2.0f),
+              fire_stairs_seconds_per_floor(8.0f),
+              stairwell_entries_per_second(1.2f),
+              shafts_have_fire_stairs(true) {}
+
+        /**
+     * @brief Start an evacuation on the next tick
+     */
+        void Begin() {
+            start_requested = true;
+            end_requested = false;
+        }
+
+        /**
+     * @brief Stand everyone down on the next tick; the report is kept
+     */
+        void End() {
+            end_requested = true;
+            start_requested = false;
+        }
+
+        /**
+     * @brief Get how many people are still on their way out
+     */
+        int GetRemaining() const {
+            return evacuees - evacuated - trapped;
+        }
+
+        /**
+     * @brief Check if everyone who can get out has
+     */
+        bool IsClear() const {
+            return time_to_clear >= 0.0f;
+        }
+    };
+
+    /**
+ * @brief Global singleton mapping (origin floor, destination floor) to the shafts that connect them
+ * 
+ * The table is flattened over the floor span of all shafts: each floor pair
+ * owns a contiguous run in one candidate array, so a lookup is a single
+ * index computation. Observers mark the table dirty when shafts are added,
+ * removed, resized or re-zoned, and it is rebuilt once before the next lookup.
+ * Only floors in a shaft's served-floor mask count as connected.
+ * 
+ * Trips no single shaft covers are planned over a transit graph whose nodes
+ * are (shaft, floor) pairs at transfer floors. Shortest routes are cached
+ * per floor pair and the cache is dropped on every rebuild.
+ * 
+ * Trips of up to max_stairs_floors floors walk over stairs and escalators
+ * instead when that is quicker than the estimated elevator ride.
+ */
+    struct ShaftRoutingTable {
+        struct Candidate {
+            std::uint64_t shaft_id;
+            int column;
+            int intermediate_stops;     // Served floors the car may stop at on the way
+        };
+
+        int min_floor;
+        int floor_span;                     // Floors covered by the table (0 when there are no shafts)
+        std::vector<std::uint32_t> offsets; // Start of each floor pair's run in candidates; floor_span^2 + 1 entries
+        std::vector<Candidate> candidates;
+        std::vector<std::pair<std::uint64_t, ElevatorShaft>> shafts;   // Snapshot taken at the last rebuild
+        std::vector<StairsConnector> stairs;                             // Snapshot taken at the last rebuild
+        std::unordered_map<std::int64_t, std::vector<TripLeg>> route_cache;  // (origin, destination) key; empty = unreachable
+        bool dirty;
+        int rebuild_count;
+
+        // Transit graph costs (seconds)
+        float ride_floors_per_second;
+        float walk_columns_per_second;
+        float boarding_penalty;   // Expected wait for every car boarded
+        float intermediate_stop_penalty;  // Expected delay per served floor passed; favours express shafts
+        int max_stairs_floors;    // Longest trip that considers stairs and escalators
+
+        ShaftRoutingTable()
+            : min_floor(0),
+              floor_span(0),
+              dirty(true),
+              rebuild_count(0),
+              ride_floors_per_second(2.0f),
+              walk_columns_per_second(2.0f),
+              boarding_penalty(10.0f),
+              intermediate_stop_penalty(0.5f),
+              max_stairs_floors(2) {}
+
+        void MarkDirty() {
+            dirty = true;
+        }
+
+        /**
+     * @brief Rebuild the table from every shaft and floor connector in the tower
+     */
+        void Rebuild(const std::vector<std::pair<std::uint64_t, ElevatorShaft>>& tower_shafts,
+                     const std::vector<StairsConnector>& tower_stairs = {}) {
+            shafts = tower_shafts;
+            stairs = tower_stairs;
+            offsets.clear();
+            candidates.clear();
+            route_cache.clear();
+            floor_span = 0;
+            dirty = false;
+            rebuild_count++;
+            if (shafts.empty()) return;
+
+            int max_floor = shafts.front().second.top_floor;
+            min_floor = shafts.front().second.bottom_floor;
+            for (const auto& [id, shaft] : shafts) {
+                min_floor = std::min(min_floor, shaft.bottom_floor);
+                max_floor = std::max(max_floor, shaft.top_floor);
+            }
+            floor_span = max_floor - min_floor + 1;
+
+            offsets.reserve(static_cast<size_t>(floor_span) * floor_span + 1);
+            for (int origin = min_floor; origin <= max_floor; ++origin) {
+                for (int destination = min_floor; destination <= max_floor; ++destination) {
+                    offsets.push_back(static_cast<std::uint32_t>(candidates.size()));
+                    if (origin == destination) continue;
+                    for (const auto& [id, shaft] : shafts) {
+                        if (shaft.ServesFloor(origin) && shaft.ServesFloor(destination)) {
+                            candidates.push_back({id, shaft.column, shaft.CountServedFloorsBetween(origin, destination)});
+                        }
+                    }
+                }
+            }
+            offsets.push_back(static_cast<std::uint32_t>(candidates.size()));
+        }
+
+        /**
+     * @brief Get the shafts serving both floors (empty if none)
+     */
+        std::span<const Candidate> GetCandidates(const int origin, const int destination) const {
+            if (floor_span == 0 ||
+                origin < min_floor || origin >= min_floor + floor_span ||
+                destination < min_floor || destination >= min_floor + floor_span) {
+                return {};
+            }
+            const size_t pair = static_cast<size_t>(origin - min_floor) * floor_span + (destination - min_floor);
+            return {candidates.data() + offsets[pair], candidates.data() + offsets[pair + 1]};
+        }
+
+        /**
+     * @brief Get the connecting shaft with the shortest walk from a column (nullptr if none)
+     * 
+     * Walk time is weighed against the stops a shaft may make on the way, so
+     * an express shaft a few columns further can beat a local one.
+     */
+        const Candidate* FindNearestShaft(const int origin, const int destination, const float column) const {
+            const Candidate* nearest = nullptr;
+            float nearest_cost = 0.0f;
+            for (const Candidate& candidate : GetCandidates(origin, destination)) {
+                const float cost = std::abs(static_cast<float>(candidate.column) - column) / walk_columns_per_second +
+                                   static_cast<float>(candidate.intermediate_stops) * intermediate_stop_penalty;
+                if (nearest == nullptr || cost < nearest_cost) {
+                    nearest = &candidate;
+                    nearest_cost = cost;
+                }
+            }
+            return nearest;
+        }
+
+        /**
+     * @brief Get the quickest stairs or escalator leaving a floor in a direction (nullptr if none)
+     */
+        const StairsConnector* FindNearestStairs(const int floor, const bool going_up, const float column) const {
+            const StairsConnector* nearest = nullptr;
+            float nearest_cost = 0.0f;
+            for (const StairsConnector& connector : stairs) {
+                if (!connector.Connects(floor, going_up)) continue;
+                const float cost = std::abs(static_cast<float>(connector.column) - column) / walk_columns_per_second +
+                                   connector.seconds_per_floor;
+                if (nearest == nullptr || cost < nearest_cost) {
+                    nearest = &connector;
+                    nearest_cost = cost;
+                }
+            }
+            return nearest;
+        }
+
+        /**
+     * @brief Get the first stairs to take if walking beats the elevator (nullptr to ride instead)
+     * 
+     * Walking costs the walk to each connector plus its crossing time. The
+     * elevator costs the walk to the nearest direct shaft, the expected wait,
+     * and the ride; trips that would need a transfer always walk.
+     */
+        const StairsConnector* FindStairsRoute(const int origin, const int destination, const float column) const {
+            const int floors = std::abs(destination - origin);
+            if (floors == 0 || floors > max_stairs_floors || stairs.empty()) return nullptr;
+
+            const bool going_up = destination > origin;
+            const StairsConnector* first = nullptr;
+            float walk_cost = 0.0f;
+            float at_column = column;
+            for (int floor = origin; floor != destination; floor += going_up ? 1 : -1) {
+                const StairsConnector* hop = FindNearestStairs(floor, going_up, at_column);
+                if (hop == nullptr) return nullptr;
+                if (first == nullptr) first = hop;
+                walk_cost += std::abs(static_cast<float>(hop->column) - at_column) / walk_columns_per_second +
+                             hop->seconds_per_floor;
+                at_column = static_cast<float>(hop->column);
+            }
+
+            if (const Candidate* shaft = FindNearestShaft(origin, destination, column)) {
+                const float ride_cost = std::abs(static_cast<float>(shaft->column) - column) / walk_columns_per_second +
+                                        boarding_penalty +
+                                        static_cast<float>(floors) / ride_floors_per_second +
+                                        static_cast<float>(shaft->intermediate_stops) * intermediate_stop_penalty;
+                if (ride_cost < walk_cost) return nullptr;
+            }
+            return first;
+        }
+
+        /**
+     * @brief Get the fastest route between two floors (empty if unreachable)
+     * 
+     * Direct trips use the shaft nearest the given column. Other trips run
+     * Dijkstra over (shaft, floor) nodes: riding costs travel time, and
+     * every boarding adds the expected wait plus the walk between shafts.
+     * The route is returned by value, so it stays valid across later calls.
+     */
+        std::vector<TripLeg> FindRoute(int origin, int destination, float column);
+
+    private:
+        std::vector<TripLeg> PlanTransferRoute(int origin, int destination) const;
     };
 
     /**
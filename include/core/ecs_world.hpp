@@ -86,8 +86,9 @@ namespace towerforge::core {
         void RegisterComponents() const;
         void RegisterSystems() const;
 
-        mutable flecs::world world_;
+        // Declared before the world so singletons that point at it (FloorFlowFields, CrowdDensity) never outlive it
         std::unique_ptr<TowerGrid> tower_grid_;
+        mutable flecs::world world_;
         std::unique_ptr<FacilityManager> facility_manager_;
         std::unique_ptr<LuaModManager> mod_manager_;
     };
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+namespace towerforge::core {
+
+    class ECSWorld;
+    struct TimeManager;
+
+    /**
+     * @brief Runs the simulation ahead to a target time on a worker thread
+     *
+     * Steps ECSWorld::Update at a fixed delta as fast as the CPU allows until the
+     * TimeManager clock reaches the target, Cancel() is called or the world asks
+     * to stop. The owner must not touch the world (update, render or input)
+     * while IsRunning() is true; Finish() joins the worker and hands it back.
+     */
+    class SimulationFastForward {
+    public:
+        /**
+         * @brief Outcome of one fast-forward run
+         */
+        struct Result {
+            bool reached_target = false;
+            int steps = 0;              // Fixed steps taken
+            double sim_hours = 0.0;     // In-game hours advanced
+            double wall_seconds = 0.0;  // Real time spent on the worker
+
+            double GetSimHoursPerWallSecond() const {
+                return wall_seconds > 0.0 ? sim_hours / wall_seconds : 0.0;
+            }
+        };
+
+        SimulationFastForward() = default;
+        ~SimulationFastForward();
+
+        SimulationFastForward(const SimulationFastForward&) = delete;
+        SimulationFastForward& operator=(const SimulationFastForward&) = delete;
+
+        /**
+         * @brief Absolute hours of the next occurrence of hour (always in the future)
+         */
+        static double GetNextTimeOfDay(const TimeManager& time, float hour);
+
+        /**
+         * @brief Absolute hours of the next occurrence of day (0 = Monday) at hour
+         */
+        static double GetNextDayOfWeek(const TimeManager& time, int day, float hour);
+
+        /**
+         * @brief Start stepping the world toward target_hours on a worker thread
+         *
+         * @param ecs_world World to advance; must outlive the run
+         * @param target_hours Absolute hours (see TimeManager::GetAbsoluteHours) to stop at
+         * @param step_seconds Fixed delta passed to every Update
+         * @param max_steps Safety cap, e.g. when the clock is paused
+         * @return false if a run is already in progress or the target is not ahead
+         */
+        bool Start(ECSWorld& ecs_world, double target_hours, float step_seconds, int max_steps = 10000000);
+
+        /**
+         * @brief Run synchronously on the calling thread (headless tools and tests)
+         */
+        static Result Run(ECSWorld& ecs_world, double target_hours, float step_seconds,
+                          int max_steps = 10000000, const std::atomic<bool>* cancel = nullptr,
+                          std::atomic<float>* progress = nullptr);
+
+        /**
+         * @brief Ask the worker to stop after its current step
+         */
+        void Cancel();
+
+        /**
+         * @brief True from Start() until the worker has produced its result
+         */
+        bool IsRunning() const { return worker_.joinable() && !done_.load(); }
+
+        /**
+         * @brief True once the worker has stopped and Finish() can join without blocking
+         */
+        bool IsDone() const { return worker_.joinable() && done_.load(); }
+
+        /**
+         * @brief Fraction of the span covered so far (0.0 - 1.0)
+         */
+        float GetProgress() const { return progress_.load(); }
+
+        /**
+         * @brief Join the worker and return its result; the world is safe to use again
+         */
+        Result Finish();
+
+    private:
+        std::thread worker_;
+        std::atomic<bool> cancel_{false};
+        std::atomic<bool> done_{false};
+        std::atomic<float> progress_{0.0f};
+        Result result_;
+    };
+
+}
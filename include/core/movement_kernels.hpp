@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace towerforge::core::kernels {
+
+    /**
+     * @brief Advance a batch of 1D positions toward their targets
+     *
+     * For every element, moves position by step toward target. Elements whose
+     * step reaches or passes the target snap onto it and get arrived = 1; the
+     * rest get arrived = 0. Walkers use it for current_column and cars for
+     * current_floor.
+     *
+     * @param positions Positions to advance in place
+     * @param targets Target positions
+     * @param steps Distance each element may cover this tick (non-negative)
+     * @param arrived Output flags, one byte per element
+     * @param count Number of elements
+     * @return Number of elements that arrived
+     */
+    std::size_t AdvanceToward(float* positions, const float* targets, const float* steps,
+                              std::uint8_t* arrived, std::size_t count);
+
+    /**
+     * @brief Scalar reference for AdvanceToward; the vector paths must match it exactly
+     */
+    std::size_t AdvanceTowardScalar(float* positions, const float* targets, const float* steps,
+                                    std::uint8_t* arrived, std::size_t count);
+
+    /**
+     * @brief Get the instruction set AdvanceToward was built for ("AVX2", "SSE2" or "Scalar")
+     */
+    const char* GetKernelName();
+
+    /**
+     * @brief Flat arrays of positions gathered from one table for AdvanceToward
+     *
+     * rows maps each batch slot back to its row in the table being processed.
+     */
+    struct MovementBatch {
+        std::vector<std::size_t> rows;
+        std::vector<float> positions;
+        std::vector<float> targets;
+        std::vector<float> steps;
+        std::vector<std::uint8_t> arrived;
+
+        void Clear() {
+            rows.clear();
+            positions.clear();
+            targets.clear();
+            steps.clear();
+        }
+
+        void Add(const std::size_t row, const float position, const float target, const float step) {
+            rows.push_back(row);
+            positions.push_back(position);
+            targets.push_back(target);
+            steps.push_back(step);
+        }
+
+        std::size_t Advance() {
+            arrived.resize(rows.size());
+            return AdvanceToward(positions.data(), targets.data(), steps.data(), arrived.data(), rows.size());
+        }
+    };
+
+}
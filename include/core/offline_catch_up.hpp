@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+
+namespace towerforge::core {
+
+    class ECSWorld;
+    struct TimeManager;
+
+    /**
+     * @brief Advances a tower analytically over time spent away from it
+     *
+     * Instead of stepping every tick, each facility and crowd cohort is visited
+     * once and moved across the whole span with the closed-form paths on its
+     * components: status, cleanliness and maintenance degradation, tenant churn
+     * and rent, tower points, visitor needs, cohort departures, and the day
+     * rollovers of TowerEconomy. Satisfaction, staffing and facility occupancy
+     * are held at their values when the span starts, so a loaded tower must be
+     * caught up before anything resets them. Facilities covered by a janitor or
+     * maintenance worker whose shift falls in the span end it serviced, since
+     * live staff reach them every few seconds. A paused clock stays paused.
+     */
+    class OfflineCatchUp {
+    public:
+        /**
+         * @brief World seconds per second of degradation and tower-point time
+         *
+         * The live degradation and tower-point systems run once a second but
+         * advance by that frame's delta, one 60 fps frame, so they move at 1/60
+         * of world time. Rent and tenant churn step by whole seconds.
+         */
+        static constexpr float frame_step_period = 60.0f;
+
+        /**
+         * @brief What one catch-up pass changed
+         */
+        struct Result {
+            float seconds = 0.0f;          // Simulated seconds covered
+            double sim_hours = 0.0;        // In-game hours the clock moved
+            int days_closed = 0;           // Day boundaries booked into the economy
+            float revenue = 0.0f;
+            float expenses = 0.0f;
+            int research_points = 0;       // Tower points earned
+            int facilities = 0;            // Facilities advanced
+            int visitors = 0;              // Individual visitors whose needs grew
+            float cohort_departures = 0.0f;
+
+            bool IsEmpty() const { return seconds <= 0.0f; }
+        };
+
+        /**
+         * @brief Advance the world by a span of simulated seconds in one pass
+         *
+         * Seconds are world seconds, the same units ECSWorld::Update takes; the
+         * clock moves by TimeManager::hours_per_second per second at the current speed.
+         */
+        static Result Apply(ECSWorld& ecs_world, float seconds);
+
+        /**
+         * @brief Get the seconds to catch up on for a save, or 0 to skip catching up
+         *
+         * Nothing is owed when the clock was paused at save time or the save
+         * is stamped later than now; otherwise the time away is capped at the limit.
+         *
+         * @param saved_at Unix seconds when the save was written
+         * @param now Unix seconds now
+         * @param limit_seconds Longest span caught up on
+         * @param saved_clock Clock as it was saved
+         */
+        static float GetSpan(std::int64_t saved_at, std::int64_t now, float limit_seconds,
+                             const TimeManager& saved_clock);
+    };
+
+}
@@ -6,6 +6,7 @@
 #include <filesystem>
 #include <chrono>
 #include <nlohmann/json.hpp>
+#include "core/offline_catch_up.hpp"
 
 namespace towerforge::core {
    // Forward declarations
@@ -191,6 +192,28 @@ namespace towerforge::core {
    */
       bool IsAutosaveEnabled() const { return autosave_enabled_; }
 
+      /**
+   * @brief Enable/disable offline catch-up when a game is loaded
+   *
+   * When enabled, LoadGame advances the tower over the real time since the
+   * save was written (see OfflineCatchUp), up to the catch-up limit.
+   * @param enabled Whether loading should catch up on time away
+   */
+      void SetOfflineCatchUpEnabled(bool enabled) { offline_catch_up_enabled_ = enabled; }
+
+      bool IsOfflineCatchUpEnabled() const { return offline_catch_up_enabled_; }
+
+      /**
+   * @brief Set the longest time away caught up on load
+   * @param seconds Cap in seconds
+   */
+      void SetOfflineCatchUpLimit(const float seconds) { offline_catch_up_limit_ = seconds; }
+
+      /**
+   * @brief Get what the last load caught up on (empty if nothing was applied)
+   */
+      const OfflineCatchUp::Result &GetLastCatchUp() const { return last_catch_up_; }
+
       /**
    * @brief Set the achievement manager for persistence
    * @param manager Pointer to achievement manager
@@ -217,6 +240,9 @@ namespace towerforge::core {
       float time_since_last_save_;
       std::string last_save_slot_;
       AchievementManager *achievement_manager_; // Optional achievement manager for persistence
+      bool offline_catch_up_enabled_;
+      float offline_catch_up_limit_;            // Longest time away caught up on load, in seconds
+      OfflineCatchUp::Result last_catch_up_;
 
       static constexpr auto SAVE_FILE_EXTENSION = ".tfsave";
       static constexpr auto AUTOSAVE_SLOT_NAME = "_autosave";
@@ -7,6 +7,7 @@
 #include "ui/achievements_menu.h"
 #include "ui/hud/hud.h"
 #include <memory>
+#include <string>
 
 namespace towerforge::ui {
     class HUD;
@@ -30,6 +31,7 @@ namespace towerforge::core {
     class ECSWorld;
     class SaveLoadManager;
     class AchievementManager;
+    class SimulationFastForward;
 
     struct UIGameState;
 
@@ -58,6 +60,20 @@ namespace towerforge::core {
 
         ui::PopulationBreakdown CollectPopulationAnalytics() const;
 
+        ui::ElevatorAnalytics CollectElevatorAnalytics() const;
+
+        /**
+         * @brief Hand the world to the fast-forward worker until target_hours (TimeManager absolute hours)
+         */
+        void StartFastForward(double target_hours, const std::string &label);
+
+        /**
+         * @brief Join a finished fast-forward and report its throughput
+         */
+        void FinishFastForward();
+
+        void RenderFastForwardOverlay() const;
+
         audio::AudioManager *audio_manager_;
         AchievementManager *achievement_manager_;
 
@@ -74,6 +90,7 @@ namespace towerforge::core {
         std::unique_ptr<ui::PlacementSystem> placement_system_;
         std::unique_ptr<ui::HistoryPanel> history_panel_;
         std::unique_ptr<ui::HelpSystem> help_system_;
+        std::unique_ptr<SimulationFastForward> fast_forward_;
 
         // InGame state
         ui::GameState game_state_;
@@ -94,6 +111,8 @@ namespace towerforge::core {
         int cell_height_;
 
         bool game_initialized_;
+        bool evacuation_reported_;   // Time-to-clear notification shown for the current evacuation
+        std::string fast_forward_label_;  // Destination shown on the skip-to overlay
 
         // Timing
         float elapsed_time_;
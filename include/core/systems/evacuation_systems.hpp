@@ -0,0 +1,17 @@
+#pragma once
+
+#include <flecs.h>
+
+namespace towerforge::core::Systems {
+
+    class EvacuationSystems {
+    public:
+        static void RegisterAll(flecs::world& world);
+
+    private:
+        static void RegisterEvacuationControl(flecs::world& world);
+        static void RegisterEvacuationEnrollment(flecs::world& world);
+        static void RegisterEvacuationMovement(flecs::world& world);
+    };
+
+}
@@ -9,13 +9,22 @@ namespace towerforge::core::Systems {
         static void RegisterAll(flecs::world& world);
     
     private:
+        static void RegisterElevatorDispatchObservers(flecs::world& world);
+        static void RegisterShaftRouting(flecs::world& world);
+        static void RegisterFloorFlowFields(flecs::world& world);
+        static void RegisterCrowdDensity(flecs::world& world);
         static void RegisterPersonHorizontalMovement(flecs::world& world);
         static void RegisterPersonWaiting(flecs::world& world);
         static void RegisterPersonElevatorRiding(flecs::world& world);
+        static void RegisterPersonStairs(flecs::world& world);
         static void RegisterPersonStateLogging(flecs::world& world);
         static void RegisterElevatorCarMovement(flecs::world& world);
         static void RegisterElevatorCall(flecs::world& world);
+        static void RegisterElevatorDispatch(flecs::world& world);
         static void RegisterPersonElevatorBoarding(flecs::world& world);
+        static void RegisterHallQueueLayout(flecs::world& world);
+        static void RegisterElevatorTelemetry(flecs::world& world);
+        static void RegisterElevatorParking(flecs::world& world);
         static void RegisterElevatorLogging(flecs::world& world);
     };
 
@@ -9,6 +9,9 @@ namespace towerforge::core::Systems {
         static void RegisterAll(flecs::world& world);
     
     private:
+        static void RegisterJobBoardObservers(flecs::world& world);
+        static void RegisterFacilityIndexObservers(flecs::world& world);
+        static void RegisterSpawnerCounterObservers(flecs::world& world);
         static void RegisterResearchPointsGeneration(flecs::world& world);
         static void RegisterVisitorNeedsGrowth(flecs::world& world);
         static void RegisterVisitorNeedsBehavior(flecs::world& world);
@@ -22,6 +25,9 @@ namespace towerforge::core::Systems {
         static void RegisterVisitorSpawning(flecs::world& world);
         static void RegisterJobAssignment(flecs::world& world);
         static void RegisterVisitorCleanup(flecs::world& world);
+        static void RegisterCrowdAggregation(flecs::world& world);
+        static void RegisterCrowdCohortUpdate(flecs::world& world);
+        static void RegisterCrowdMaterialization(flecs::world& world);
     };
 
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <deque>
+#include <limits>
 #include <map>
 #include <vector>
 #include <optional>
@@ -28,12 +31,31 @@ namespace towerforge::core {
         GridCell() = default;
     };
 
+    /**
+ * @brief Entry in the TowerGrid change journal
+ * 
+ * Records a span of cells whose built or occupied state changed. Column
+ * changes alter every floor and are recorded with floor == ALL_FLOORS.
+ */
+    struct GridChange {
+        static constexpr int ALL_FLOORS = std::numeric_limits<int>::min();
+
+        std::uint64_t sequence;
+        int floor;
+        int column;
+        int width;
+    };
+
     /**
  * @brief 2D Grid system for tower structure
  * 
  * This grid manages the spatial layout of the tower, tracking floors (vertical)
  * and columns (horizontal). It supports placement and removal of facilities
  * and provides spatial query functions.
+ * 
+ * Every change to the layout is appended to a bounded change journal so
+ * derived caches (e.g. per-floor flow fields) can invalidate only the floors
+ * that changed since they last looked.
  */
     class TowerGrid {
     public:
@@ -331,6 +353,24 @@ namespace towerforge::core {
      */
         int GetBelowGroundFloorCount() const { return basement_floors_; }
 
+        // Change journal
+
+        static constexpr size_t JOURNAL_CAPACITY = 4096;
+
+        /**
+     * @brief Get the sequence number of the newest journal entry (0 before any change)
+     */
+        std::uint64_t GetChangeSequence() const { return change_sequence_; }
+
+        /**
+     * @brief Collect the journal entries recorded after a sequence number
+     * 
+     * @param sequence Last sequence the caller has seen
+     * @param changes Output list of newer entries, oldest first
+     * @return false if older entries were already dropped; the caller should treat every floor as changed
+     */
+        bool GetChangesSince(std::uint64_t sequence, std::vector<GridChange>& changes) const;
+
     private:
         int floors_;
         int columns_;
@@ -341,6 +381,14 @@ namespace towerforge::core {
         // Upgradeable dimension limits
         int max_above_ground_floors_;  // Current max above-ground floors (upgradeable)
         int max_below_ground_floors_;  // Current max below-ground floors (upgradeable)
+
+        std::deque<GridChange> journal_;
+        std::uint64_t change_sequence_ = 0;
+
+        /**
+     * @brief Append a layout change to the journal, dropping the oldest entry when full
+     */
+        void RecordChange(int floor, int column, int width);
     
         /**
      * @brief Ensure a floor exists in the grid map
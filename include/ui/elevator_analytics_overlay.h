@@ -14,8 +14,16 @@ namespace towerforge::ui {
     struct ElevatorAnalytics {
         struct ElevatorStats {
             int elevator_id;
+            int bottom_floor = 0;
+            int top_floor = 0;
+            int served_floor_count = 0; // Fewer than the floor range for express and zoned shafts
             int total_trips;
             float average_wait_time;
+            float p50_wait_time = 0.0f;
+            float p95_wait_time = 0.0f;
+            float p99_wait_time = 0.0f;
+            float average_ride_time = 0.0f;
+            float trips_per_hour = 0.0f;
             float utilization_rate; // Percentage of time elevator is occupied
             int total_passengers_carried;
             std::vector<std::pair<int, int> > floor_traffic; // floor, passenger count
@@ -24,6 +32,9 @@ namespace towerforge::ui {
         std::vector<ElevatorStats> elevators;
         int total_passengers = 0;
         float average_wait_time = 0.0f;
+        float p50_wait_time = 0.0f;
+        float p95_wait_time = 0.0f;
+        float p99_wait_time = 0.0f;
         int busiest_floor = 0;
         int busiest_floor_count = 0;
     };
@@ -33,8 +44,8 @@ namespace towerforge::ui {
      *
      * Standalone overlay class (not UIWindow-based).
      * Displays:
-     * - Overall statistics (total passengers, avg wait time, busiest floor)
-     * - Per-elevator performance (trips, passengers, utilization, wait time)
+     * - Overall statistics (total passengers, avg and p50/p95/p99 wait time, busiest floor)
+     * - Per-elevator performance (trips, passengers, utilization, wait and ride time)
      */
     class ElevatorAnalyticsOverlay {
     public:
@@ -264,6 +264,12 @@ namespace towerforge::ui {
 	 */
 		void SetPopulationAnalyticsCallback(std::function<PopulationBreakdown()> callback);
 
+		/**
+	 * @brief Set callback for collecting elevator analytics
+	 * @param callback Function to call when elevator analytics are needed
+	 */
+		void SetElevatorAnalyticsCallback(std::function<ElevatorAnalytics()> callback);
+
 		/**
 	 * @brief Request income analytics to be shown
 	 */
@@ -274,6 +280,11 @@ namespace towerforge::ui {
 	 */
 		void RequestPopulationAnalytics() const;
 
+		/**
+	 * @brief Request elevator analytics to be shown
+	 */
+		void RequestElevatorAnalytics() const;
+
 		/**
 		 * @brief Set callback for action bar button clicks
 		 * @param callback Function to call when action button is clicked
@@ -324,6 +335,7 @@ namespace towerforge::ui {
 		// Analytics callbacks
 		std::function<IncomeBreakdown()> income_analytics_callback_;
 		std::function<PopulationBreakdown()> population_analytics_callback_;
+		std::function<ElevatorAnalytics()> elevator_analytics_callback_;
 
 		// Analytics overlays (managed directly, not through window manager)
 		mutable std::unique_ptr<IncomeAnalyticsOverlay> income_overlay_;
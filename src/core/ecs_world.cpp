@@ -10,6 +10,7 @@
 #include "core/systems/visitor_employee_systems.hpp"
 #include "core/systems/facility_systems.hpp"
 #include "core/systems/staff_systems.hpp"
+#include "core/systems/evacuation_systems.hpp"
 #include <iostream>
 #include <set>
 
@@ -55,6 +56,18 @@ namespace towerforge::core {
         std::cout << "Initializing ECS World..." << std::endl;
     
         RegisterComponents();
+
+        // Derived indexes kept current by observers; must exist before any facility is placed
+        world_.set<JobBoard>({});
+        world_.set<FacilityTypeIndex>({});
+        world_.set<VisitorPool>({});
+        world_.set<CrowdSimulation>({});
+        world_.set<ShaftRoutingTable>({});
+        world_.set<ElevatorParkingPolicy>({});
+        world_.set<FloorFlowFields>(FloorFlowFields(tower_grid_.get()));
+        world_.set<CrowdDensity>(CrowdDensity(tower_grid_.get()));
+        world_.set<Evacuation>({});
+
         RegisterSystems();
     
         // Create facility manager after world is initialized
@@ -150,14 +163,29 @@ namespace towerforge::core {
         world_.component<TowerEconomy>();
         world_.component<ElevatorShaft>();
         world_.component<ElevatorCar>();
+        world_.component<ElevatorDispatcher>();
+        world_.component<ElevatorTelemetry>();
+        world_.component<ElevatorParkingPolicy>();
+        world_.component<ShaftRoutingTable>();
+        world_.component<TripItinerary>();
+        world_.component<FloorFlowFields>();
+        world_.component<CrowdDensity>();
+        world_.component<StairsConnector>();
+        world_.component<StairsTrip>();
+        world_.component<Evacuee>();
+        world_.component<Evacuation>();
         world_.component<PersonElevatorRequest>();
         world_.component<StaffAssignment>();
         world_.component<FacilityStatus>();
         world_.component<StaffManager>();
         world_.component<CleanlinessStatus>();
         world_.component<MaintenanceStatus>();
+        world_.component<JobBoard>();
+        world_.component<FacilityTypeIndex>();
+        world_.component<VisitorPool>();
+        world_.component<CrowdSimulation>();
     
-        std::cout << "  Registered components: Position, Velocity, Actor, Person, VisitorInfo, VisitorNeeds, EmploymentInfo, BuildingComponent, TimeManager, NPCSpawner, DailySchedule, GridPosition, Satisfaction, FacilityEconomics, TowerEconomy, ElevatorShaft, ElevatorCar, PersonElevatorRequest, StaffAssignment, FacilityStatus, StaffManager, CleanlinessStatus, MaintenanceStatus" << std::endl;
+        std::cout << "  Registered components: Position, Velocity, Actor, Person, VisitorInfo, VisitorNeeds, EmploymentInfo, BuildingComponent, JobBoard, FacilityTypeIndex, VisitorPool, CrowdSimulation, TimeManager, NPCSpawner, DailySchedule, GridPosition, Satisfaction, FacilityEconomics, TowerEconomy, ElevatorShaft, ElevatorCar, ElevatorDispatcher, ElevatorTelemetry, ElevatorParkingPolicy, ShaftRoutingTable, TripItinerary, FloorFlowFields, CrowdDensity, StairsConnector, StairsTrip, Evacuee, Evacuation, PersonElevatorRequest, StaffAssignment, FacilityStatus, StaffManager, CleanlinessStatus, MaintenanceStatus" << std::endl;
     }
 
     void ECSWorld::RegisterSystems() const {
@@ -168,8 +196,9 @@ namespace towerforge::core {
         Systems::VisitorEmployeeSystems::RegisterAll(world_);
         Systems::FacilitySystems::RegisterAll(world_);
         Systems::StaffSystems::RegisterAll(world_);
+        Systems::EvacuationSystems::RegisterAll(world_);
     
-        std::cout << "  Registered systems: Time Simulation, Schedule Execution, Movement, Actor Logging, Building Occupancy Monitor, Satisfaction Update, Satisfaction Reporting, Facility Economics, Daily Economy Processing, Revenue Collection, Economic Status Reporting, Person Horizontal Movement, Person Waiting, Person Elevator Riding, Person State Logging, Elevator Car Movement, Elevator Call, Person Elevator Boarding, Elevator Logging, Research Points Award, Visitor Needs Growth, Visitor Needs-Driven Behavior, Visitor Facility Interaction, Visitor Satisfaction Calculation, Visitor Behavior, Visitor Needs Display, Employee Shift Management, Employee Off-Duty Visitor, Job Opening Tracking, Visitor Spawning, Job Assignment, Visitor Cleanup, Facility Status Degradation, CleanlinessStatus Degradation, MaintenanceStatus Degradation, Maintenance Breakdown Notification, Cleanliness Notification, Staff Shift Management, Staff Cleaning, Staff Maintenance (FacilityStatus), Staff Maintenance (MaintenanceStatus), Staff Firefighting, Staff Security, Facility Status Impact, CleanlinessStatus Impact, Broken Facility Impact, Auto-Repair, Staff Manager Update, Staff Wages, Staff Status Reporting" << std::endl;
+        std::cout << "  Registered systems: Time Simulation, Schedule Execution, Movement, Actor Logging, Building Occupancy Monitor, Satisfaction Update, Satisfaction Reporting, Facility Economics, Daily Economy Processing, Revenue Collection, Economic Status Reporting, Person Horizontal Movement, Person Waiting, Person Elevator Riding, Person Stairs, Person State Logging, Elevator Dispatch Observers, Shaft Routing Table, Floor Flow Fields, Crowd Density, Elevator Car Movement, Elevator Call, Elevator Dispatch, Person Elevator Boarding, Hall Queue Layout, Elevator Telemetry, Elevator Parking, Elevator Logging, Job Board Observers, Facility Type Index Observers, Spawner Counter Observers, Research Points Award, Visitor Needs Growth, Visitor Needs-Driven Behavior, Visitor Facility Interaction, Visitor Satisfaction Calculation, Visitor Behavior, Visitor Needs Display, Employee Shift Management, Employee Off-Duty Visitor, Job Opening Tracking, Visitor Spawning, Job Assignment, Visitor Cleanup, Crowd Aggregation, Crowd Cohort Update, Crowd Materialization, Facility Status Degradation, CleanlinessStatus Degradation, MaintenanceStatus Degradation, Maintenance Breakdown Notification, Cleanliness Notification, Staff Shift Management, Staff Cleaning, Staff Maintenance (FacilityStatus), Staff Maintenance (MaintenanceStatus), Staff Firefighting, Staff Security, Facility Status Impact, CleanlinessStatus Impact, Broken Facility Impact, Auto-Repair, Staff Manager Update, Staff Wages, Staff Status Reporting, Evacuation Control, Evacuation Enrollment, Evacuation Movement" << std::endl;
     }
 
 
@@ -0,0 +1,110 @@
+#include "core/components.hpp"
+#include "core/tower_grid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace towerforge::core {
+
+    void EvacuationField::Build(const TowerGrid& grid, const std::vector<StairsConnector>& stairwells,
+                                const std::vector<int>& exit_columns, const float walk_speed,
+                                const float facility_cell_cost) {
+        constexpr float unreachable = std::numeric_limits<float>::infinity();
+
+        min_floor = grid.GetLowestFloorIndex();
+        floor_count = grid.GetHighestFloorIndex() - min_floor + 1;
+        columns = grid.GetColumnCount();
+        const int cells = floor_count * columns;
+        cell_costs.assign(cells, unreachable);
+        cost.assign(cells, unreachable);
+        step.assign(cells, Step::None);
+        waypoint.assign(cells, -1);
+        stairs_seconds.assign(cells, 0.0f);
+        exit_count = 0;
+        stairwell_count = 0;
+
+        // Seconds to walk across each cell, and to leave it by stairwell in either direction
+        std::vector<float> crossing(cells, unreachable);
+        for (int floor = min_floor; floor < min_floor + floor_count; ++floor) {
+            for (int column = 0; column < columns; ++column) {
+                if (!grid.IsFloorBuilt(floor, column)) continue;
+                const int cell = GetIndex(floor, column);
+                cell_costs[cell] = grid.IsOccupied(floor, column) ? facility_cell_cost : 1.0f;
+                crossing[cell] = cell_costs[cell] / walk_speed;
+            }
+        }
+        std::vector<float> up_seconds(cells, unreachable);
+        std::vector<float> down_seconds(cells, unreachable);
+        for (const StairsConnector& stairwell : stairwells) {
+            const int lower = GetIndex(stairwell.bottom_floor, stairwell.column);
+            const int upper = GetIndex(stairwell.bottom_floor + 1, stairwell.column);
+            if (lower < 0 || upper < 0 || std::isinf(crossing[lower]) || std::isinf(crossing[upper])) continue;
+            up_seconds[lower] = std::min(up_seconds[lower], stairwell.seconds_per_floor);
+            down_seconds[upper] = std::min(down_seconds[upper], stairwell.seconds_per_floor);
+            stairwell_count++;
+        }
+
+        using Entry = std::pair<float, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> frontier;
+        const int ground_floor = grid.GetGroundFloorIndex();
+        for (const int column : exit_columns) {
+            const int cell = GetIndex(ground_floor, column);
+            if (cell < 0 || std::isinf(crossing[cell]) || step[cell] == Step::Exit) continue;
+            cost[cell] = 0.0f;
+            step[cell] = Step::Exit;
+            frontier.push({0.0f, cell});
+            exit_count++;
+        }
+
+        // Offer a cell a way out through a neighbour; costs are seconds to get out
+        const auto relax = [&](const int cell, const float reached, const Step how, const float seconds) {
+            if (reached >= cost[cell]) return;
+            cost[cell] = reached;
+            step[cell] = how;
+            stairs_seconds[cell] = seconds;
+            frontier.push({reached, cell});
+        };
+
+        while (!frontier.empty()) {
+            const auto [reached, cell] = frontier.top();
+            frontier.pop();
+            if (reached > cost[cell]) continue;
+
+            const int column = cell % columns;
+            if (column > 0 && !std::isinf(crossing[cell - 1])) {
+                relax(cell - 1, reached + crossing[cell - 1], Step::Right, 0.0f);
+            }
+            if (column + 1 < columns && !std::isinf(crossing[cell + 1])) {
+                relax(cell + 1, reached + crossing[cell + 1], Step::Left, 0.0f);
+            }
+            if (cell + columns < cells && !std::isinf(down_seconds[cell + columns])) {
+                relax(cell + columns, reached + down_seconds[cell + columns], Step::Down, down_seconds[cell + columns]);
+            }
+            if (cell - columns >= 0 && !std::isinf(up_seconds[cell - columns])) {
+                relax(cell - columns, reached + up_seconds[cell - columns], Step::Up, up_seconds[cell - columns]);
+            }
+        }
+
+        // A run of Left (Right) steps ends at the first cell that doesn't step the same way
+        for (int row = 0; row < floor_count; ++row) {
+            const int first = row * columns;
+            for (int column = 0; column < columns; ++column) {
+                const int cell = first + column;
+                if (step[cell] != Step::Left) {
+                    waypoint[cell] = column;
+                } else {
+                    waypoint[cell] = step[cell - 1] == Step::Left ? waypoint[cell - 1] : column - 1;
+                }
+            }
+            for (int column = columns - 1; column >= 0; --column) {
+                const int cell = first + column;
+                if (step[cell] == Step::Right) {
+                    waypoint[cell] = step[cell + 1] == Step::Right ? waypoint[cell + 1] : column + 1;
+                }
+            }
+        }
+    }
+
+}
@@ -87,6 +87,9 @@ namespace towerforge::core {
             case BuildingComponent::Type::Theater:
                 maintenance.degrade_rate = 1.5f;  // Entertainment venues with equipment
                 break;
+            case BuildingComponent::Type::Escalator:
+                maintenance.degrade_rate = 1.5f;  // Escalators have moving parts too
+                break;
             case BuildingComponent::Type::Restaurant:
             case BuildingComponent::Type::Hotel:
             case BuildingComponent::Type::Gym:
@@ -103,6 +106,13 @@ namespace towerforge::core {
         }
         facility.set<MaintenanceStatus>(maintenance);
     
+        // Stairs and escalators link this floor to the one above for short trips
+        if (type == BuildingComponent::Type::Stairs) {
+            facility.set<StairsConnector>({floor, column + width / 2, 5.0f});
+        } else if (type == BuildingComponent::Type::Escalator) {
+            facility.set<StairsConnector>({floor, column + width / 2, 3.0f});
+        }
+    
         // Place on the grid using the entity ID
         if (!grid_.PlaceFacility(floor, column, width, static_cast<int>(facility.id()))) {
             // If placement fails, destroy the entity and return null
@@ -193,6 +203,10 @@ namespace towerforge::core {
                 return 8;  // Management offices are medium-sized
             case BuildingComponent::Type::SatelliteOffice:
                 return 6;  // Satellite offices are smaller
+            case BuildingComponent::Type::Stairs:
+                return 2;  // Stairs are narrow
+            case BuildingComponent::Type::Escalator:
+                return 3;  // Escalators need a landing at each end
             default:
                 return 4;
         }
@@ -228,6 +242,10 @@ namespace towerforge::core {
                 return 10;  // Management office capacity
             case BuildingComponent::Type::SatelliteOffice:
                 return 6;   // Satellite office capacity
+            case BuildingComponent::Type::Stairs:
+                return 10;  // Stairs hold a handful of people at once
+            case BuildingComponent::Type::Escalator:
+                return 20;  // Escalators move a steady stream of people
             default:
                 return 10;
         }
@@ -263,6 +281,10 @@ namespace towerforge::core {
                 return "ManagementOffice";
             case BuildingComponent::Type::SatelliteOffice:
                 return "SatelliteOffice";
+            case BuildingComponent::Type::Stairs:
+                return "Stairs";
+            case BuildingComponent::Type::Escalator:
+                return "Escalator";
             default:
                 return "Unknown";
         }
@@ -299,6 +321,10 @@ namespace towerforge::core {
                 return 0x2C3E50;  // DARK SLATE (executive/professional)
             case BuildingComponent::Type::SatelliteOffice:
                 return 0x34495E;  // LIGHTER SLATE
+            case BuildingComponent::Type::Stairs:
+                return 0xA0785A;  // BROWN
+            case BuildingComponent::Type::Escalator:
+                return 0xB4B4B4;  // LIGHT GRAY
             default:
                 return 0x66BFFF;  // Default to SKYBLUE
         }
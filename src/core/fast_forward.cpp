@@ -0,0 +1,100 @@
+#include "core/fast_forward.hpp"
+#include "core/ecs_world.hpp"
+#include "core/components.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace towerforge::core {
+
+    SimulationFastForward::~SimulationFastForward() {
+        Cancel();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    double SimulationFastForward::GetNextTimeOfDay(const TimeManager& time, const float hour) {
+        const double now = time.GetAbsoluteHours();
+        double target = std::floor(now / 24.0) * 24.0 + hour;
+        if (target <= now) {
+            target += 24.0;
+        }
+        return target;
+    }
+
+    double SimulationFastForward::GetNextDayOfWeek(const TimeManager& time, const int day, const float hour) {
+        const double now = time.GetAbsoluteHours();
+        const int days_ahead = ((day - time.current_day) % 7 + 7) % 7;
+        double target = (static_cast<double>(time.current_week) * 7 + time.current_day + days_ahead) * 24 + hour;
+        if (target <= now) {
+            target += 7 * 24.0;
+        }
+        return target;
+    }
+
+    SimulationFastForward::Result SimulationFastForward::Run(ECSWorld& ecs_world, const double target_hours,
+                                                             const float step_seconds, const int max_steps,
+                                                             const std::atomic<bool>* cancel,
+                                                             std::atomic<float>* progress) {
+        Result result;
+        const flecs::world& world = ecs_world.GetWorld();
+        const double start_hours = world.get<TimeManager>().GetAbsoluteHours();
+        const double span = target_hours - start_hours;
+        double now = start_hours;
+
+        const auto wall_start = std::chrono::steady_clock::now();
+        while (now < target_hours && result.steps < max_steps) {
+            if (cancel != nullptr && cancel->load(std::memory_order_relaxed)) {
+                break;
+            }
+            if (!ecs_world.Update(step_seconds)) {
+                break;
+            }
+            result.steps++;
+            now = world.get<TimeManager>().GetAbsoluteHours();
+            if (progress != nullptr && span > 0.0) {
+                progress->store(static_cast<float>(std::clamp((now - start_hours) / span, 0.0, 1.0)),
+                                std::memory_order_relaxed);
+            }
+        }
+        const auto wall_end = std::chrono::steady_clock::now();
+
+        result.reached_target = now >= target_hours;
+        result.sim_hours = now - start_hours;
+        result.wall_seconds = std::chrono::duration<double>(wall_end - wall_start).count();
+        return result;
+    }
+
+    bool SimulationFastForward::Start(ECSWorld& ecs_world, const double target_hours, const float step_seconds,
+                                      const int max_steps) {
+        if (worker_.joinable()) {
+            return false;
+        }
+        if (target_hours <= ecs_world.GetWorld().get<TimeManager>().GetAbsoluteHours()) {
+            return false;
+        }
+
+        cancel_.store(false);
+        done_.store(false);
+        progress_.store(0.0f);
+        result_ = Result{};
+        worker_ = std::thread([this, &ecs_world, target_hours, step_seconds, max_steps] {
+            result_ = Run(ecs_world, target_hours, step_seconds, max_steps, &cancel_, &progress_);
+            done_.store(true);
+        });
+        return true;
+    }
+
+    void SimulationFastForward::Cancel() {
+        cancel_.store(true);
+    }
+
+    SimulationFastForward::Result SimulationFastForward::Finish() {
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+        return result_;
+    }
+
+}
@@ -0,0 +1,96 @@
+#include "core/components.hpp"
+#include "core/tower_grid.hpp"
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace towerforge::core {
+
+    void FloorFlowFields::Sync() {
+        assert(grid != nullptr && "FloorFlowFields needs the tower grid before it is synced");
+        if (grid->GetChangeSequence() == synced_sequence) return;
+
+        std::vector<GridChange> changes;
+        if (!grid->GetChangesSince(synced_sequence, changes)) {
+            floors_invalidated += static_cast<int>(floors.size());
+            floors.clear();
+        } else {
+            for (const GridChange& change : changes) {
+                if (change.floor == GridChange::ALL_FLOORS) {
+                    floors_invalidated += static_cast<int>(floors.size());
+                    floors.clear();
+                    break;
+                }
+                floors_invalidated += static_cast<int>(floors.erase(change.floor));
+            }
+        }
+        synced_sequence = grid->GetChangeSequence();
+    }
+
+    float FloorFlowFields::GetCellCost(const int floor, const int column) {
+        const FloorCache& cache = GetFloor(floor);
+        if (column < 0 || column >= static_cast<int>(cache.cell_costs.size())) {
+            return std::numeric_limits<float>::infinity();
+        }
+        return cache.cell_costs[column];
+    }
+
+    const FloorFlowFields::Field* FloorFlowFields::GetField(const int floor, const int target_column) {
+        FloorCache& cache = GetFloor(floor);
+        const int columns = static_cast<int>(cache.cell_costs.size());
+        if (target_column < 0 || target_column >= columns || std::isinf(cache.cell_costs[target_column])) {
+            return nullptr;
+        }
+
+        const auto existing = cache.fields.find(target_column);
+        if (existing != cache.fields.end()) return &existing->second;
+
+        // A floor is a single row, so the field is two sweeps outward from the target that stop at gaps
+        Field field;
+        field.cost.assign(columns, std::numeric_limits<float>::infinity());
+        field.step.assign(columns, 0);
+        field.cost[target_column] = 0.0f;
+        for (int column = target_column - 1; column >= 0 && !std::isinf(cache.cell_costs[column]); --column) {
+            field.cost[column] = field.cost[column + 1] + cache.cell_costs[column];
+            field.step[column] = 1;
+        }
+        for (int column = target_column + 1; column < columns && !std::isinf(cache.cell_costs[column]); ++column) {
+            field.cost[column] = field.cost[column - 1] + cache.cell_costs[column];
+            field.step[column] = -1;
+        }
+        fields_built++;
+        return &cache.fields.emplace(target_column, std::move(field)).first->second;
+    }
+
+    int FloorFlowFields::GetReachableColumn(const int floor, const int from_column, const int target_column) {
+        const FloorCache& cache = GetFloor(floor);
+        const int columns = static_cast<int>(cache.cell_costs.size());
+        const int direction = target_column > from_column ? 1 : -1;
+        int column = from_column;
+        while (column != target_column) {
+            const int next = column + direction;
+            if (next < 0 || next >= columns || std::isinf(cache.cell_costs[next])) break;
+            column = next;
+        }
+        return column;
+    }
+
+    FloorFlowFields::FloorCache& FloorFlowFields::GetFloor(const int floor) {
+        const auto existing = floors.find(floor);
+        if (existing != floors.end()) return existing->second;
+
+        assert(grid != nullptr && "FloorFlowFields needs the tower grid before fields are built");
+        FloorCache cache;
+        const int columns = grid->GetColumnCount();
+        cache.cell_costs.resize(columns);
+        for (int column = 0; column < columns; ++column) {
+            if (!grid->IsFloorBuilt(floor, column)) {
+                cache.cell_costs[column] = std::numeric_limits<float>::infinity();
+            } else {
+                cache.cell_costs[column] = grid->IsOccupied(floor, column) ? facility_cell_cost : 1.0f;
+            }
+        }
+        return floors.emplace(floor, std::move(cache)).first->second;
+    }
+
+}
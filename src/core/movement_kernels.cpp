@@ -0,0 +1,119 @@
+#include "core/movement_kernels.hpp"
+#include <cmath>
+
+#if defined(TOWERFORGE_ENABLE_AVX2) && defined(__AVX2__)
+#define TOWERFORGE_KERNEL_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TOWERFORGE_KERNEL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace towerforge::core::kernels {
+
+    namespace {
+
+        std::size_t AdvanceTail(float* positions, const float* targets, const float* steps,
+                                std::uint8_t* arrived, const std::size_t begin, const std::size_t count) {
+            std::size_t arrivals = 0;
+            for (std::size_t i = begin; i < count; ++i) {
+                const float delta = targets[i] - positions[i];
+                if (steps[i] >= std::abs(delta)) {
+                    positions[i] = targets[i];
+                    arrived[i] = 1;
+                    arrivals++;
+                } else {
+                    positions[i] += delta > 0.0f ? steps[i] : -steps[i];
+                    arrived[i] = 0;
+                }
+            }
+            return arrivals;
+        }
+
+    }
+
+    std::size_t AdvanceTowardScalar(float* positions, const float* targets, const float* steps,
+                                    std::uint8_t* arrived, const std::size_t count) {
+        return AdvanceTail(positions, targets, steps, arrived, 0, count);
+    }
+
+#if defined(TOWERFORGE_KERNEL_AVX2)
+
+    std::size_t AdvanceToward(float* positions, const float* targets, const float* steps,
+                              std::uint8_t* arrived, const std::size_t count) {
+        const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+        std::size_t arrivals = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256 position = _mm256_loadu_ps(positions + i);
+            const __m256 target = _mm256_loadu_ps(targets + i);
+            const __m256 step = _mm256_loadu_ps(steps + i);
+
+            // Step toward the target (copysign), or land on it when the step covers the distance
+            const __m256 delta = _mm256_sub_ps(target, position);
+            const __m256 distance = _mm256_andnot_ps(sign_mask, delta);
+            const __m256 done = _mm256_cmp_ps(step, distance, _CMP_GE_OQ);
+            const __m256 moved = _mm256_add_ps(position, _mm256_or_ps(step, _mm256_and_ps(delta, sign_mask)));
+            _mm256_storeu_ps(positions + i, _mm256_blendv_ps(moved, target, done));
+
+            const int mask = _mm256_movemask_ps(done);
+            for (int lane = 0; lane < 8; ++lane) {
+                const auto flag = static_cast<std::uint8_t>((mask >> lane) & 1);
+                arrived[i + lane] = flag;
+                arrivals += flag;
+            }
+        }
+        return arrivals + AdvanceTail(positions, targets, steps, arrived, i, count);
+    }
+
+    const char* GetKernelName() {
+        return "AVX2";
+    }
+
+#elif defined(TOWERFORGE_KERNEL_SSE2)
+
+    std::size_t AdvanceToward(float* positions, const float* targets, const float* steps,
+                              std::uint8_t* arrived, const std::size_t count) {
+        const __m128 sign_mask = _mm_set1_ps(-0.0f);
+        std::size_t arrivals = 0;
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m128 position = _mm_loadu_ps(positions + i);
+            const __m128 target = _mm_loadu_ps(targets + i);
+            const __m128 step = _mm_loadu_ps(steps + i);
+
+            // Step toward the target (copysign), or land on it when the step covers the distance
+            const __m128 delta = _mm_sub_ps(target, position);
+            const __m128 distance = _mm_andnot_ps(sign_mask, delta);
+            const __m128 done = _mm_cmpge_ps(step, distance);
+            const __m128 moved = _mm_add_ps(position, _mm_or_ps(step, _mm_and_ps(delta, sign_mask)));
+            _mm_storeu_ps(positions + i, _mm_or_ps(_mm_and_ps(done, target), _mm_andnot_ps(done, moved)));
+
+            const int mask = _mm_movemask_ps(done);
+            for (int lane = 0; lane < 4; ++lane) {
+                const auto flag = static_cast<std::uint8_t>((mask >> lane) & 1);
+                arrived[i + lane] = flag;
+                arrivals += flag;
+            }
+        }
+        return arrivals + AdvanceTail(positions, targets, steps, arrived, i, count);
+    }
+
+    const char* GetKernelName() {
+        return "SSE2";
+    }
+
+#else
+
+    std::size_t AdvanceToward(float* positions, const float* targets, const float* steps,
+                              std::uint8_t* arrived, const std::size_t count) {
+        return AdvanceTowardScalar(positions, targets, steps, arrived, count);
+    }
+
+    const char* GetKernelName() {
+        return "Scalar";
+    }
+
+#endif
+
+}
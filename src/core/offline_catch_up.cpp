@@ -0,0 +1,168 @@
+#include "core/offline_catch_up.hpp"
+#include "core/ecs_world.hpp"
+#include "core/components.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace towerforge::core {
+
+    namespace {
+
+        // Whether a shift is on duty at any point in [start_hour, start_hour + hours)
+        bool ShiftOverlaps(const StaffAssignment& assignment, const double start_hour, const double hours) {
+            if (hours >= 24.0) return true;
+            const float hour = static_cast<float>(std::fmod(start_hour, 24.0));
+            if (assignment.ShouldBeWorking(hour)) return true;
+            const double until_shift = std::fmod(assignment.shift_start_time - hour + 24.0, 24.0);
+            return until_shift < hours;
+        }
+
+        // Same coverage test the staff systems use
+        bool Covers(const StaffAssignment& assignment, const flecs::entity facility_entity,
+                    const BuildingComponent& facility) {
+            return assignment.assigned_facility_entity == static_cast<int>(facility_entity.id()) ||
+                   assignment.assigned_floor == -1 || assignment.assigned_floor == facility.floor;
+        }
+
+    }
+
+    OfflineCatchUp::Result OfflineCatchUp::Apply(ECSWorld& ecs_world, const float seconds) {
+        Result result;
+        flecs::world& world = ecs_world.GetWorld();
+        if (seconds <= 0.0f || (world.has<TimeManager>() && world.get<TimeManager>().simulation_speed <= 0.0f)) {
+            return result;
+        }
+        result.seconds = seconds;
+        const float frame_step_seconds = seconds / frame_step_period;
+
+        // Staff who are on shift at some point in the span
+        const double start_hours = world.has<TimeManager>() ? world.get<TimeManager>().GetAbsoluteHours() : 0.0;
+        const double span_hours = world.has<TimeManager>()
+                                      ? static_cast<double>(seconds) * world.get<TimeManager>().hours_per_second *
+                                        world.get<TimeManager>().simulation_speed
+                                      : 0.0;
+        std::vector<StaffAssignment> cleaners;
+        std::vector<StaffAssignment> maintainers;
+        world.each([&](const StaffAssignment& assignment) {
+            if (!ShiftOverlaps(assignment, start_hours, span_hours)) return;
+            if (assignment.DoesCleaningWork()) cleaners.push_back(assignment);
+            if (assignment.DoesMaintenanceWork()) maintainers.push_back(assignment);
+        });
+
+        // One pass per facility: degradation, staff servicing, tenant churn and rent, management staffing
+        int management_staff_count = 0;
+        world.each([&](const flecs::entity e, const BuildingComponent& facility) {
+            const float occupancy_rate = static_cast<float>(facility.current_occupancy) /
+                                         std::max(1, facility.capacity);
+            const auto cleaner = std::find_if(cleaners.begin(), cleaners.end(), [&](const StaffAssignment& a) {
+                return Covers(a, e, facility);
+            });
+            const auto maintainer = std::find_if(maintainers.begin(), maintainers.end(), [&](const StaffAssignment& a) {
+                return Covers(a, e, facility);
+            });
+
+            if (e.has<FacilityStatus>()) {
+                auto& status = e.get_mut<FacilityStatus>();
+                status.Update(frame_step_seconds, facility.current_occupancy);
+                while (cleaner != cleaners.end() && cleaner->work_efficiency > 0.0f && status.NeedsCleaning()) {
+                    status.Clean(cleaner->work_efficiency);
+                }
+                while (maintainer != maintainers.end() && maintainer->work_efficiency > 0.0f &&
+                       status.NeedsMaintenance()) {
+                    status.Maintain(maintainer->work_efficiency);
+                }
+            }
+            if (e.has<CleanlinessStatus>()) {
+                auto& cleanliness = e.get_mut<CleanlinessStatus>();
+                cleanliness.Update(frame_step_seconds, 1.0f + occupancy_rate * 2.0f);
+                if (cleaner != cleaners.end() && cleanliness.NeedsCleaning()) cleanliness.Clean();
+            }
+            if (e.has<MaintenanceStatus>()) {
+                auto& maintenance = e.get_mut<MaintenanceStatus>();
+                maintenance.Update(frame_step_seconds, 1.0f + occupancy_rate * 1.5f);
+                if (maintainer != maintainers.end() && maintenance.NeedsService()) maintenance.Repair();
+            }
+            if (e.has<FacilityEconomics>()) {
+                auto& economics = e.get_mut<FacilityEconomics>();
+                if (e.has<Satisfaction>()) {
+                    result.revenue += economics.CatchUp(seconds, e.get<Satisfaction>().satisfaction_score,
+                                                        facility.current_occupancy < facility.capacity);
+                } else {
+                    result.revenue += economics.CalculateDailyRevenue() * seconds / (24.0f * 3600.0f);
+                }
+                result.expenses += economics.operating_cost * seconds / (24.0f * 3600.0f);
+            }
+            if (facility.IsManagementFacility()) {
+                management_staff_count += facility.current_staff;
+            }
+            result.facilities++;
+        });
+
+        if (world.has<ResearchTree>()) {
+            auto& research = world.get_mut<ResearchTree>();
+            const int points_before = research.total_points_earned;
+            research.UpdateManagementStaffCount(management_staff_count);
+            research.GenerateTowerPoints(frame_step_seconds / 3600.0f);
+            result.research_points = research.total_points_earned - points_before;
+        }
+
+        // Needs growth is closed-form; each visitor's clock stays on world time
+        world.each([&](VisitorNeeds& needs) {
+            needs.Grow(seconds);
+            result.visitors++;
+        });
+
+        if (world.has<CrowdSimulation>()) {
+            auto& crowd = world.get_mut<CrowdSimulation>();
+            for (size_t slot = 0; slot < crowd.cohorts.size();) {
+                CrowdCohort& cohort = crowd.cohorts[slot];
+                const float departures = cohort.CatchUp(seconds);
+                result.cohort_departures += departures;
+                crowd.total_members -= departures;
+                crowd.total_departed += departures;
+
+                if (cohort.count < 0.5f) {
+                    crowd.total_members -= cohort.count;
+                    crowd.RemoveCohort(slot);
+                    continue;
+                }
+                ++slot;
+            }
+            crowd.total_members = std::max(0.0f, crowd.total_members);
+        }
+
+        // Move the clock and book the span against the day boundaries it crossed
+        if (world.has<TimeManager>()) {
+            auto& time_mgr = world.get_mut<TimeManager>();
+            result.sim_hours = span_hours;
+            const double end_hours = start_hours + result.sim_hours;
+            time_mgr.SetAbsoluteHours(end_hours);
+
+            const double end_day_start = std::floor(end_hours / 24.0) * 24.0;
+            result.days_closed = static_cast<int>(end_day_start / 24.0 - std::floor(start_hours / 24.0));
+
+            if (world.has<TowerEconomy>()) {
+                auto& economy = world.get_mut<TowerEconomy>();
+                const float open_day_share = result.sim_hours > 0.0
+                                                 ? static_cast<float>((end_hours - end_day_start) / result.sim_hours)
+                                                 : 1.0f;
+                economy.AccrueSpan(result.revenue, result.expenses, result.days_closed, open_day_share);
+                economy.last_processed_day = time_mgr.current_week * 7 + time_mgr.current_day;
+            }
+        } else if (world.has<TowerEconomy>()) {
+            world.get_mut<TowerEconomy>().AccrueSpan(result.revenue, result.expenses, 0, 1.0f);
+        }
+
+        return result;
+    }
+
+    float OfflineCatchUp::GetSpan(const std::int64_t saved_at, const std::int64_t now, const float limit_seconds,
+                                  const TimeManager& saved_clock) {
+        if (saved_clock.simulation_speed <= 0.0f || now <= saved_at) {
+            return 0.0f;
+        }
+        return static_cast<float>(std::min<std::int64_t>(now - saved_at, static_cast<std::int64_t>(limit_seconds)));
+    }
+
+}
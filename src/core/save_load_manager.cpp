@@ -4,6 +4,7 @@
 #include "core/tower_grid.hpp"
 #include "core/facility_manager.hpp"
 #include "core/achievement_manager.hpp"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -15,7 +16,9 @@ namespace towerforge::core {
         : autosave_enabled_(true),
           autosave_interval_(120.0f),  // Default: 2 minutes
           time_since_last_save_(0.0f),
-          achievement_manager_(nullptr) {
+          achievement_manager_(nullptr),
+          offline_catch_up_enabled_(false),
+          offline_catch_up_limit_(8.0f * 3600.0f) {  // Default: 8 hours
     }
 
     SaveLoadManager::~SaveLoadManager() {
@@ -133,6 +136,31 @@ namespace towerforge::core {
                 return SaveLoadResult::Failure(SaveLoadError::CorruptFile,
                                                "Failed to load game state - file may be corrupt");
             }
+
+            // Catch up on the time since the save was written, while facilities still hold their saved
+            // occupancy; a tower saved while paused owes nothing
+            last_catch_up_ = OfflineCatchUp::Result{};
+            flecs::world& world = ecs_world.GetWorld();
+            if (offline_catch_up_enabled_ && world.has<TimeManager>() &&
+                json.contains("metadata") && json["metadata"].contains("saved_at")) {
+                const auto saved_at = json["metadata"]["saved_at"].get<std::int64_t>();
+                const auto now = std::chrono::duration_cast<std::chrono::seconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                const float away = OfflineCatchUp::GetSpan(saved_at, now, offline_catch_up_limit_,
+                                                           world.get<TimeManager>());
+                if (away > 0.0f) {
+                    last_catch_up_ = OfflineCatchUp::Apply(ecs_world, away);
+                    std::cout << "Caught up on " << away << " s away: $" << last_catch_up_.revenue << " revenue, $"
+                            << last_catch_up_.expenses << " expenses, " << last_catch_up_.research_points
+                            << " tower points" << std::endl;
+                }
+            }
+
+            // Visitors aren't saved, so nobody is inside or holding a place once the load is done
+            world.each([](BuildingComponent& building) {
+                building.current_occupancy = 0;
+                building.reserved_slots = 0;
+            });
         
             std::cout << "Game loaded from: " << file_path << std::endl;
             return SaveLoadResult::Success();
@@ -308,6 +336,7 @@ namespace towerforge::core {
         json["metadata"] = {
             {"game_version", GAME_VERSION},
             {"save_date", ss.str()},
+            {"saved_at", std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count()},
             {"tower_name", tower_name}
         };
     
@@ -487,6 +516,19 @@ namespace towerforge::core {
                     {"top_floor", shaft.top_floor},
                     {"car_count", shaft.car_count}
                 };
+                if (shaft.served_floors.Any()) {
+                    entity["elevator_shaft"]["served_floors"] = shaft.served_floors.ToVector();
+                }
+            }
+        
+            // StairsConnector component
+            if (e.has<StairsConnector>()) {
+                const auto& connector = e.get<StairsConnector>();
+                entity["stairs_connector"] = {
+                    {"bottom_floor", connector.bottom_floor},
+                    {"column", connector.column},
+                    {"seconds_per_floor", connector.seconds_per_floor}
+                };
             }
         
             // ElevatorCar component
@@ -499,8 +541,9 @@ namespace towerforge::core {
                     {"state", static_cast<int>(car.state)},
                     {"max_capacity", car.max_capacity},
                     {"current_occupancy", car.current_occupancy},
-                    {"stop_queue", car.stop_queue},
-                    {"passenger_destinations", car.passenger_destinations},
+                    {"up_stops", car.up_stops.ToVector()},
+                    {"down_stops", car.down_stops.ToVector()},
+                    {"travel_direction", car.travel_direction},
                     {"state_timer", car.state_timer},
                     {"door_open_duration", car.door_open_duration},
                     {"door_transition_duration", car.door_transition_duration},
@@ -574,12 +617,29 @@ namespace towerforge::core {
         
             world.each([](const flecs::entity e) {
                 // Skip singleton components
-                if (!e.has<TimeManager>() && !e.has<TowerEconomy>() && !e.has<ResearchTree>()) {
+                if (!e.has<TimeManager>() && !e.has<TowerEconomy>() && !e.has<ResearchTree>() &&
+                    !e.has<JobBoard>() && !e.has<FacilityTypeIndex>() && !e.has<VisitorPool>() &&
+                    !e.has<CrowdSimulation>() && !e.has<ShaftRoutingTable>() &&
+                    !e.has<ElevatorParkingPolicy>() && !e.has<FloorFlowFields>() &&
+                    !e.has<CrowdDensity>() && !e.has<Evacuation>()) {
                     e.destruct();
                 }
             });
         
             world.defer_end();
+
+            // Cohorts belonged to the previous tower's visitors
+            if (world.has<CrowdSimulation>()) {
+                auto& crowd = world.get_mut<CrowdSimulation>();
+                crowd.cohorts.clear();
+                crowd.cohort_index.clear();
+                crowd.total_members = 0.0f;
+            }
+
+            // Evacuations aren't saved; a loaded tower is never mid-evacuation
+            if (world.has<Evacuation>()) {
+                world.get_mut<Evacuation>() = Evacuation();
+            }
         
             // Deserialize TimeManager
             if (json.contains("time")) {
@@ -714,6 +774,12 @@ namespace towerforge::core {
                         person.move_speed = person_json.value("move_speed", 2.0f);
                         person.wait_time = person_json.value("wait_time", 0.0f);
                         person.current_need = person_json.value("current_need", "Idle");
+                        if (person.state == PersonState::Evacuating) {
+                            // Saved mid-evacuation: stand the person down where they were
+                            person.state = PersonState::AtDestination;
+                            person.destination_floor = person.current_floor;
+                            person.destination_column = person.current_column;
+                        }
                         e.set<Person>(person);
                     }
                 
@@ -726,7 +792,9 @@ namespace towerforge::core {
                         building.column = building_json.value("column", 0);
                         building.width = building_json.value("width", 1);
                         building.capacity = building_json.value("capacity", 10);
-                        building.current_occupancy = building_json.value("current_occupancy", 0);
+                        // Kept for the offline catch-up; LoadGame empties the facility afterwards
+                        building.current_occupancy = std::clamp(building_json.value("current_occupancy", 0),
+                                                                0, building.capacity);
                         e.set<BuildingComponent>(building);
                         
                         // Build floor if needed and place facility on grid
@@ -775,11 +843,25 @@ namespace towerforge::core {
                     // ElevatorShaft
                     if (entity_json.contains("elevator_shaft")) {
                         auto& shaft_json = entity_json["elevator_shaft"];
-                        e.set<ElevatorShaft>({
+                        ElevatorShaft shaft(
                             shaft_json.value("column", 0),
                             shaft_json.value("bottom_floor", 0),
                             shaft_json.value("top_floor", 0),
                             shaft_json.value("car_count", 1)
+                        );
+                        if (shaft_json.contains("served_floors")) {
+                            shaft.SetServedFloors(shaft_json["served_floors"].get<std::vector<int>>());
+                        }
+                        e.set<ElevatorShaft>(shaft);
+                    }
+                
+                    // StairsConnector
+                    if (entity_json.contains("stairs_connector")) {
+                        auto& connector_json = entity_json["stairs_connector"];
+                        e.set<StairsConnector>({
+                            connector_json.value("bottom_floor", 0),
+                            connector_json.value("column", 0),
+                            connector_json.value("seconds_per_floor", 5.0f)
                         });
                     }
                 
@@ -787,7 +869,8 @@ namespace towerforge::core {
                     if (entity_json.contains("elevator_car")) {
                         auto& car_json = entity_json["elevator_car"];
                         ElevatorCar car;
-                        car.shaft_entity_id = car_json.value("shaft_entity_id", -1);
+                        car.shaft_entity_id = static_cast<std::uint64_t>(
+                            std::max<std::int64_t>(0, car_json.value("shaft_entity_id", std::int64_t{0})));
                         car.current_floor = car_json.value("current_floor", 0.0f);
                         car.target_floor = car_json.value("target_floor", 0);
                         car.state = static_cast<ElevatorState>(car_json.value("state", 0));
@@ -798,11 +881,22 @@ namespace towerforge::core {
                         car.door_transition_duration = car_json.value("door_transition_duration", 1.0f);
                         car.floors_per_second = car_json.value("floors_per_second", 2.0f);
                     
-                        if (car_json.contains("stop_queue")) {
-                            car.stop_queue = car_json["stop_queue"].get<std::vector<int>>();
+                        car.travel_direction = car_json.value("travel_direction", 0);
+                        if (car_json.contains("up_stops")) {
+                            for (const int floor : car_json["up_stops"].get<std::vector<int>>()) {
+                                car.AddStop(floor, true);
+                            }
+                        }
+                        if (car_json.contains("down_stops")) {
+                            for (const int floor : car_json["down_stops"].get<std::vector<int>>()) {
+                                car.AddStop(floor, false);
+                            }
                         }
-                        if (car_json.contains("passenger_destinations")) {
-                            car.passenger_destinations = car_json["passenger_destinations"].get<std::vector<int>>();
+                        // Saves from before direction-aware stops kept a single sorted list
+                        if (car_json.contains("stop_queue")) {
+                            for (const int floor : car_json["stop_queue"].get<std::vector<int>>()) {
+                                car.AddStop(floor);
+                            }
                         }
                     
                         e.set<ElevatorCar>(car);
@@ -811,8 +905,9 @@ namespace towerforge::core {
                     // PersonElevatorRequest
                     if (entity_json.contains("elevator_request")) {
                         auto& req_json = entity_json["elevator_request"];
+                        // Older saves wrote -1 for "no shaft"
                         e.set<PersonElevatorRequest>({
-                            req_json.value("shaft_entity_id", -1),
+                            static_cast<std::uint64_t>(std::max<std::int64_t>(0, req_json.value("shaft_entity_id", std::int64_t{0}))),
                             req_json.value("call_floor", 0),
                             req_json.value("destination_floor", 0)
                         });
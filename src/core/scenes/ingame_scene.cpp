@@ -1,8 +1,10 @@
 #include "core/scenes/ingame_scene.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include "core/game.h"
+#include "core/fast_forward.hpp"
 #include "ui/hud/hud.h"
 #include "ui/action_bar.h"
 #include "ui/notification_center.h"
@@ -14,6 +16,7 @@ using namespace towerforge::ui;
 namespace towerforge::core {
 	// Constants
 	constexpr float HOURS_PER_DAY = 24.0f;
+	constexpr float FAST_FORWARD_STEP = 1.0f / 60.0f;  // One 60 FPS frame per skip-to step
 
 	// Helper function to convert facility type enum to string
 	static std::string GetFacilityTypeName(const BuildingComponent::Type type) {
@@ -32,6 +35,8 @@ namespace towerforge::core {
 			case BuildingComponent::Type::FlagshipStore: return "Flagship Store";
 			case BuildingComponent::Type::ManagementOffice: return "Management Office";
 			case BuildingComponent::Type::SatelliteOffice: return "Satellite Office";
+			case BuildingComponent::Type::Stairs: return "Stairs";
+			case BuildingComponent::Type::Escalator: return "Escalator";
 			default: return "Facility";
 		}
 	}
@@ -137,6 +142,7 @@ namespace towerforge::core {
 		  cell_width_(40),
 		  cell_height_(50),
 		  game_initialized_(false),
+		  evacuation_reported_(false),
 		  elapsed_time_(0),
 		  sim_time_(0),
 		  time_step_(0),
@@ -179,6 +185,7 @@ namespace towerforge::core {
 		save_load_manager_->Initialize();
 		save_load_manager_->SetAutosaveEnabled(true);
 		save_load_manager_->SetAutosaveInterval(120.0f);
+		save_load_manager_->SetOfflineCatchUpEnabled(true);
 		save_load_manager_->SetAchievementManager(achievement_manager_);
 
 		// Create save/load menu
@@ -198,7 +205,7 @@ namespace towerforge::core {
 		ecs_world_->GetWorld().set<ResearchTree>(research_tree);
 
 		// Create the global NPCSpawner as a singleton
-		ecs_world_->GetWorld().set<NPCSpawner>({30.0f}); // Spawn visitors every 30 seconds base rate
+		ecs_world_->GetWorld().set<NPCSpawner>({}); // Visitors arrive following the default daily profile
 
 		// Create the global StaffManager as a singleton
 		ecs_world_->GetWorld().set<StaffManager>({});
@@ -336,6 +343,9 @@ namespace towerforge::core {
 		hud_->SetPopulationAnalyticsCallback([this]() {
 			return CollectPopulationAnalytics();
 		});
+		hud_->SetElevatorAnalyticsCallback([this]() {
+			return CollectElevatorAnalytics();
+		});
 
 		// Set up action bar callback
 		hud_->SetActionBarCallback([this](int action) {
@@ -467,7 +477,7 @@ namespace towerforge::core {
 		elevator_shaft.set<ElevatorShaft>({10, 0, 5, 1});
 
 		const auto elevator_car = ecs_world_->CreateEntity("Elevator1");
-		elevator_car.set<ElevatorCar>({static_cast<int>(elevator_shaft.id()), 0, 8});
+		elevator_car.set<ElevatorCar>({elevator_shaft.id(), 0, 8});
 
 		std::cout << "  Created elevator shaft at column 10 serving floors 0-5" << std::endl;
 
@@ -529,6 +539,9 @@ namespace towerforge::core {
 			return;
 		}
 
+		// Stop any skip-to run before anything else touches the world
+		fast_forward_.reset();
+
 		pause_accessibility_settings_menu_.Shutdown();
 		pause_audio_settings_menu_.Shutdown();
 		pause_general_settings_menu_.Shutdown();
@@ -571,6 +584,16 @@ namespace towerforge::core {
 	}
 
 	void InGameScene::Update(const float delta_time) {
+		// The world belongs to the fast-forward worker until it finishes
+		if (fast_forward_ != nullptr) {
+			if (fast_forward_->IsRunning()) {
+				return;
+			}
+			if (fast_forward_->IsDone()) {
+				FinishFastForward();
+			}
+		}
+
 		// Only update simulation if not paused
 		if (!is_paused_) {
 			save_load_manager_->UpdateAutosave(time_step_, *ecs_world_);
@@ -582,6 +605,15 @@ namespace towerforge::core {
 			elapsed_time_ += time_step_;
 			sim_time_ += time_step_ * game_state_.speed_multiplier;
 
+			// Report the time to clear once everyone who can get out has
+			const auto &evacuation = ecs_world_->GetWorld().get<Evacuation>();
+			if (evacuation.active && evacuation.IsClear() && !evacuation_reported_) {
+				evacuation_reported_ = true;
+				hud_->AddNotification(Notification::Type::Success,
+				                      "Tower evacuated in " + std::to_string(static_cast<int>(evacuation.time_to_clear)) +
+				                      "s (" + std::to_string(evacuation.trapped) + " without a way out)", 8.0f);
+			}
+
 			game_state_.current_time = 8.5f + (sim_time_ / 3600.0f);
 			if (game_state_.current_time >= 24.0f) {
 				game_state_.current_time -= 24.0f;
@@ -704,10 +736,29 @@ namespace towerforge::core {
 				last_screen_width = screen_width;
 				last_screen_height = screen_height;
 			}
+
+			// Only floors on screen need individual visitors; the rest may be simulated as cohorts
+			auto &world = ecs_world_->GetWorld();
+			if (world.has<CrowdSimulation>()) {
+				const auto &grid = ecs_world_->GetTowerGrid();
+				const int ground_floor_screen_y = grid_offset_y_ + (grid.GetFloorCount() / 2) * cell_height_;
+				float view_left, view_top, view_right, view_bottom;
+				camera_->ScreenToWorld(0, 0, view_left, view_top);
+				camera_->ScreenToWorld(static_cast<int>(screen_width), static_cast<int>(screen_height),
+				                       view_right, view_bottom);
+				const int top_floor = (ground_floor_screen_y - static_cast<int>(view_top)) / cell_height_ + 1;
+				const int bottom_floor = (ground_floor_screen_y - static_cast<int>(view_bottom)) / cell_height_ - 1;
+				world.get_mut<CrowdSimulation>().SetVisibleFloors(bottom_floor, top_floor);
+			}
 		}
 	}
 
 	void InGameScene::Render() {
+		if (fast_forward_ != nullptr && fast_forward_->IsRunning()) {
+			RenderFastForwardOverlay();
+			return;
+		}
+
 		const auto &grid = ecs_world_->GetTowerGrid();
 
 		// Begin camera mode for all game world rendering
@@ -765,8 +816,13 @@ namespace towerforge::core {
 				const int x = grid_offset_x_ + shaft.column * cell_width_;
 				const int y = FloorToScreenY(floor);
 
-				DrawRectangle(x + 4, y + 4, cell_width_ - 8, cell_height_ - 8, Color{60, 60, 70, 255});
-				DrawRectangleLines(x + 4, y + 4, cell_width_ - 8, cell_height_ - 8, Color{100, 100, 120, 255});
+				// Express and zoned shafts pass floors they don't serve; draw those without a landing
+				if (shaft.ServesFloor(floor)) {
+					DrawRectangle(x + 4, y + 4, cell_width_ - 8, cell_height_ - 8, Color{60, 60, 70, 255});
+					DrawRectangleLines(x + 4, y + 4, cell_width_ - 8, cell_height_ - 8, Color{100, 100, 120, 255});
+				} else {
+					DrawRectangle(x + 8, y, cell_width_ - 16, cell_height_, Color{40, 40, 48, 255});
+				}
 			}
 		});
 
@@ -948,7 +1004,71 @@ namespace towerforge::core {
 		engine::ui::BatchRenderer::EndFrame();
 	}
 
+	void InGameScene::StartFastForward(const double target_hours, const std::string &label) {
+		const auto &time_mgr = ecs_world_->GetWorld().get<TimeManager>();
+		if (time_mgr.simulation_speed <= 0.0f) {
+			hud_->AddNotification(Notification::Type::Warning, "Unpause the clock before skipping ahead", 3.0f);
+			return;
+		}
+
+		// Give the run four times the steps it needs at the current speed before giving up
+		const double hours_per_step = time_mgr.hours_per_second * time_mgr.simulation_speed * FAST_FORWARD_STEP;
+		const double span = target_hours - time_mgr.GetAbsoluteHours();
+		const int max_steps = static_cast<int>(std::min(span / hours_per_step * 4.0 + 60.0, 1.0e8));
+
+		if (fast_forward_ == nullptr) {
+			fast_forward_ = std::make_unique<SimulationFastForward>();
+		}
+		if (fast_forward_->Start(*ecs_world_, target_hours, FAST_FORWARD_STEP, max_steps)) {
+			fast_forward_label_ = label;
+		}
+	}
+
+	void InGameScene::FinishFastForward() {
+		const auto result = fast_forward_->Finish();
+		std::cout << "Fast-forward: " << result.sim_hours << " sim-hours in " << result.wall_seconds << " s ("
+				<< result.GetSimHoursPerWallSecond() << " sim-hours/s, " << result.steps << " steps)" << std::endl;
+
+		const std::string throughput = TextFormat("%.1f sim-hours at %.0f sim-hours/s", result.sim_hours,
+		                                          result.GetSimHoursPerWallSecond());
+		if (result.reached_target) {
+			hud_->AddNotification(Notification::Type::Success, "Skipped to " + fast_forward_label_ + ": " + throughput,
+			                      5.0f);
+		} else {
+			hud_->AddNotification(Notification::Type::Info, "Skip stopped after " + throughput, 5.0f);
+		}
+	}
+
+	void InGameScene::RenderFastForwardOverlay() const {
+		std::uint32_t screen_width;
+		std::uint32_t screen_height;
+		engine::rendering::GetRenderer().GetFramebufferSize(screen_width, screen_height);
+		const int width = static_cast<int>(screen_width);
+		const int height = static_cast<int>(screen_height);
+
+		DrawRectangle(0, 0, width, height, ColorAlpha(BLACK, 0.85f));
+
+		constexpr int bar_width = 400;
+		constexpr int bar_height = 20;
+		const int bar_x = (width - bar_width) / 2;
+		const int bar_y = height / 2;
+		const float progress = fast_forward_->GetProgress();
+		DrawText(TextFormat("Skipping to %s...", fast_forward_label_.c_str()), bar_x, bar_y - 40, 20, WHITE);
+		DrawRectangle(bar_x, bar_y, static_cast<int>(bar_width * progress), bar_height, SKYBLUE);
+		DrawRectangleLines(bar_x, bar_y, bar_width, bar_height, WHITE);
+		DrawText(TextFormat("%d%%  -  ESC to stop", static_cast<int>(progress * 100.0f)), bar_x, bar_y + 30, 16,
+		         LIGHTGRAY);
+	}
+
 	void InGameScene::HandleMouseEvent(const engine::ui::MouseEvent &event) {
+		// While skipping ahead only ESC (stop) is live; everything else would touch the world
+		if (fast_forward_ != nullptr && fast_forward_->IsRunning()) {
+			if (IsKeyPressed(KEY_ESCAPE)) {
+				fast_forward_->Cancel();
+			}
+			return;
+		}
+
 		// Handle help system mouse input first (if visible)
 		if (help_system_) {
 			// Handle F1 key to toggle help system
@@ -1033,6 +1153,34 @@ namespace towerforge::core {
 			hud_->ToggleNotificationCenter();
 		}
 
+		// Handle E key to show elevator analytics
+		if (hud_ && IsKeyPressed(KEY_E)) {
+			hud_->RequestElevatorAnalytics();
+		}
+
+		// Handle V key to start or stand down an evacuation drill
+		if (hud_ && IsKeyPressed(KEY_V)) {
+			auto &evacuation = ecs_world_->GetWorld().get_mut<Evacuation>();
+			if (evacuation.active) {
+				evacuation.End();
+				hud_->AddNotification(Notification::Type::Info, "Evacuation drill ended", 3.0f);
+			} else {
+				evacuation.Begin();
+				evacuation_reported_ = false;
+				hud_->AddNotification(Notification::Type::Warning, "Evacuation drill: everyone to the exits!", 5.0f);
+			}
+		}
+
+		// Handle T key to skip ahead to 09:00 (Shift+T: Monday 09:00)
+		if (hud_ && !is_paused_ && IsKeyPressed(KEY_T)) {
+			const auto &time_mgr = ecs_world_->GetWorld().get<TimeManager>();
+			if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) {
+				StartFastForward(SimulationFastForward::GetNextDayOfWeek(time_mgr, 0, 9.0f), "Monday 09:00");
+			} else {
+				StartFastForward(SimulationFastForward::GetNextTimeOfDay(time_mgr, 9.0f), "09:00");
+			}
+		}
+
 		// Handle H key to toggle history panel (only if not paused)
 		if (history_panel_ && IsKeyPressed(KEY_H)) {
 			history_panel_->ToggleVisible();
@@ -1192,6 +1340,11 @@ namespace towerforge::core {
 
 					if (clicked_floor >= 0 && clicked_floor < grid.GetFloorCount() &&
 					    clicked_column >= 0 && clicked_column < grid.GetColumnCount()) {
+						// Bring back any cohort on the inspected floor as individual visitors
+						if (ecs_world_->GetWorld().has<CrowdSimulation>()) {
+							ecs_world_->GetWorld().get_mut<CrowdSimulation>().RequestMaterialize(clicked_floor);
+						}
+
 						// Check if click is on a Person entity
 						bool person_clicked = false;
 						const auto person_query = ecs_world_->GetWorld().query<const Person>();
@@ -1302,6 +1455,10 @@ namespace towerforge::core {
 											break;
 										case BuildingComponent::Type::Elevator: info.type = "Elevator";
 											break;
+										case BuildingComponent::Type::Stairs: info.type = "Stairs";
+											break;
+										case BuildingComponent::Type::Escalator: info.type = "Escalator";
+											break;
 										case BuildingComponent::Type::Gym: info.type = "Gym";
 											break;
 										case BuildingComponent::Type::Arcade: info.type = "Arcade";
@@ -1531,4 +1688,41 @@ namespace towerforge::core {
 
 		return breakdown;
 	}
+
+	ElevatorAnalytics InGameScene::CollectElevatorAnalytics() const {
+		if (!ecs_world_) {
+			return {};
+		}
+
+		ElevatorAnalytics analytics;
+		LatencyHistogram all_waits;
+
+		ecs_world_->GetWorld().each([&](const flecs::entity e, const ElevatorShaft &shaft, const ElevatorTelemetry &telemetry) {
+			ElevatorAnalytics::ElevatorStats stats{};
+			stats.elevator_id = static_cast<int>(e.id());
+			stats.bottom_floor = shaft.bottom_floor;
+			stats.top_floor = shaft.top_floor;
+			stats.served_floor_count = shaft.GetServedFloorCount();
+			stats.total_trips = static_cast<int>(telemetry.total_trips);
+			stats.total_passengers_carried = static_cast<int>(telemetry.total_trips);
+			stats.average_wait_time = telemetry.wait_times.GetMean();
+			stats.p50_wait_time = telemetry.wait_times.GetPercentile(0.50f);
+			stats.p95_wait_time = telemetry.wait_times.GetPercentile(0.95f);
+			stats.p99_wait_time = telemetry.wait_times.GetPercentile(0.99f);
+			stats.average_ride_time = telemetry.ride_times.GetMean();
+			stats.trips_per_hour = telemetry.GetTripsPerHour();
+			stats.utilization_rate = telemetry.GetUtilization() * 100.0f;
+			analytics.elevators.push_back(stats);
+
+			all_waits.Merge(telemetry.wait_times);
+		});
+
+		analytics.total_passengers = static_cast<int>(all_waits.count);
+		analytics.average_wait_time = all_waits.GetMean();
+		analytics.p50_wait_time = all_waits.GetPercentile(0.50f);
+		analytics.p95_wait_time = all_waits.GetPercentile(0.95f);
+		analytics.p99_wait_time = all_waits.GetPercentile(0.99f);
+
+		return analytics;
+	}
 }
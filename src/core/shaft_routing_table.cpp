@@ -0,0 +1,120 @@
+#include "core/components.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace towerforge::core {
+
+    std::vector<TripLeg> ShaftRoutingTable::FindRoute(const int origin, const int destination, const float column) {
+        if (origin == destination) return {};
+
+        if (const Candidate* direct = FindNearestShaft(origin, destination, column)) {
+            // Direct trips depend on the person's column, so they aren't cached
+            return {TripLeg{direct->shaft_id, direct->column, origin, destination}};
+        }
+
+        const std::int64_t key = (static_cast<std::int64_t>(origin) << 32) | static_cast<std::uint32_t>(destination);
+        const auto cached = route_cache.find(key);
+        if (cached != route_cache.end()) return cached->second;
+        return route_cache[key] = PlanTransferRoute(origin, destination);
+    }
+
+    std::vector<TripLeg> ShaftRoutingTable::PlanTransferRoute(const int origin, const int destination) const {
+        struct Node {
+            size_t shaft;
+            int floor;
+        };
+
+        // Nodes: every shaft at the origin, the destination, and floors it shares with another shaft
+        std::vector<Node> nodes;
+        std::vector<std::vector<size_t>> shaft_nodes(shafts.size());
+        for (size_t s = 0; s < shafts.size(); ++s) {
+            const ElevatorShaft& shaft = shafts[s].second;
+            for (int floor = shaft.bottom_floor; floor <= shaft.top_floor; ++floor) {
+                bool key_floor = floor == origin || floor == destination;
+                for (size_t other = 0; !key_floor && other < shafts.size(); ++other) {
+                    key_floor = other != s && shafts[other].second.ServesFloor(floor);
+                }
+                if (key_floor && shaft.ServesFloor(floor)) {
+                    shaft_nodes[s].push_back(nodes.size());
+                    nodes.push_back({s, floor});
+                }
+            }
+        }
+
+        constexpr float unreached = std::numeric_limits<float>::infinity();
+        std::vector<float> cost(nodes.size(), unreached);
+        std::vector<size_t> previous(nodes.size(), nodes.size());
+        using QueueEntry = std::pair<float, size_t>;
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> frontier;
+
+        for (size_t n = 0; n < nodes.size(); ++n) {
+            if (nodes[n].floor == origin) {
+                cost[n] = boarding_penalty;
+                frontier.emplace(cost[n], n);
+            }
+        }
+
+        size_t goal = nodes.size();
+        while (!frontier.empty()) {
+            const auto [node_cost, n] = frontier.top();
+            frontier.pop();
+            if (node_cost > cost[n]) continue;
+            if (nodes[n].floor == destination) {
+                goal = n;
+                break;
+            }
+
+            auto Relax = [&](const size_t next, const float step_cost) {
+                if (node_cost + step_cost < cost[next]) {
+                    cost[next] = node_cost + step_cost;
+                    previous[next] = n;
+                    frontier.emplace(cost[next], next);
+                }
+            };
+
+            // Ride to the neighbouring key floors of the same shaft
+            const auto& same_shaft = shaft_nodes[nodes[n].shaft];
+            const auto position = std::find(same_shaft.begin(), same_shaft.end(), n) - same_shaft.begin();
+            for (const auto neighbour : {position - 1, position + 1}) {
+                if (neighbour < 0 || neighbour >= static_cast<std::ptrdiff_t>(same_shaft.size())) continue;
+                const size_t next = same_shaft[neighbour];
+                const ElevatorShaft& riding = shafts[nodes[n].shaft].second;
+                Relax(next, static_cast<float>(std::abs(nodes[next].floor - nodes[n].floor)) / ride_floors_per_second +
+                            static_cast<float>(riding.CountServedFloorsBetween(nodes[n].floor, nodes[next].floor)) *
+                            intermediate_stop_penalty);
+            }
+
+            // Transfer to another shaft on this floor
+            for (size_t next = 0; next < nodes.size(); ++next) {
+                if (nodes[next].floor != nodes[n].floor || nodes[next].shaft == nodes[n].shaft) continue;
+                const int walk = std::abs(shafts[nodes[next].shaft].second.column - shafts[nodes[n].shaft].second.column);
+                Relax(next, static_cast<float>(walk) / walk_columns_per_second + boarding_penalty);
+            }
+        }
+
+        std::vector<TripLeg> legs;
+        if (goal == nodes.size()) return legs;
+
+        // Walk back from the goal; consecutive nodes on one shaft form a single leg
+        std::vector<size_t> path;
+        for (size_t n = goal; n != nodes.size(); n = previous[n]) {
+            path.push_back(n);
+        }
+        std::reverse(path.begin(), path.end());
+        for (const size_t n : path) {
+            const auto& [shaft_id, shaft] = shafts[nodes[n].shaft];
+            if (legs.empty() || legs.back().shaft_id != shaft_id) {
+                legs.push_back({shaft_id, shaft.column, nodes[n].floor, nodes[n].floor});
+            } else {
+                legs.back().alight_floor = nodes[n].floor;
+            }
+        }
+        legs.erase(std::remove_if(legs.begin(), legs.end(), [](const TripLeg& leg) {
+            return leg.board_floor == leg.alight_floor;
+        }), legs.end());
+        return legs;
+    }
+
+}
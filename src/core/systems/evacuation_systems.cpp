@@ -0,0 +1,299 @@
+#include "core/systems/evacuation_systems.hpp"
+#include "core/components.hpp"
+#include "core/movement_kernels.hpp"
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace towerforge::core::Systems {
+
+    namespace {
+
+        /**
+     * @brief Drop a person's trip and send them toward the nearest exit
+     *
+     * Visitors are marked as leaving so the needs systems don't hand them a
+     * new destination, and the visitor cleanup despawns them once outside.
+     */
+        void Enroll(const flecs::entity e, Person& person, Evacuation& evacuation) {
+            e.remove<PersonElevatorRequest>();
+            e.remove<TripItinerary>();
+            e.remove<StairsTrip>();
+
+            if (e.has<VisitorInfo>()) {
+                auto& visitor = e.get_mut<VisitorInfo>();
+                visitor.activity = VisitorActivity::Leaving;
+                visitor.is_interacting = false;
+            }
+
+            Evacuee evacuee;
+            const int cell = evacuation.field.GetIndex(person.current_floor,
+                                                       static_cast<int>(std::floor(person.current_column)));
+            if (cell < 0 || std::isinf(evacuation.field.cost[cell])) {
+                evacuee.trapped = true;
+                evacuation.trapped++;
+                person.current_need = "Trapped";
+            } else {
+                person.current_need = "Evacuating";
+            }
+
+            person.state = PersonState::Evacuating;
+            person.destination_floor = person.current_floor;
+            person.destination_column = person.current_column;
+            person.wait_time = 0.0f;
+            e.set<Evacuee>(evacuee);
+            evacuation.evacuees++;
+        }
+
+        void StartEvacuation(const flecs::world& world, Evacuation& evacuation) {
+            evacuation.start_requested = false;
+            evacuation.active = true;
+            evacuation.elapsed = 0.0f;
+            evacuation.evacuees = 0;
+            evacuation.evacuated = 0;
+            evacuation.trapped = 0;
+            evacuation.time_to_clear = -1.0f;
+
+            // Stairs and escalators, plus fire stairs running the full height of every shaft
+            std::vector<StairsConnector> stairwells;
+            world.each([&](const StairsConnector& connector) {
+                stairwells.push_back(connector);
+            });
+            if (evacuation.shafts_have_fire_stairs) {
+                world.each([&](const ElevatorShaft& shaft) {
+                    for (int floor = shaft.bottom_floor; floor < shaft.top_floor; ++floor) {
+                        stairwells.emplace_back(floor, shaft.column, evacuation.fire_stairs_seconds_per_floor);
+                    }
+                });
+            }
+
+            const FloorFlowFields* flow_fields = world.has<FloorFlowFields>() ? &world.get<FloorFlowFields>() : nullptr;
+            const TowerGrid* grid = flow_fields != nullptr ? flow_fields->grid : nullptr;
+            assert((flow_fields == nullptr || grid != nullptr) && "FloorFlowFields is set up with ECSWorld's grid");
+            evacuation.field = EvacuationField();
+            if (grid != nullptr) {
+                // Lobbies lead outside; without one, people leave at either end of the built ground floor
+                const int ground_floor = grid->GetGroundFloorIndex();
+                std::vector<int> exits;
+                world.each([&](const BuildingComponent& facility) {
+                    if (facility.type != BuildingComponent::Type::Lobby || facility.floor != ground_floor) return;
+                    for (int column = facility.column; column < facility.column + facility.width; ++column) {
+                        exits.push_back(column);
+                    }
+                });
+                if (exits.empty()) {
+                    for (int column = 0; column < grid->GetColumnCount(); ++column) {
+                        if (grid->IsFloorBuilt(ground_floor, column)) {
+                            exits.push_back(column);
+                            break;
+                        }
+                    }
+                    for (int column = grid->GetColumnCount() - 1; column >= 0; --column) {
+                        if (grid->IsFloorBuilt(ground_floor, column)) {
+                            exits.push_back(column);
+                            break;
+                        }
+                    }
+                }
+                evacuation.field.Build(*grid, stairwells, exits, evacuation.walk_speed, flow_fields->facility_cell_cost);
+            }
+            evacuation.stairwell_open_at.assign(evacuation.field.cost.size(), 0.0f);
+
+            // Cars stop taking passengers; riders step out at the nearest floor
+            world.each([&](ElevatorCar& car) {
+                const auto shaft_entity = world.entity(car.shaft_entity_id);
+                const float shaft_column = shaft_entity.is_valid() && shaft_entity.has<ElevatorShaft>()
+                                               ? static_cast<float>(shaft_entity.get<ElevatorShaft>().column)
+                                               : 0.0f;
+                for (const ElevatorCar::Rider& rider : car.riders) {
+                    car.passenger_counts.Remove(rider.destination_floor);
+                    const auto person_entity = world.entity(rider.person_id);
+                    if (!person_entity.is_alive() || !person_entity.has<Person>()) continue;
+                    auto& person = person_entity.get_mut<Person>();
+                    person.current_floor = car.GetCurrentFloorInt();
+                    person.current_column = shaft_column;
+                }
+                car.riders.clear();
+                car.current_occupancy = 0;
+            });
+
+            // Off-screen cohorts come back as individuals so they can be led out too
+            if (world.has<CrowdSimulation>()) {
+                auto& crowd = world.get_mut<CrowdSimulation>();
+                for (const CrowdCohort& cohort : crowd.cohorts) {
+                    crowd.RequestMaterialize(cohort.floor);
+                }
+            }
+
+            world.each([&](const flecs::entity e, Person& person) {
+                Enroll(e, person, evacuation);
+            });
+
+            std::cout << "  [Evacuation] Started: " << evacuation.evacuees << " people, "
+                    << evacuation.field.exit_count << " exit cells, " << evacuation.field.stairwell_count
+                    << " stairwell flights, " << evacuation.trapped << " without a way out" << std::endl;
+        }
+
+        void EndEvacuation(const flecs::world& world, Evacuation& evacuation) {
+            evacuation.end_requested = false;
+            evacuation.active = false;
+
+            world.each([&](const flecs::entity e, Person& person, const Evacuee&) {
+                if (person.state == PersonState::Evacuating) {
+                    person.state = PersonState::AtDestination;
+                    person.destination_floor = person.current_floor;
+                    person.destination_column = person.current_column;
+                    person.current_need = "Idle";
+                }
+                // Employees head back to work at the start of the next shift check
+                if (e.has<EmploymentInfo>()) {
+                    e.get_mut<EmploymentInfo>().currently_on_shift = false;
+                }
+                e.remove<Evacuee>();
+            });
+
+            evacuation.field = EvacuationField();
+            evacuation.stairwell_open_at.clear();
+
+            std::cout << "  [Evacuation] Ended: " << evacuation.evacuated << " of " << evacuation.evacuees
+                    << " evacuated" << std::endl;
+        }
+
+    }
+
+    void EvacuationSystems::RegisterAll(flecs::world& world) {
+        RegisterEvacuationControl(world);
+        RegisterEvacuationEnrollment(world);
+        RegisterEvacuationMovement(world);
+    }
+
+    void EvacuationSystems::RegisterEvacuationControl(flecs::world& world) {
+        world.system<Evacuation>()
+                .kind(flecs::OnUpdate)
+                .each([](const flecs::entity e, Evacuation& evacuation) {
+                    if (evacuation.start_requested) {
+                        StartEvacuation(e.world(), evacuation);
+                    } else if (evacuation.end_requested) {
+                        EndEvacuation(e.world(), evacuation);
+                    }
+                });
+    }
+
+    void EvacuationSystems::RegisterEvacuationEnrollment(flecs::world& world) {
+        // People who turn up mid-evacuation (materialized cohorts) are sent out as well
+        world.system<Evacuation>()
+                .kind(flecs::OnUpdate)
+                .interval(1.0f)
+                .each([](const flecs::entity e, Evacuation& evacuation) {
+                    if (!evacuation.active) return;
+                    e.world().each([&](const flecs::entity person_entity, Person& person) {
+                        if (!person_entity.has<Evacuee>()) {
+                            Enroll(person_entity, person, evacuation);
+                        }
+                    });
+                });
+    }
+
+    void EvacuationSystems::RegisterEvacuationMovement(flecs::world& world) {
+        // Walkers on each floor are gathered per table and advanced together by the movement kernel
+        // toward the end of their run (an exit or a stairwell door)
+        world.system<Person, Evacuee>()
+                .kind(flecs::OnUpdate)
+                .run([](flecs::iter& it) {
+                    thread_local kernels::MovementBatch batch;
+                    const flecs::world ecs_world = it.world();
+                    const float delta_time = it.delta_time();
+                    Evacuation* evacuation = ecs_world.has<Evacuation>() ? &ecs_world.get_mut<Evacuation>() : nullptr;
+                    const CrowdDensity* density = ecs_world.has<CrowdDensity>() ? &ecs_world.get<CrowdDensity>() : nullptr;
+                    const bool active = evacuation != nullptr && evacuation->active;
+                    if (active) {
+                        evacuation->elapsed += delta_time;
+                    }
+
+                    while (it.next()) {
+                        if (!active) continue;
+                        auto people = it.field<Person>(0);
+                        auto evacuees = it.field<Evacuee>(1);
+                        const EvacuationField& field = evacuation->field;
+                        batch.Clear();
+
+                        for (const auto i : it) {
+                            Person& person = people[i];
+                            Evacuee& evacuee = evacuees[i];
+                            if (person.state != PersonState::Evacuating || evacuee.trapped) continue;
+
+                            if (evacuee.stairs_remaining > 0.0f) {
+                                evacuee.stairs_remaining -= delta_time;
+                                if (evacuee.stairs_remaining <= 0.0f) {
+                                    evacuee.stairs_remaining = 0.0f;
+                                    person.current_floor += evacuee.stairs_direction;
+                                }
+                                continue;
+                            }
+
+                            const int column = static_cast<int>(std::floor(person.current_column));
+                            const int cell = field.GetIndex(person.current_floor, column);
+                            if (cell < 0 || std::isinf(field.cost[cell])) {
+                                evacuee.trapped = true;
+                                evacuation->trapped++;
+                                person.current_need = "Trapped";
+                                continue;
+                            }
+
+                            switch (field.step[cell]) {
+                                case EvacuationField::Step::Exit:
+                                    person.state = PersonState::AtDestination;
+                                    person.destination_floor = person.current_floor;
+                                    person.destination_column = person.current_column;
+                                    person.current_need = "Evacuated";
+                                    evacuee.evacuated = true;
+                                    evacuation->evacuated++;
+                                    break;
+
+                                case EvacuationField::Step::Down:
+                                case EvacuationField::Step::Up: {
+                                    // The door admits one person at a time; the rest wait their turn
+                                    float& open_at = evacuation->stairwell_open_at[cell];
+                                    if (evacuation->elapsed < open_at) break;
+                                    open_at = std::max(open_at, evacuation->elapsed) +
+                                              1.0f / evacuation->stairwell_entries_per_second;
+                                    evacuee.stairs_remaining = field.stairs_seconds[cell];
+                                    evacuee.stairs_direction = field.step[cell] == EvacuationField::Step::Up ? 1 : -1;
+                                    person.current_column = static_cast<float>(column) + 0.5f;
+                                    break;
+                                }
+
+                                case EvacuationField::Step::Left:
+                                case EvacuationField::Step::Right: {
+                                    float speed = person.move_speed / field.cell_costs[cell];
+                                    if (density != nullptr) {
+                                        speed *= density->GetSpeedFactor(person.current_floor, column);
+                                    }
+                                    batch.Add(i, person.current_column, static_cast<float>(field.waypoint[cell]) + 0.5f,
+                                              speed * delta_time);
+                                    break;
+                                }
+
+                                case EvacuationField::Step::None:
+                                    break;
+                            }
+                        }
+
+                        // Arrivals are handled next tick from the cell they landed in
+                        batch.Advance();
+                        for (std::size_t slot = 0; slot < batch.rows.size(); ++slot) {
+                            people[batch.rows[slot]].current_column = batch.positions[slot];
+                        }
+                    }
+
+                    if (active && !evacuation->IsClear() && evacuation->GetRemaining() <= 0) {
+                        evacuation->time_to_clear = evacuation->elapsed;
+                        std::cout << "  [Evacuation] Tower cleared in " << evacuation->time_to_clear << " s: "
+                                << evacuation->evacuated << " evacuated, " << evacuation->trapped
+                                << " without a way out" << std::endl;
+                    }
+                });
+    }
+
+}
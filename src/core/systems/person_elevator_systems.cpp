@@ -1,108 +1,373 @@
 #include "core/systems/person_elevator_systems.hpp"
 #include "core/components.hpp"
+#include "core/movement_kernels.hpp"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
 
 namespace towerforge::core::Systems {
 
+    namespace {
+
+        /**
+     * @brief Sim-hours elapsed, used to bucket elevator telemetry
+     * 
+     * Falls back to world time when no TimeManager is running (headless tests).
+     */
+        double CurrentSimHours(const flecs::world& world) {
+            if (world.has<TimeManager>()) {
+                const auto& time_mgr = world.get<TimeManager>();
+                return static_cast<double>(time_mgr.GetAbsoluteHour()) + std::fmod(time_mgr.current_hour, 1.0f);
+            }
+            return world.get_info()->world_time_total / 3600.0;
+        }
+
+        std::int64_t CurrentSimHour(const flecs::world& world) {
+            return static_cast<std::int64_t>(CurrentSimHours(world));
+        }
+
+        /**
+     * @brief Let a rider out of a car at a floor
+     * 
+     * Riders on a transfer floor go back to waiting so the next leg of their
+     * itinerary is requested; everyone else walks on to their destination.
+     */
+        void AlightRider(const flecs::entity rider, const int floor) {
+            auto& person = rider.get_mut<Person>();
+            person.current_floor = floor;
+            rider.remove<PersonElevatorRequest>();
+
+            if (!person.HasReachedVerticalDestination()) {
+                person.state = PersonState::WaitingForElevator;
+                return;
+            }
+
+            if (rider.has<TripItinerary>()) {
+                person.destination_column = rider.get<TripItinerary>().final_column;
+                rider.remove<TripItinerary>();
+            }
+
+            if (!person.HasReachedHorizontalDestination()) {
+                person.state = PersonState::Walking;
+            } else {
+                person.state = PersonState::AtDestination;
+            }
+        }
+
+    }
+
     void PersonElevatorSystems::RegisterAll(flecs::world& world) {
+        RegisterElevatorDispatchObservers(world);
+        RegisterShaftRouting(world);
+        RegisterFloorFlowFields(world);
+        RegisterCrowdDensity(world);
         RegisterPersonHorizontalMovement(world);
         RegisterPersonWaiting(world);
         RegisterPersonElevatorRiding(world);
+        RegisterPersonStairs(world);
         RegisterPersonStateLogging(world);
         RegisterElevatorCarMovement(world);
         RegisterElevatorCall(world);
+        RegisterElevatorDispatch(world);
         RegisterPersonElevatorBoarding(world);
+        RegisterHallQueueLayout(world);
+        RegisterElevatorTelemetry(world);
+        RegisterElevatorParking(world);
         RegisterElevatorLogging(world);
     }
 
+    void PersonElevatorSystems::RegisterFloorFlowFields(flecs::world& world) {
+        world.system<FloorFlowFields>()
+                .kind(flecs::OnUpdate)
+                .each([](FloorFlowFields& flow_fields) {
+                    flow_fields.Sync();
+                });
+    }
+
+    void PersonElevatorSystems::RegisterCrowdDensity(flecs::world& world) {
+        // One pass over everyone in the halls; riders and people on the stairs don't take up floor space
+        world.system<CrowdDensity>()
+                .kind(flecs::OnUpdate)
+                .each([](const flecs::entity e, CrowdDensity& density) {
+                    density.Reset();
+                    e.world().each([&](const Person& person) {
+                        if (person.state == PersonState::InElevator || person.state == PersonState::UsingStairs) return;
+                        density.Add(person.current_floor, person.current_column);
+                    });
+                });
+    }
+
     void PersonElevatorSystems::RegisterPersonHorizontalMovement(flecs::world& world) {
+        // Walkers are gathered per table and advanced together by the movement kernel
         world.system<Person>()
                 .kind(flecs::OnUpdate)
-                .each([](const flecs::entity e, Person& person) {
-                    const float delta_time = e.world().delta_time();
-            
-                    if (person.state == PersonState::Walking) {
-                        const float direction = (person.destination_column > person.current_column) ? 1.0f : -1.0f;
-                        const float distance_to_dest = std::abs(person.destination_column - person.current_column);
-                
-                        const float move_amount = person.move_speed * delta_time;
-                
-                        if (move_amount >= distance_to_dest) {
-                            person.current_column = person.destination_column;
-                    
+                .run([](flecs::iter& it) {
+                    thread_local kernels::MovementBatch batch;
+                    thread_local std::vector<std::uint8_t> held_at_gap;
+                    const flecs::world ecs_world = it.world();
+                    const float delta_time = it.delta_time();
+                    const CrowdDensity* density = ecs_world.has<CrowdDensity>() ? &ecs_world.get<CrowdDensity>() : nullptr;
+                    FloorFlowFields* flow_fields = ecs_world.has<FloorFlowFields>() ? &ecs_world.get_mut<FloorFlowFields>() : nullptr;
+
+                    while (it.next()) {
+                        auto people = it.field<Person>(0);
+                        batch.Clear();
+                        held_at_gap.clear();
+
+                        for (const auto i : it) {
+                            Person& person = people[i];
+                            if (person.state != PersonState::Walking) continue;
+
+                            float speed = person.move_speed;
+                            float target = person.destination_column;
+
+                            // Between built cells, follow the shared field toward the target cell and stop short
+                            // of gaps; walkers or targets off the built floor (e.g. floors not built yet) keep
+                            // the straight line
+                            const int cell = static_cast<int>(std::floor(person.current_column));
+                            const int target_cell = static_cast<int>(std::floor(person.destination_column));
+                            if (density != nullptr) {
+                                speed *= density->GetSpeedFactor(person.current_floor, cell);
+                            }
+                            if (cell != target_cell && flow_fields != nullptr) {
+                                const float cell_cost = flow_fields->GetCellCost(person.current_floor, cell);
+                                const FloorFlowFields::Field* field = std::isinf(cell_cost)
+                                    ? nullptr
+                                    : flow_fields->GetField(person.current_floor, target_cell);
+                                if (field != nullptr && cell >= 0 && cell < static_cast<int>(field->step.size())) {
+                                    // The field only steers toward the target on a single floor, so the
+                                    // kernel's own direction (sign of the remaining distance) agrees with it
+                                    speed /= cell_cost;
+                                    if (field->step[cell] == 0) {
+                                        // A gap lies between the person and their target: they walk to the
+                                        // middle of the last cell before it and wait there, still walking,
+                                        // until the floor is filled in and the field rebuilt
+                                        const int edge = flow_fields->GetReachableColumn(person.current_floor, cell, target_cell);
+                                        target = static_cast<float>(edge) + 0.5f;
+                                    }
+                                }
+                            }
+
+                            batch.Add(i, person.current_column, target, speed * delta_time);
+                            held_at_gap.push_back(target != person.destination_column ? 1 : 0);
+                        }
+
+                        batch.Advance();
+
+                        for (std::size_t slot = 0; slot < batch.rows.size(); ++slot) {
+                            Person& person = people[batch.rows[slot]];
+                            person.current_column = batch.positions[slot];
+                            if (batch.arrived[slot] == 0 || held_at_gap[slot] != 0) continue;
+
                             if (person.HasReachedVerticalDestination()) {
                                 person.state = PersonState::AtDestination;
                             } else {
                                 person.state = PersonState::WaitingForElevator;
                             }
-                        } else {
-                            person.current_column += direction * move_amount;
                         }
                     }
                 });
     }
 
+    void PersonElevatorSystems::RegisterShaftRouting(flecs::world& world) {
+        // Shafts added, removed or resized invalidate the floor-pair table
+        world.observer<const ElevatorShaft>()
+                .event(flecs::OnSet)
+                .each([](const flecs::entity e, const ElevatorShaft&) {
+                    if (e.world().has<ShaftRoutingTable>()) {
+                        e.world().get_mut<ShaftRoutingTable>().MarkDirty();
+                    }
+                });
+
+        world.observer<const ElevatorShaft>()
+                .event(flecs::OnRemove)
+                .each([](const flecs::entity e, const ElevatorShaft&) {
+                    if (e.world().has<ShaftRoutingTable>()) {
+                        e.world().get_mut<ShaftRoutingTable>().MarkDirty();
+                    }
+                });
+
+        // So do stairs and escalators
+        world.observer<const StairsConnector>()
+                .event(flecs::OnSet)
+                .each([](const flecs::entity e, const StairsConnector&) {
+                    if (e.world().has<ShaftRoutingTable>()) {
+                        e.world().get_mut<ShaftRoutingTable>().MarkDirty();
+                    }
+                });
+
+        world.observer<const StairsConnector>()
+                .event(flecs::OnRemove)
+                .each([](const flecs::entity e, const StairsConnector&) {
+                    if (e.world().has<ShaftRoutingTable>()) {
+                        e.world().get_mut<ShaftRoutingTable>().MarkDirty();
+                    }
+                });
+
+        world.system<ShaftRoutingTable>()
+                .kind(flecs::OnUpdate)
+                .each([](const flecs::entity e, ShaftRoutingTable& table) {
+                    if (!table.dirty) return;
+
+                    std::vector<std::pair<std::uint64_t, ElevatorShaft>> shafts;
+                    e.world().each([&](const flecs::entity shaft_entity, const ElevatorShaft& shaft) {
+                        shafts.emplace_back(shaft_entity.id(), shaft);
+                    });
+                    std::vector<StairsConnector> stairs;
+                    e.world().each([&](const StairsConnector& connector) {
+                        stairs.push_back(connector);
+                    });
+                    table.Rebuild(shafts, stairs);
+                });
+    }
+
     void PersonElevatorSystems::RegisterPersonWaiting(flecs::world& world) {
         world.system<Person>()
                 .kind(flecs::OnUpdate)
                 .each([](const flecs::entity e, Person& person) {
-                    if (person.state == PersonState::WaitingForElevator && 
-                        !e.has<PersonElevatorRequest>()) {
-                
-                        int shaft_id = -1;
-                        int shaft_column = -1;
-                
-                        e.world().each<ElevatorShaft>([&](const flecs::entity shaft_entity, const ElevatorShaft& shaft) {
-                            if (shaft_id == -1 && shaft.ServesFloor(person.current_floor) && 
-                                shaft.ServesFloor(person.destination_floor)) {
-                                shaft_id = static_cast<int>(shaft_entity.id());
-                                shaft_column = shaft.column;
-                            }
-                        });
-                
-                        if (shaft_id != -1) {
-                            e.set<PersonElevatorRequest>({
-                                shaft_id,
-                                person.current_floor,
-                                person.destination_floor
-                            });
-                    
-                            if (std::abs(person.current_column - static_cast<float>(shaft_column)) > 0.1f) {
-                                person.destination_column = static_cast<float>(shaft_column);
+                    if (person.state != PersonState::WaitingForElevator || e.has<PersonElevatorRequest>()) return;
+
+                    const flecs::world ecs_world = e.world();
+
+                    // Take the stairs already chosen once standing at them, unless the destination moved
+                    if (e.has<StairsTrip>()) {
+                        const auto& trip = e.get<StairsTrip>();
+                        const bool still_heading_there = trip.from_floor == person.current_floor &&
+                            (trip.to_floor > trip.from_floor) == (person.destination_floor > person.current_floor);
+                        if (still_heading_there) {
+                            if (std::abs(person.current_column - static_cast<float>(trip.column)) > 0.1f) {
+                                person.destination_column = static_cast<float>(trip.column);
                                 person.state = PersonState::Walking;
+                            } else {
+                                person.state = PersonState::UsingStairs;
                             }
-                        } else {
-                            person.wait_time += e.world().delta_time();
-                            if (person.wait_time > 5.0f) {
-                                person.state = PersonState::InElevator;
-                                person.wait_time = 0.0f;
+                            return;
+                        }
+                        person.destination_column = trip.final_column;
+                        e.remove<StairsTrip>();
+                    }
+
+                    // Continue the current itinerary if it still leads where the person is going
+                    std::optional<TripLeg> leg;
+                    if (e.has<TripItinerary>()) {
+                        auto& itinerary = e.get_mut<TripItinerary>();
+                        const TripLeg* next_leg = itinerary.final_floor == person.destination_floor
+                            ? itinerary.AdvanceTo(person.current_floor)
+                            : nullptr;
+                        if (next_leg != nullptr) {
+                            leg = *next_leg;
+                        }
+                    }
+
+                    // Short hops walk over stairs or escalators when that beats waiting for a car
+                    if (!leg && ecs_world.has<ShaftRoutingTable>()) {
+                        if (const StairsConnector* stairs = ecs_world.get<ShaftRoutingTable>().FindStairsRoute(
+                                person.current_floor, person.destination_floor, person.current_column)) {
+                            const bool going_up = person.destination_floor > person.current_floor;
+                            const StairsTrip trip(stairs->column, person.current_floor,
+                                                  person.current_floor + (going_up ? 1 : -1),
+                                                  stairs->seconds_per_floor, person.destination_column);
+                            e.remove<TripItinerary>();
+                            e.set<StairsTrip>(trip);
+                            person.wait_time = 0.0f;
+                            if (std::abs(person.current_column - static_cast<float>(trip.column)) > 0.1f) {
+                                person.destination_column = static_cast<float>(trip.column);
+                                person.state = PersonState::Walking;
+                            } else {
+                                person.state = PersonState::UsingStairs;
                             }
+                            return;
+                        }
+                    }
+
+                    if (!leg && ecs_world.has<ShaftRoutingTable>()) {
+                        const std::vector<TripLeg> legs = ecs_world.get_mut<ShaftRoutingTable>().FindRoute(
+                            person.current_floor, person.destination_floor, person.current_column);
+                        if (!legs.empty()) {
+                            leg = legs.front();
+                            e.set<TripItinerary>({legs, person.destination_floor, person.destination_column});
                         }
                     }
+
+                    if (!leg) {
+                        // No shaft connects these floors; give up on the trip rather than teleporting
+                        person.destination_floor = person.current_floor;
+                        person.destination_column = person.current_column;
+                        person.current_need = "No route";
+                        person.state = PersonState::AtDestination;
+                        person.wait_time = 0.0f;
+                        e.remove<TripItinerary>();
+                        return;
+                    }
+
+                    e.set<PersonElevatorRequest>({
+                        leg->shaft_id,
+                        person.current_floor,
+                        leg->alight_floor
+                    });
+
+                    if (std::abs(person.current_column - static_cast<float>(leg->column)) > 0.1f) {
+                        person.destination_column = static_cast<float>(leg->column);
+                        person.state = PersonState::Walking;
+                    }
                 });
     }
 
     void PersonElevatorSystems::RegisterPersonElevatorRiding(flecs::world& world) {
+        // Riders no car knows about (e.g. restored from a save) get off and plan their trip again
         world.system<Person>()
                 .kind(flecs::OnUpdate)
                 .each([](const flecs::entity e, Person& person) {
-                    if (person.state == PersonState::InElevator && !e.has<PersonElevatorRequest>()) {
-                        const float delta_time = e.world().delta_time();
-                        person.wait_time += delta_time;
-                
-                        if (person.wait_time > 3.0f) {
-                            person.current_floor = person.destination_floor;
-                            person.wait_time = 0.0f;
-                    
-                            if (!person.HasReachedHorizontalDestination()) {
-                                person.state = PersonState::Walking;
-                            } else {
-                                person.state = PersonState::AtDestination;
-                            }
+                    if (person.state == PersonState::InElevator &&
+                        (!e.has<PersonElevatorRequest>() || !e.get<PersonElevatorRequest>().riding)) {
+                        person.wait_time = 0.0f;
+                        person.state = person.HasReachedVerticalDestination()
+                            ? PersonState::AtDestination
+                            : PersonState::WaitingForElevator;
+                    }
+                });
+    }
+
+    void PersonElevatorSystems::RegisterPersonStairs(flecs::world& world) {
+        world.system<Person, StairsTrip>()
+                .kind(flecs::OnUpdate)
+                .each([](const flecs::entity e, Person& person, StairsTrip& trip) {
+                    if (person.state != PersonState::UsingStairs) {
+                        // Trips abandoned before reaching the stairs (new destination on this floor, arrived)
+                        if (person.state == PersonState::AtDestination || person.state == PersonState::Idle) {
+                            e.remove<StairsTrip>();
                         }
+                        return;
+                    }
+
+                    trip.elapsed += e.world().delta_time();
+                    if (trip.elapsed < trip.seconds) return;
+
+                    // Step off on the next floor; further floors are planned from there
+                    person.current_floor = trip.to_floor;
+                    person.destination_column = trip.final_column;
+                    e.remove<StairsTrip>();
+
+                    if (!person.HasReachedVerticalDestination()) {
+                        person.state = PersonState::WaitingForElevator;
+                    } else if (!person.HasReachedHorizontalDestination()) {
+                        person.state = PersonState::Walking;
+                    } else {
+                        person.state = PersonState::AtDestination;
                     }
                 });
+
+        // People on the stairs without a trip (e.g. restored from a save) plan again from where they stand
+        world.system<Person>()
+                .kind(flecs::OnUpdate)
+                .each([](const flecs::entity e, Person& person) {
+                    if (person.state != PersonState::UsingStairs || e.has<StairsTrip>()) return;
+                    person.state = person.HasReachedVerticalDestination()
+                        ? PersonState::AtDestination
+                        : PersonState::WaitingForElevator;
+                });
     }
 
     void PersonElevatorSystems::RegisterPersonStateLogging(flecs::world& world) {
@@ -125,139 +390,454 @@ namespace towerforge::core::Systems {
     }
 
     void PersonElevatorSystems::RegisterElevatorCarMovement(flecs::world& world) {
+        // Door and idle states step per car; cars already moving at the start of the tick are
+        // gathered per table and advanced together by the movement kernel
         world.system<ElevatorCar>()
                 .kind(flecs::OnUpdate)
-                .each([](const flecs::entity e, ElevatorCar& car) {
-                    const float delta_time = e.world().delta_time();
-            
-                    car.state_timer += delta_time;
-            
-                    switch (car.state) {
-                        case ElevatorState::Idle:
-                            if (!car.stop_queue.empty()) {
-                                car.target_floor = car.GetNextStop();
-                                const int current_floor = car.GetCurrentFloorInt();
-                        
-                                if (car.target_floor > current_floor) {
-                                    car.state = ElevatorState::MovingUp;
-                                } else if (car.target_floor < current_floor) {
-                                    car.state = ElevatorState::MovingDown;
-                                } else {
-                                    car.state = ElevatorState::DoorsOpening;
-                                    car.state_timer = 0.0f;
-                                }
+                .run([](flecs::iter& it) {
+                    thread_local kernels::MovementBatch batch;
+                    thread_local std::vector<std::uint8_t> held_at_gap;
+                    const float delta_time = it.delta_time();
+
+                    while (it.next()) {
+                        auto cars = it.field<ElevatorCar>(0);
+                        batch.Clear();
+
+                        for (const auto i : it) {
+                            ElevatorCar& car = cars[i];
+                            car.state_timer += delta_time;
+
+                            switch (car.state) {
+                                case ElevatorState::Idle:
+                                    if (car.HasStops()) {
+                                        car.target_floor = car.GetNextStop();
+                                        const int current_floor = car.GetCurrentFloorInt();
+
+                                        if (car.target_floor > current_floor) {
+                                            car.state = ElevatorState::MovingUp;
+                                            car.travel_direction = 1;
+                                        } else if (car.target_floor < current_floor) {
+                                            car.state = ElevatorState::MovingDown;
+                                            car.travel_direction = -1;
+                                        } else {
+                                            car.state = ElevatorState::DoorsOpening;
+                                            car.state_timer = 0.0f;
+                                        }
+                                    }
+                                    break;
+
+                                case ElevatorState::MovingUp:
+                                case ElevatorState::MovingDown:
+                                    // target_floor only changes while Idle, so it always lies in the travel direction
+                                    batch.Add(i, car.current_floor, static_cast<float>(car.target_floor),
+                                              car.floors_per_second * delta_time);
+                                    break;
+
+                                case ElevatorState::DoorsOpening:
+                                    if (car.state_timer >= car.door_transition_duration) {
+                                        car.state = ElevatorState::DoorsOpen;
+                                        car.state_timer = 0.0f;
+                                        car.RemoveCurrentStop();
+                                    }
+                                    break;
+
+                                case ElevatorState::DoorsOpen:
+                                    if (car.state_timer >= car.door_open_duration) {
+                                        car.state = ElevatorState::DoorsClosing;
+                                        car.state_timer = 0.0f;
+                                    }
+                                    break;
+
+                                case ElevatorState::DoorsClosing:
+                                    if (car.state_timer >= car.door_transition_duration) {
+                                        car.state = ElevatorState::Idle;
+                                        car.state_timer = 0.0f;
+                                        if (!car.HasStops()) {
+                                            car.travel_direction = 0;
+                                        }
+                                    }
+                                    break;
                             }
-                            break;
-                
-                        case ElevatorState::MovingUp:
-                        case ElevatorState::MovingDown: {
-                            const float direction = (car.state == ElevatorState::MovingUp) ? 1.0f : -1.0f;
-                            const float distance_to_target = std::abs(car.target_floor - car.current_floor);
-                            const float move_amount = car.floors_per_second * delta_time;
-                    
-                            if (move_amount >= distance_to_target) {
-                                car.current_floor = static_cast<float>(car.target_floor);
+                        }
+
+                        batch.Advance();
+
+                        for (std::size_t slot = 0; slot < batch.rows.size(); ++slot) {
+                            ElevatorCar& car = cars[batch.rows[slot]];
+                            car.current_floor = batch.positions[slot];
+                            if (batch.arrived[slot] != 0) {
                                 car.state = ElevatorState::DoorsOpening;
                                 car.state_timer = 0.0f;
-                            } else {
-                                car.current_floor += direction * move_amount;
                             }
-                            break;
                         }
-                
-                        case ElevatorState::DoorsOpening:
-                            if (car.state_timer >= car.door_transition_duration) {
-                                car.state = ElevatorState::DoorsOpen;
-                                car.state_timer = 0.0f;
-                                car.RemoveCurrentStop();
-                            }
-                            break;
-                
-                        case ElevatorState::DoorsOpen:
-                            if (car.state_timer >= car.door_open_duration) {
-                                car.state = ElevatorState::DoorsClosing;
-                                car.state_timer = 0.0f;
-                            }
-                            break;
-                
-                        case ElevatorState::DoorsClosing:
-                            if (car.state_timer >= car.door_transition_duration) {
-                                car.state = ElevatorState::Idle;
-                                car.state_timer = 0.0f;
+                    }
+                });
+    }
+
+    void PersonElevatorSystems::RegisterElevatorDispatchObservers(flecs::world& world) {
+        // Every shaft gets a dispatcher covering the floors it serves
+        world.observer<const ElevatorShaft>()
+                .event(flecs::OnSet)
+                .each([](const flecs::entity shaft_entity, const ElevatorShaft& shaft) {
+                    // Copy the dispatcher first: adding components below can move the shaft's storage
+                    ElevatorDispatcher dispatcher(shaft);
+
+                    if (!shaft_entity.has<ElevatorTelemetry>()) {
+                        shaft_entity.set<ElevatorTelemetry>(ElevatorTelemetry(dispatcher.bottom_floor));
+                    }
+
+                    // Waiting passengers carry over; those on floors the shaft no longer serves re-plan
+                    std::vector<std::uint64_t> stranded;
+                    if (shaft_entity.has<ElevatorDispatcher>()) {
+                        const auto& existing = shaft_entity.get<ElevatorDispatcher>();
+                        if (existing.bottom_floor == dispatcher.bottom_floor && existing.top_floor == dispatcher.top_floor &&
+                            existing.served_floors.ToVector() == dispatcher.served_floors.ToVector()) {
+                            return;
+                        }
+
+                        for (int floor = existing.bottom_floor; floor <= existing.top_floor; ++floor) {
+                            for (const bool going_up : {true, false}) {
+                                const HallCall* old_call = existing.GetCall(floor, going_up);
+                                if (old_call == nullptr) continue;
+
+                                HallCall* new_call = dispatcher.GetCall(floor, going_up);
+                                for (const auto& queued : old_call->queue) {
+                                    if (new_call != nullptr) {
+                                        new_call->queue.push_back(queued);
+                                    } else {
+                                        stranded.push_back(queued.person_id);
+                                    }
+                                }
                             }
-                            break;
+                        }
+                    }
+
+                    const std::uint64_t shaft_id = shaft_entity.id();
+                    shaft_entity.world().each([&](const flecs::entity car_entity, const ElevatorCar& car) {
+                        if (car.shaft_entity_id == shaft_id) {
+                            dispatcher.AddCar(car_entity.id());
+                        }
+                    });
+                    shaft_entity.set<ElevatorDispatcher>(dispatcher);
+
+                    for (const std::uint64_t person_id : stranded) {
+                        const auto person_entity = shaft_entity.world().entity(person_id);
+                        if (person_entity.is_alive()) {
+                            person_entity.remove<PersonElevatorRequest>();
+                            person_entity.remove<TripItinerary>();
+                        }
+                    }
+                });
+
+        world.observer<const ElevatorCar>()
+                .event(flecs::OnSet)
+                .each([](const flecs::entity car_entity, const ElevatorCar& car) {
+                    const auto shaft_entity = car_entity.world().entity(car.shaft_entity_id);
+                    if (shaft_entity.is_valid() && shaft_entity.has<ElevatorDispatcher>()) {
+                        shaft_entity.get_mut<ElevatorDispatcher>().AddCar(car_entity.id());
+                    }
+                });
+
+        world.observer<const ElevatorCar>()
+                .event(flecs::OnRemove)
+                .each([](const flecs::entity car_entity, const ElevatorCar& car) {
+                    const auto shaft_entity = car_entity.world().entity(car.shaft_entity_id);
+                    if (shaft_entity.is_alive() && shaft_entity.has<ElevatorDispatcher>()) {
+                        shaft_entity.get_mut<ElevatorDispatcher>().RemoveCar(car_entity.id());
+                    }
+                });
+
+        // People who leave the hall (despawned, rerouted) no longer hold the call open
+        world.observer<const PersonElevatorRequest>()
+                .event(flecs::OnRemove)
+                .each([](const flecs::entity person_entity, const PersonElevatorRequest& request) {
+                    if (!request.hall_call_registered || request.riding) return;
+
+                    const auto shaft_entity = person_entity.world().entity(request.shaft_entity_id);
+                    if (shaft_entity.is_alive() && shaft_entity.has<ElevatorDispatcher>()) {
+                        shaft_entity.get_mut<ElevatorDispatcher>().CancelPassenger(
+                            request.call_floor, request.IsGoingUp(), person_entity.id());
                     }
                 });
     }
 
     void PersonElevatorSystems::RegisterElevatorCall(flecs::world& world) {
-        world.system<Person, PersonElevatorRequest>()
+        world.system<const Person, PersonElevatorRequest>()
                 .kind(flecs::OnUpdate)
                 .each([](const flecs::entity person_entity, const Person& person, PersonElevatorRequest& request) {
-                    const float delta_time = person_entity.world().delta_time();
-            
-                    request.wait_time += delta_time;
-            
-                    if (request.car_entity_id == -1 && person.state == PersonState::WaitingForElevator) {
-                        const auto shaft_entity = person_entity.world().entity(request.shaft_entity_id);
-                        if (shaft_entity.is_valid() && shaft_entity.has<ElevatorShaft>()) {
-                            person_entity.world().each<ElevatorCar>([&](const flecs::entity car_entity, ElevatorCar& car) {
-                                if (car.shaft_entity_id == request.shaft_entity_id && 
-                                    request.car_entity_id == -1) {
-                                    request.car_entity_id = static_cast<int>(car_entity.id());
-                                    car.AddStop(request.call_floor);
-                                    car.AddStop(request.destination_floor);
+                    if (request.hall_call_registered || person.state != PersonState::WaitingForElevator) return;
+
+                    // Join the hall queue once the person is standing at the shaft
+                    const flecs::world ecs_world = person_entity.world();
+                    const auto shaft_entity = ecs_world.entity(request.shaft_entity_id);
+                    if (!shaft_entity.is_valid() || !shaft_entity.has<ElevatorDispatcher>()) return;
+
+                    if (!shaft_entity.get_mut<ElevatorDispatcher>().RegisterCall(
+                            request.call_floor, request.IsGoingUp(), person_entity.id(), ecs_world.get_info()->world_time_total)) {
+                        // The shaft stopped serving this floor after the trip was planned; plan again
+                        person_entity.remove<PersonElevatorRequest>();
+                        person_entity.remove<TripItinerary>();
+                        return;
+                    }
+                    request.hall_call_registered = true;
+
+                    if (shaft_entity.has<ElevatorTelemetry>()) {
+                        shaft_entity.get_mut<ElevatorTelemetry>().RecordCallOrigin(CurrentSimHour(ecs_world), request.call_floor);
+                    }
+                });
+    }
+
+    void PersonElevatorSystems::RegisterElevatorDispatch(flecs::world& world) {
+        world.system<ElevatorDispatcher>()
+                .kind(flecs::OnUpdate)
+                .each([](const flecs::entity shaft_entity, ElevatorDispatcher& dispatcher) {
+                    const flecs::world ecs_world = shaft_entity.world();
+
+                    auto GetCar = [&](const std::uint64_t car_id) -> ElevatorCar* {
+                        if (car_id == 0) return nullptr;
+                        const auto car_entity = ecs_world.entity(car_id);
+                        if (!car_entity.is_alive() || !car_entity.has<ElevatorCar>()) return nullptr;
+                        return &car_entity.get_mut<ElevatorCar>();
+                    };
+
+                    for (int floor = dispatcher.bottom_floor; floor <= dispatcher.top_floor; ++floor) {
+                        for (const bool going_up : {true, false}) {
+                            HallCall& call = *dispatcher.GetCall(floor, going_up);
+                            if (!call.IsActive()) continue;
+
+                            // Keep the current assignment while its car is still on the way or loading here
+                            ElevatorCar* assigned = GetCar(call.assigned_car);
+                            float assigned_cost = std::numeric_limits<float>::infinity();
+                            if (assigned != nullptr) {
+                                const bool loading_here = assigned->GetCurrentFloorInt() == floor &&
+                                                          (assigned->state == ElevatorState::DoorsOpening ||
+                                                           assigned->state == ElevatorState::DoorsOpen);
+                                if (loading_here && assigned->HasCapacity()) continue;
+                                if (assigned->HasStop(floor)) {
+                                    assigned_cost = ElevatorDispatcher::EstimateArrivalTime(*assigned, floor, going_up);
+                                }
+                            }
+
+                            std::uint64_t best_car = 0;
+                            float best_cost = std::numeric_limits<float>::infinity();
+                            for (const std::uint64_t car_id : dispatcher.cars) {
+                                const ElevatorCar* car = GetCar(car_id);
+                                if (car == nullptr) continue;
+                                const float cost = ElevatorDispatcher::EstimateArrivalTime(*car, floor, going_up);
+                                if (cost < best_cost) {
+                                    best_cost = cost;
+                                    best_car = car_id;
                                 }
-                            });
+                            }
+
+                            if (best_car == 0 || best_car == call.assigned_car ||
+                                best_cost + dispatcher.reassign_margin >= assigned_cost) {
+                                continue;
+                            }
+
+                            // Rebalance: the losing car drops the stop unless it still needs this floor
+                            if (assigned != nullptr) {
+                                if (assigned->passenger_counts.Get(floor) == 0) {
+                                    assigned->RemoveStop(floor, going_up);
+                                }
+                                dispatcher.total_calls_reassigned++;
+                            }
+
+                            GetCar(best_car)->AddStop(floor, going_up);
+                            call.assigned_car = best_car;
+                            call.assigned_cost = best_cost;
+                            dispatcher.total_calls_assigned++;
                         }
                     }
                 });
     }
 
     void PersonElevatorSystems::RegisterPersonElevatorBoarding(flecs::world& world) {
-        world.system<Person, PersonElevatorRequest>()
+        // Car-centric exchange: while a car's doors are open, its riders for this floor step out,
+        // then the hall queues it is answering here board first come, first served
+        world.system<ElevatorCar>()
                 .kind(flecs::OnUpdate)
-                .each([](const flecs::entity person_entity, Person& person, PersonElevatorRequest& request) {
-                    if (request.car_entity_id == -1) return;
-            
-                    const auto car_entity = person_entity.world().entity(request.car_entity_id);
-                    if (!car_entity.is_valid() || !car_entity.has<ElevatorCar>()) return;
-            
-                    ElevatorCar& car = car_entity.ensure<ElevatorCar>();
-            
-                    if (person.state == PersonState::WaitingForElevator && 
-                        car.state == ElevatorState::DoorsOpen &&
-                        car.GetCurrentFloorInt() == request.call_floor &&
-                        car.HasCapacity()) {
-                        person.state = PersonState::InElevator;
-                        person.current_floor = car.GetCurrentFloorInt();
-                        person.wait_time = 0.0f;
-                        car.current_occupancy++;
-                        car.passenger_destinations.push_back(request.destination_floor);
-                        request.is_boarding = false;
+                .each([](const flecs::entity car_entity, ElevatorCar& car) {
+                    if (car.state != ElevatorState::DoorsOpen) return;
+
+                    const flecs::world ecs_world = car_entity.world();
+                    const int floor = car.GetCurrentFloorInt();
+                    const double now = ecs_world.get_info()->world_time_total;
+                    const auto shaft_entity = ecs_world.entity(car.shaft_entity_id);
+                    ElevatorTelemetry* telemetry = shaft_entity.is_valid() && shaft_entity.has<ElevatorTelemetry>()
+                                                       ? &shaft_entity.get_mut<ElevatorTelemetry>()
+                                                       : nullptr;
+
+                    for (size_t i = 0; i < car.riders.size();) {
+                        const ElevatorCar::Rider rider = car.riders[i];
+                        const auto person_entity = ecs_world.entity(rider.person_id);
+                        const bool gone = !person_entity.is_alive() || !person_entity.has<Person>();
+                        if (!gone && rider.destination_floor != floor) {
+                            ++i;
+                            continue;
+                        }
+
+                        car.riders.erase(car.riders.begin() + static_cast<std::ptrdiff_t>(i));
+                        car.passenger_counts.Remove(rider.destination_floor);
+                        if (!gone) {
+                            if (telemetry != nullptr) {
+                                telemetry->RecordTrip(CurrentSimHour(ecs_world), rider.wait_time,
+                                                      static_cast<float>(now - rider.board_time));
+                            }
+                            AlightRider(person_entity, floor);
+                        }
                     }
-            
-                    if (person.state == PersonState::InElevator &&
-                        car.state == ElevatorState::DoorsOpen &&
-                        car.GetCurrentFloorInt() == request.destination_floor) {
-                        person.current_floor = car.GetCurrentFloorInt();
-                        car.current_occupancy--;
-                
-                        const auto it = std::find(car.passenger_destinations.begin(), 
-                                            car.passenger_destinations.end(), 
-                                            request.destination_floor);
-                        if (it != car.passenger_destinations.end()) {
-                            car.passenger_destinations.erase(it);
+                    car.current_occupancy = static_cast<int>(car.riders.size());
+
+                    if (!shaft_entity.is_valid() || !shaft_entity.has<ElevatorDispatcher>()) return;
+
+                    const float shaft_column = shaft_entity.has<ElevatorShaft>()
+                                                   ? static_cast<float>(shaft_entity.get<ElevatorShaft>().column)
+                                                   : 0.0f;
+                    auto& dispatcher = shaft_entity.get_mut<ElevatorDispatcher>();
+                    for (const bool going_up : {true, false}) {
+                        HallCall* call = dispatcher.GetCall(floor, going_up);
+                        if (call == nullptr || !call->IsActive() ||
+                            (call->assigned_car != 0 && call->assigned_car != car_entity.id())) {
+                            continue;
                         }
-                
-                        person_entity.remove<PersonElevatorRequest>();
-                
-                        if (!person.HasReachedHorizontalDestination()) {
-                            person.state = PersonState::Walking;
-                        } else {
-                            person.state = PersonState::AtDestination;
+
+                        // Only take people heading the way the car leaves; the other queue is served on the way back
+                        const int departure = car.GetTravelDirection();
+                        if (departure != 0 && (departure > 0) != going_up) {
+                            continue;
+                        }
+
+                        while (!call->queue.empty() && car.HasCapacity()) {
+                            const HallCall::QueuedPassenger queued = call->queue.front();
+                            call->queue.pop_front();
+
+                            const auto person_entity = ecs_world.entity(queued.person_id);
+                            if (!person_entity.is_alive() || !person_entity.has<Person>() ||
+                                !person_entity.has<PersonElevatorRequest>()) {
+                                continue;
+                            }
+
+                            auto& person = person_entity.get_mut<Person>();
+                            auto& request = person_entity.get_mut<PersonElevatorRequest>();
+                            person.state = PersonState::InElevator;
+                            person.current_floor = floor;
+                            person.current_column = shaft_column;   // Step in from wherever they stood in the queue
+                            person.wait_time = 0.0f;
+                            request.car_entity_id = car_entity.id();
+                            request.riding = true;
+                            request.wait_time = static_cast<float>(now - queued.call_time);
+
+                            car.riders.push_back({queued.person_id, request.destination_floor, request.wait_time, now});
+                            car.passenger_counts.Add(request.destination_floor);
+                            car.AddStop(request.destination_floor, going_up);
+                            car.current_occupancy++;
+                        }
+
+                        if (call->queue.empty()) {
+                            call->assigned_car = 0;
+                        }
+                    }
+                });
+    }
+
+    void PersonElevatorSystems::RegisterHallQueueLayout(flecs::world& world) {
+        // Queued passengers hold a place in line, shuffling forward as the people ahead board
+        world.system<const ElevatorShaft, const ElevatorDispatcher>()
+                .kind(flecs::OnUpdate)
+                .each([](const flecs::entity shaft_entity, const ElevatorShaft& shaft, const ElevatorDispatcher& dispatcher) {
+                    const flecs::world ecs_world = shaft_entity.world();
+                    if (!ecs_world.has<CrowdDensity>()) return;
+                    const auto& density = ecs_world.get<CrowdDensity>();
+
+                    for (int floor = dispatcher.bottom_floor; floor <= dispatcher.top_floor; ++floor) {
+                        for (const bool going_up : {true, false}) {
+                            const HallCall* call = dispatcher.GetCall(floor, going_up);
+                            if (call == nullptr || !call->IsActive()) continue;
+
+                            int position = 0;
+                            for (const auto& queued : call->queue) {
+                                const auto person_entity = ecs_world.entity(queued.person_id);
+                                if (!person_entity.is_alive() || !person_entity.has<Person>()) continue;
+
+                                auto& person = person_entity.get_mut<Person>();
+                                const float place = density.GetQueueColumn(shaft.column, going_up, position++);
+                                if (person.current_floor != floor ||
+                                    (person.state != PersonState::WaitingForElevator && person.state != PersonState::Walking)) {
+                                    continue;
+                                }
+                                if (std::abs(person.current_column - place) > 0.1f) {
+                                    person.destination_column = place;
+                                    person.state = PersonState::Walking;
+                                }
+                            }
+                        }
+                    }
+                });
+    }
+
+    void PersonElevatorSystems::RegisterElevatorTelemetry(flecs::world& world) {
+        // Car time feeds shaft utilization; trips are recorded as riders step out
+        world.system<const ElevatorCar>()
+                .kind(flecs::OnUpdate)
+                .each([](const flecs::entity car_entity, const ElevatorCar& car) {
+                    const flecs::world ecs_world = car_entity.world();
+                    const auto shaft_entity = ecs_world.entity(car.shaft_entity_id);
+                    if (!shaft_entity.is_valid() || !shaft_entity.has<ElevatorTelemetry>()) return;
+
+                    const bool busy = car.state != ElevatorState::Idle || car.current_occupancy > 0;
+                    shaft_entity.get_mut<ElevatorTelemetry>().RecordCarTime(
+                        CurrentSimHour(ecs_world), ecs_world.delta_time(), busy);
+                });
+    }
+
+    void PersonElevatorSystems::RegisterElevatorParking(flecs::world& world) {
+        // Move cars that have nothing to do towards the floors expected to call next
+        world.system<const ElevatorShaft, const ElevatorDispatcher, const ElevatorTelemetry>()
+                .kind(flecs::OnUpdate)
+                .interval(1.0f)
+                .each([](const flecs::entity shaft_entity, const ElevatorShaft& shaft,
+                         const ElevatorDispatcher& dispatcher, const ElevatorTelemetry& telemetry) {
+                    const flecs::world ecs_world = shaft_entity.world();
+                    if (!ecs_world.has<ElevatorParkingPolicy>()) return;
+                    const auto& policy = ecs_world.get<ElevatorParkingPolicy>();
+                    if (!policy.enabled) return;
+
+                    const double planning_hours = CurrentSimHours(ecs_world) + policy.lookahead_hours;
+                    const int hour_of_day = static_cast<int>(static_cast<std::int64_t>(planning_hours) % 24);
+                    std::vector<int> parking_floors = telemetry.GetBusiestCallFloors(
+                        hour_of_day, static_cast<int>(dispatcher.cars.size()), policy.min_calls);
+                    std::erase_if(parking_floors, [&](const int floor) { return !shaft.ServesFloor(floor); });
+                    if (parking_floors.empty()) return;
+
+                    // Floors a car is already at or heading to need no one else
+                    std::vector<flecs::entity> idle_cars;
+                    for (const std::uint64_t car_id : dispatcher.cars) {
+                        const auto car_entity = ecs_world.entity(car_id);
+                        if (!car_entity.is_alive() || !car_entity.has<ElevatorCar>()) continue;
+
+                        const auto& car = car_entity.get<ElevatorCar>();
+                        const bool idle = car.state == ElevatorState::Idle && !car.HasStops() &&
+                                          car.current_occupancy == 0;
+                        std::erase_if(parking_floors, [&](const int floor) {
+                            return car.HasStop(floor) || (idle && car.GetCurrentFloorInt() == floor);
+                        });
+                        if (idle && car.state_timer >= policy.idle_delay) {
+                            idle_cars.push_back(car_entity);
                         }
                     }
+
+                    auto& mutable_policy = ecs_world.get_mut<ElevatorParkingPolicy>();
+                    for (const int floor : parking_floors) {
+                        if (idle_cars.empty()) break;
+
+                        const auto nearest = std::ranges::min_element(idle_cars, {}, [floor](const flecs::entity car_entity) {
+                            return std::abs(car_entity.get<ElevatorCar>().current_floor - static_cast<float>(floor));
+                        });
+                        nearest->get_mut<ElevatorCar>().AddStop(floor);
+                        idle_cars.erase(nearest);
+                        mutable_policy.total_repositions++;
+                    }
                 });
     }
 
@@ -271,17 +851,38 @@ namespace towerforge::core::Systems {
                             << ", Floor: " << car.current_floor
                             << ", Occupancy: " << car.current_occupancy << "/" << car.max_capacity;
             
-                    if (!car.stop_queue.empty()) {
+                    if (car.HasStops()) {
+                        const std::vector<int> stops = car.GetStops();
                         std::cout << ", Stops: [";
-                        for (size_t i = 0; i < car.stop_queue.size(); i++) {
-                            std::cout << car.stop_queue[i];
-                            if (i < car.stop_queue.size() - 1) std::cout << ", ";
+                        for (size_t i = 0; i < stops.size(); i++) {
+                            std::cout << stops[i];
+                            if (i < stops.size() - 1) std::cout << ", ";
                         }
                         std::cout << "]";
                     }
             
                     std::cout << std::endl;
                 });
+
+        world.system<const ElevatorShaft, const ElevatorTelemetry>()
+                .kind(flecs::OnUpdate)
+                .interval(30.0f)
+                .each([](const flecs::entity e, const ElevatorShaft& shaft, const ElevatorTelemetry& telemetry) {
+                    if (telemetry.total_trips == 0) return;
+
+                    std::cout << "  [Elevator] Shaft " << e.id();
+                    if (!shaft.ServesAllFloors()) {
+                        std::cout << " (express, " << shaft.GetServedFloorCount() << " floors)";
+                    }
+                    std::cout
+                            << " - Trips: " << telemetry.total_trips
+                            << ", Wait p50/p95/p99: " << telemetry.wait_times.GetPercentile(0.50f)
+                            << "/" << telemetry.wait_times.GetPercentile(0.95f)
+                            << "/" << telemetry.wait_times.GetPercentile(0.99f) << "s"
+                            << ", Ride avg: " << telemetry.ride_times.GetMean() << "s"
+                            << ", Utilization: " << static_cast<int>(telemetry.GetUtilization() * 100.0f) << "%"
+                            << std::endl;
+                });
     }
 
 }
@@ -1,13 +1,378 @@
 #include "core/systems/visitor_employee_systems.hpp"
 #include "core/components.hpp"
+#include "core/facility_manager.hpp"
 #include <iostream>
 #include <vector>
-#include <cstring>
 #include <algorithm>
+#include <random>
 
 namespace towerforge::core::Systems {
 
+    namespace {
+
+        /**
+     * @brief Job title and shift hours for facilities that hire job seekers
+     * 
+     * @return false if job seekers cannot be hired at this facility type
+     */
+        bool GetJobDetails(const BuildingComponent::Type type, std::string& job_title,
+                           float& shift_start, float& shift_end) {
+            switch (type) {
+                case BuildingComponent::Type::Office:
+                    job_title = "Office Worker";
+                    shift_start = 9.0f;
+                    shift_end = 17.0f;
+                    return true;
+                case BuildingComponent::Type::RetailShop:
+                    job_title = "Shop Clerk";
+                    shift_start = 10.0f;
+                    shift_end = 19.0f;
+                    return true;
+                case BuildingComponent::Type::Restaurant:
+                    job_title = "Restaurant Staff";
+                    shift_start = 11.0f;
+                    shift_end = 22.0f;
+                    return true;
+                case BuildingComponent::Type::Hotel:
+                    job_title = "Hotel Staff";
+                    shift_start = 8.0f;
+                    shift_end = 20.0f;
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        bool IsHireable(const BuildingComponent::Type type) {
+            std::string job_title;
+            float shift_start = 0.0f;
+            float shift_end = 0.0f;
+            return GetJobDetails(type, job_title, shift_start, shift_end);
+        }
+
+        /**
+     * @brief Tie an employee to a facility and count them against its posting
+     * 
+     * For employees whose EmploymentInfo was set directly rather than through
+     * the job board; employees already tied to a facility are left alone.
+     */
+        void AssignWorkplace(const flecs::world& world, EmploymentInfo& employment, const std::uint64_t facility_id) {
+            if (employment.workplace_facility_id != 0 || facility_id == 0 || !world.has<JobBoard>()) return;
+            auto& board = world.get_mut<JobBoard>();
+            if (!board.FillPosition(facility_id)) return;
+            employment.workplace_facility_id = facility_id;
+
+            const flecs::entity facility_entity = world.entity(facility_id);
+            if (facility_entity.is_alive() && facility_entity.has<BuildingComponent>()) {
+                facility_entity.get_mut<BuildingComponent>().job_openings = board.GetOpenPositions(facility_id);
+            }
+        }
+
+        /**
+     * @brief Give up a visitor's reservation or place at their facility
+     */
+        void ReleaseFacility(const flecs::world& world, VisitorInfo& visitor) {
+            if (visitor.facility_hold != FacilityHold::None && visitor.target_facility_id != 0) {
+                const flecs::entity facility_entity = world.entity(visitor.target_facility_id);
+                if (facility_entity.is_alive() && facility_entity.has<BuildingComponent>()) {
+                    auto& facility = facility_entity.get_mut<BuildingComponent>();
+                    if (visitor.facility_hold == FacilityHold::Reserved) {
+                        facility.CancelReservation();
+                    } else {
+                        facility.Vacate();
+                    }
+                }
+            }
+            visitor.target_facility_id = 0;
+            visitor.facility_hold = FacilityHold::None;
+        }
+
+        /**
+     * @brief Hold a place at a chosen facility until the visitor gets there
+     * 
+     * Any place held elsewhere is given up once the new one is secured; if
+     * the facility is full the visitor keeps what they had.
+     * 
+     * @return false if the facility has no free place
+     */
+        bool ReserveFacility(const flecs::world& world, VisitorInfo& visitor, const flecs::entity facility_entity) {
+            if (visitor.target_facility_id == facility_entity.id() && visitor.facility_hold != FacilityHold::None) {
+                return true;
+            }
+            if (!facility_entity.get_mut<BuildingComponent>().Reserve()) {
+                return false;
+            }
+            ReleaseFacility(world, visitor);
+            visitor.target_facility_id = facility_entity.id();
+            visitor.facility_hold = FacilityHold::Reserved;
+            return true;
+        }
+
+        /**
+     * @brief Turn a visitor's reservation into a place at the facility they arrived at
+     * 
+     * Visitors who arrive without a reservation, or somewhere other than the
+     * facility they reserved, take a free place at the facility they are
+     * standing in, found through the FacilityTypeIndex.
+     * 
+     * @return false if the facility they are standing in is full
+     */
+        bool OccupyFacility(const flecs::world& world, const Person& person, VisitorInfo& visitor) {
+            if (visitor.facility_hold == FacilityHold::Occupying) return true;
+
+            if (visitor.facility_hold == FacilityHold::Reserved) {
+                const flecs::entity facility_entity = world.entity(visitor.target_facility_id);
+                if (facility_entity.is_alive() && facility_entity.has<BuildingComponent>() &&
+                    facility_entity.get<BuildingComponent>().Contains(person.current_floor, person.current_column)) {
+                    facility_entity.get_mut<BuildingComponent>().ClaimReservation();
+                    visitor.facility_hold = FacilityHold::Occupying;
+                    return true;
+                }
+                ReleaseFacility(world, visitor);
+            }
+
+            if (!world.has<FacilityTypeIndex>()) return true;
+            const std::uint64_t facility_id = world.get<FacilityTypeIndex>().FindAt(person.current_floor,
+                                                                                    person.current_column);
+            if (facility_id == 0) return true;
+            const flecs::entity facility_entity = world.entity(facility_id);
+            if (!facility_entity.is_alive() || !facility_entity.has<BuildingComponent>()) return true;
+
+            if (!facility_entity.get_mut<BuildingComponent>().Enter()) {
+                return false;
+            }
+            visitor.target_facility_id = facility_id;
+            visitor.facility_hold = FacilityHold::Occupying;
+            return true;
+        }
+
+        /**
+     * @brief One-time scan that seeds the spawner's live counters
+     * 
+     * Needed when the spawner singleton is created after visitors or facilities
+     * already exist (scene setup, loading a save). Observers keep the counters
+     * current from then on.
+     */
+        void SeedSpawnerCounters(const flecs::world& world, NPCSpawner& spawner) {
+            spawner.ResetCounters();
+            world.each<const VisitorInfo>([&](const VisitorInfo&) {
+                spawner.active_visitor_count++;
+            });
+            world.each<const BuildingComponent>([&](const flecs::entity facility_entity, const BuildingComponent& facility) {
+                spawner.facility_count++;
+                spawner.UpdateVisitableFacility(facility_entity.id(), facility.type);
+            });
+            spawner.counters_initialized = true;
+        }
+
+        /**
+     * @brief Fill in a freshly created visitor's components in place
+     */
+        void InitializeVisitor(const flecs::world& world, const flecs::entity visitor, NPCSpawner& spawner,
+                               const int total_job_openings) {
+            // Rolls share the spawner's seeded generator so runs reproduce
+            std::uniform_int_distribution<int> percent(0, 99);
+            VisitorActivity activity;
+            if (total_job_openings > 0 && percent(spawner.arrival_rng) < 40) {
+                activity = VisitorActivity::JobSeeking;
+            } else {
+                const int r = percent(spawner.arrival_rng);
+                if (r < 60) {
+                    activity = VisitorActivity::Shopping;
+                } else {
+                    activity = VisitorActivity::Visiting;
+                }
+            }
+
+            VisitorArchetype archetype;
+            const int archetype_roll = percent(spawner.arrival_rng);
+            if (archetype_roll < 25) {
+                archetype = VisitorArchetype::BusinessPerson;
+            } else if (archetype_roll < 50) {
+                archetype = VisitorArchetype::Tourist;
+            } else if (archetype_roll < 75) {
+                archetype = VisitorArchetype::Shopper;
+            } else {
+                archetype = VisitorArchetype::Casual;
+            }
+
+            auto& person = visitor.get_mut<Person>();
+            person = Person("Visitor" + std::to_string(spawner.next_visitor_id++), 0, 2.0f, 2.0f, NPCType::Visitor);
+            auto& visitor_info = visitor.get_mut<VisitorInfo>();
+            visitor_info = VisitorInfo(activity);
+            visitor.get_mut<Satisfaction>() = Satisfaction(75.0f);
+            auto& needs = visitor.get_mut<VisitorNeeds>();
+            needs = VisitorNeeds(archetype);
+            needs.InitializeForArchetype(spawner.arrival_rng);
+
+            if ((activity == VisitorActivity::Shopping || activity == VisitorActivity::Visiting)
+                && !spawner.visitable_facilities.empty()) {
+                // A few draws for a facility with room; otherwise they wait in the lobby until a need picks one
+                constexpr int max_draws = 3;
+                std::uniform_int_distribution<size_t> pick(0, spawner.visitable_facilities.size() - 1);
+                for (int draw = 0; draw < max_draws; ++draw) {
+                    const auto target_facility = world.entity(spawner.visitable_facilities[pick(spawner.arrival_rng)]);
+                    if (!target_facility.has<BuildingComponent>() || !ReserveFacility(world, visitor_info, target_facility)) {
+                        continue;
+                    }
+
+                    const auto& building = target_facility.get<BuildingComponent>();
+                    const int target_floor = building.floor;
+                    const float target_column = static_cast<float>(building.column) + (static_cast<float>(building.width) / 2.0f);
+                    person.SetDestination(target_floor, target_column, activity == VisitorActivity::Shopping ? "Shopping" : "Visiting");
+                    visitor_info.target_facility_floor = target_floor;
+                    break;
+                }
+            }
+
+            spawner.total_visitors_spawned++;
+        }
+
+        /**
+     * @brief Get entities for a batch of visitors
+     * 
+     * Pooled visitors are re-enabled first. The remainder is created with a
+     * single bulk operation directly in the visitor archetype; callers fill
+     * every visitor's components in place, so a rush-hour batch costs one
+     * table operation instead of four component adds per visitor.
+     */
+        std::vector<flecs::entity> AcquireVisitorEntities(const flecs::world& world, NPCSpawner& spawner, const int count) {
+            std::vector<flecs::entity> visitors;
+            visitors.reserve(count);
+
+            // Recycle departed visitors first
+            if (world.has<VisitorPool>()) {
+                auto& pool = world.get_mut<VisitorPool>();
+                while (static_cast<int>(visitors.size()) < count) {
+                    const std::uint64_t pooled_id = pool.Acquire();
+                    if (pooled_id == 0) {
+                        break;
+                    }
+                    const flecs::entity visitor = world.entity(pooled_id);
+                    if (!visitor.is_alive()) {
+                        continue;
+                    }
+                    visitor.enable();
+                    spawner.active_visitor_count++;  // Re-enabling doesn't trigger the VisitorInfo observer
+                    visitors.push_back(visitor);
+                }
+            }
+
+            const int created_count = count - static_cast<int>(visitors.size());
+            if (created_count > 0) {
+                ecs_bulk_desc_t desc = {};
+                desc.count = created_count;
+                desc.ids[0] = world.component<Person>().id();
+                desc.ids[1] = world.component<VisitorInfo>().id();
+                desc.ids[2] = world.component<Satisfaction>().id();
+                desc.ids[3] = world.component<VisitorNeeds>().id();
+
+                // The returned array is only valid until the next operation on the world
+                const flecs::entity_t* created = ecs_bulk_init(world.c_ptr(), &desc);
+                for (int i = 0; i < created_count; ++i) {
+                    visitors.push_back(world.entity(created[i]));
+                }
+            }
+            return visitors;
+        }
+
+        void SpawnVisitorBatch(const flecs::world& world, NPCSpawner& spawner, const int count) {
+            const int total_job_openings = world.has<JobBoard>() ? world.get<JobBoard>().total_open_positions : 0;
+            for (const flecs::entity visitor : AcquireVisitorEntities(world, spawner, count)) {
+                InitializeVisitor(world, visitor, spawner, total_job_openings);
+            }
+            spawner.last_batch_size = count;
+        }
+
+        /**
+     * @brief Turn cohort members back into individual visitors carrying the cohort's averages
+     */
+        void MaterializeCohort(const flecs::world& world, NPCSpawner& spawner, const CrowdCohort& cohort, const int count) {
+            std::uniform_int_distribution<int> scatter(-2, 2);
+            for (const flecs::entity visitor : AcquireVisitorEntities(world, spawner, count)) {
+                const float column = std::max(0.0f, cohort.column + static_cast<float>(scatter(spawner.arrival_rng)));
+                visitor.get_mut<Person>() = Person("Visitor" + std::to_string(spawner.next_visitor_id++),
+                                                   cohort.floor, column, 2.0f, NPCType::Visitor);
+
+                auto& visitor_info = visitor.get_mut<VisitorInfo>();
+                visitor_info = VisitorInfo(VisitorActivity::Visiting);
+                visitor_info.visit_duration = std::max(0.0f, visitor_info.max_visit_duration - cohort.remaining_visit_time);
+
+                visitor.get_mut<Satisfaction>() = Satisfaction(cohort.satisfaction);
+                visitor.get_mut<VisitorNeeds>() = cohort.needs;
+            }
+        }
+
+        /**
+     * @brief Retire a departed visitor, returning it to the pool when pooling is enabled
+     */
+        void DespawnVisitor(const flecs::world& world, const flecs::entity visitor) {
+            if (visitor.has<VisitorInfo>()) {
+                ReleaseFacility(world, visitor.get_mut<VisitorInfo>());
+            }
+
+            // Off-duty employees also leave as visitors; they are never recycled
+            if (!world.has<VisitorPool>() || !world.get<VisitorPool>().enabled || visitor.has<EmploymentInfo>()) {
+                visitor.destruct();
+                return;
+            }
+
+            // Drop trip state so a recycled visitor starts clean
+            if (visitor.has<PersonElevatorRequest>()) {
+                visitor.remove<PersonElevatorRequest>();
+            }
+            visitor.remove<TripItinerary>();
+            visitor.remove<StairsTrip>();
+            visitor.remove<Evacuee>();
+            visitor.disable();
+            world.get_mut<VisitorPool>().Release(visitor.id());
+
+            // Disabling doesn't trigger the VisitorInfo observer
+            if (world.has<NPCSpawner>()) {
+                world.get_mut<NPCSpawner>().active_visitor_count--;
+            }
+        }
+
+        /**
+     * @brief Current load and quality of a facility, for utility scoring
+     * 
+     * Load counts occupants and reservations, except the asking visitor's own
+     * place. Broken facilities are not available. Quality is the facility's
+     * satisfaction score when it has one, otherwise the average of its
+     * cleanliness and maintenance.
+     */
+        FacilityTypeIndex::Condition GetFacilityCondition(const flecs::world& world, const std::uint64_t facility_id,
+                                                          const VisitorInfo& visitor) {
+            const flecs::entity facility_entity = world.entity(facility_id);
+            if (!facility_entity.is_alive() || !facility_entity.has<BuildingComponent>()) {
+                return {false, 0, 0.0f};
+            }
+            if (facility_entity.has<MaintenanceStatus>() && facility_entity.get<MaintenanceStatus>().IsBroken()) {
+                return {false, 0, 0.0f};
+            }
+
+            const BuildingComponent& facility = facility_entity.get<BuildingComponent>();
+            int load = facility.current_occupancy + facility.reserved_slots;
+            if (visitor.target_facility_id == facility_id && visitor.facility_hold != FacilityHold::None) {
+                load--;
+            }
+
+            FacilityTypeIndex::Condition condition{true, load, 50.0f};
+            if (facility_entity.has<Satisfaction>()) {
+                condition.quality = facility_entity.get<Satisfaction>().satisfaction_score;
+            } else if (facility_entity.has<FacilityStatus>()) {
+                const FacilityStatus& status = facility_entity.get<FacilityStatus>();
+                condition.quality = (status.cleanliness + status.maintenance_level) / 2.0f;
+            }
+            return condition;
+        }
+
+    }
+
     void VisitorEmployeeSystems::RegisterAll(flecs::world& world) {
+        RegisterJobBoardObservers(world);
+        RegisterFacilityIndexObservers(world);
+        RegisterSpawnerCounterObservers(world);
         RegisterResearchPointsGeneration(world);
         RegisterVisitorNeedsGrowth(world);
         RegisterVisitorNeedsBehavior(world);
@@ -21,6 +386,9 @@ namespace towerforge::core::Systems {
         RegisterVisitorSpawning(world);
         RegisterJobAssignment(world);
         RegisterVisitorCleanup(world);
+        RegisterCrowdAggregation(world);
+        RegisterCrowdCohortUpdate(world);
+        RegisterCrowdMaterialization(world);
     }
 
     void VisitorEmployeeSystems::RegisterResearchPointsGeneration(flecs::world& world) {
@@ -43,12 +411,20 @@ namespace towerforge::core::Systems {
     }
 
     void VisitorEmployeeSystems::RegisterVisitorNeedsGrowth(flecs::world& world) {
+        // Growth is closed-form, so the sweep just brings each table's needs column up to the
+        // current world time with one packed update per visitor; anyone it missed catches up
+        // exactly when next touched
         world.system<VisitorNeeds>()
                 .kind(flecs::OnUpdate)
                 .interval(1.0f)
-                .each([](const flecs::entity e, VisitorNeeds& needs) {
-                    const float delta_time = e.world().delta_time();
-                    needs.UpdateNeeds(delta_time);
+                .run([](flecs::iter& it) {
+                    const double now = it.world().get_info()->world_time_total;
+                    while (it.next()) {
+                        auto needs = it.field<VisitorNeeds>(0);
+                        for (const auto i : it) {
+                            needs[i].CatchUp(now);
+                        }
+                    }
                 });
     }
 
@@ -56,7 +432,7 @@ namespace towerforge::core::Systems {
         world.system<Person, VisitorInfo, VisitorNeeds>()
                 .kind(flecs::OnUpdate)
                 .interval(5.0f)
-                .each([](const flecs::entity visitor_entity, Person& person, VisitorInfo& visitor, const VisitorNeeds& needs) {
+                .each([](const flecs::entity visitor_entity, Person& person, VisitorInfo& visitor, VisitorNeeds& needs) {
                     if (visitor.activity == VisitorActivity::Leaving || 
                         visitor.activity == VisitorActivity::JobSeeking) {
                         return;
@@ -65,59 +441,55 @@ namespace towerforge::core::Systems {
                     if (person.state == PersonState::AtDestination && visitor.is_interacting) {
                         return;
                     }
+
+                    const flecs::world ecs_world = visitor_entity.world();
+                    needs.CatchUp(ecs_world.get_info()->world_time_total);
+                    if (!ecs_world.has<FacilityTypeIndex>()) return;
+                    const FacilityTypeIndex& index = ecs_world.get<FacilityTypeIndex>();
                     
+                    // A facility that refuses the reservation is skipped and the next best is tried
+                    constexpr int max_attempts = 3;
+                    std::uint64_t refused[max_attempts] = {};
+                    const auto get_condition = [&ecs_world, &visitor, &refused](const std::uint64_t facility_id) {
+                        if (std::find(std::begin(refused), std::end(refused), facility_id) != std::end(refused)) {
+                            return FacilityTypeIndex::Condition{false, 0, 0.0f};
+                        }
+                        return GetFacilityCondition(ecs_world, facility_id, visitor);
+                    };
+
+                    // Every pressing need competes; the best facility across all of them wins
                     const float high_need_threshold = 60.0f;
-                    const char* needed_facility_type = nullptr;
-                    
-                    if (needs.hunger > high_need_threshold) {
-                        needed_facility_type = "Restaurant";
-                    } else if (needs.entertainment > high_need_threshold) {
-                        needed_facility_type = (rand() % 2 == 0) ? "Arcade" : "Theater";
-                    } else if (needs.comfort > high_need_threshold) {
-                        needed_facility_type = "Hotel";
-                    } else if (needs.shopping > high_need_threshold) {
-                        needed_facility_type = (rand() % 2 == 0) ? "RetailShop" : "FlagshipStore";
+                    FacilityTypeIndex::Choice choice;
+                    for (int attempt = 0; attempt < max_attempts; ++attempt) {
+                        choice = FacilityTypeIndex::Choice{};
+                        for (std::size_t need = 0; need < VisitorNeeds::need_count; ++need) {
+                            const float level = needs.levels[need];
+                            if (level <= high_need_threshold) continue;
+                            const NeedFacilityTypes& serving = GetNeedFacilityTypes(static_cast<NeedType>(need));
+                            for (std::size_t i = 0; i < serving.count; ++i) {
+                                index.FindBest(serving.types[i], level, person.current_floor, person.current_column,
+                                               get_condition, choice);
+                            }
+                        }
+                        if (!choice.IsValid() || ReserveFacility(ecs_world, visitor, ecs_world.entity(choice.facility_id))) {
+                            break;
+                        }
+                        refused[attempt] = choice.facility_id;
+                        choice = FacilityTypeIndex::Choice{};
                     }
                     
-                    if (needed_facility_type != nullptr) {
-                        flecs::entity target_facility;
-                        int target_floor = -1;
-                        float target_column = -1.0f;
-                        
-                        visitor_entity.world().each([&](const flecs::entity facility_entity, const BuildingComponent& facility) {
-                            if (target_floor != -1) return;
-                            
-                            const char* facility_type_name = nullptr;
-                            switch (facility.type) {
-                                case BuildingComponent::Type::Restaurant: facility_type_name = "Restaurant"; break;
-                                case BuildingComponent::Type::Arcade: facility_type_name = "Arcade"; break;
-                                case BuildingComponent::Type::Theater: facility_type_name = "Theater"; break;
-                                case BuildingComponent::Type::Hotel: facility_type_name = "Hotel"; break;
-                                case BuildingComponent::Type::RetailShop: facility_type_name = "RetailShop"; break;
-                                case BuildingComponent::Type::FlagshipStore: facility_type_name = "FlagshipStore"; break;
-                                default: break;
-                            }
-                            
-                            if (facility_type_name && strcmp(facility_type_name, needed_facility_type) == 0) {
-                                target_facility = facility_entity;
-                                target_floor = facility.floor;
-                                target_column = static_cast<float>(facility.column) + (static_cast<float>(facility.width) / 2.0f);
-                            }
-                        });
+                    if (choice.IsValid()) {
+                        person.SetDestination(choice.floor, choice.column,
+                                              std::string("Seeking ") + FacilityManager::GetTypeName(choice.type));
+                        visitor.target_facility_floor = choice.floor;
+                        visitor.is_interacting = false;
+                        visitor.interaction_time = 0.0f;
                         
-                        if (target_floor != -1) {
-                            person.SetDestination(target_floor, target_column, 
-                                                  std::string("Seeking ") + needed_facility_type);
-                            visitor.target_facility_floor = target_floor;
-                            visitor.is_interacting = false;
-                            visitor.interaction_time = 0.0f;
-                            
-                            if (strcmp(needed_facility_type, "RetailShop") == 0 || 
-                                strcmp(needed_facility_type, "FlagshipStore") == 0) {
-                                visitor.activity = VisitorActivity::Shopping;
-                            } else {
-                                visitor.activity = VisitorActivity::Visiting;
-                            }
+                        if (choice.type == BuildingComponent::Type::RetailShop ||
+                            choice.type == BuildingComponent::Type::FlagshipStore) {
+                            visitor.activity = VisitorActivity::Shopping;
+                        } else {
+                            visitor.activity = VisitorActivity::Visiting;
                         }
                     }
                 });
@@ -136,43 +508,38 @@ namespace towerforge::core::Systems {
                         if (!visitor.is_interacting) {
                             visitor.is_interacting = true;
                             visitor.interaction_time = 0.0f;
-                            visitor.required_interaction_time = 15.0f + (static_cast<float>(rand()) / RAND_MAX) * 15.0f;
+                            // 15-30 seconds, drawn from the spawner's random source when there is one
+                            visitor.required_interaction_time = 22.5f;
+                            if (e.world().has<NPCSpawner>()) {
+                                std::uniform_real_distribution<float> stay(15.0f, 30.0f);
+                                visitor.required_interaction_time = stay(e.world().get_mut<NPCSpawner>().arrival_rng);
+                            }
+                            if (!OccupyFacility(e.world(), person, visitor)) {
+                                // Turned away at a full facility; wait outside until needs pick another
+                                visitor.is_interacting = false;
+                                return;
+                            }
                         }
                         
                         visitor.interaction_time += delta_time;
                         
-                        e.world().each([&](const flecs::entity facility_entity, const BuildingComponent& facility) {
-                            if (facility.floor == person.current_floor &&
-                                person.current_column >= static_cast<float>(facility.column) &&
-                                person.current_column < static_cast<float>(facility.column + facility.width)) {
-                                
-                                const float reduction_per_second = 40.0f / visitor.required_interaction_time;
-                                
-                                switch (facility.type) {
-                                    case BuildingComponent::Type::Restaurant:
-                                        needs.ReduceNeed("Hunger", reduction_per_second * delta_time);
-                                        break;
-                                    case BuildingComponent::Type::Arcade:
-                                    case BuildingComponent::Type::Theater:
-                                        needs.ReduceNeed("Entertainment", reduction_per_second * delta_time);
-                                        break;
-                                    case BuildingComponent::Type::Hotel:
-                                        needs.ReduceNeed("Comfort", reduction_per_second * delta_time);
-                                        break;
-                                    case BuildingComponent::Type::RetailShop:
-                                    case BuildingComponent::Type::FlagshipStore:
-                                        needs.ReduceNeed("Shopping", reduction_per_second * delta_time);
-                                        break;
-                                    default:
-                                        break;
+                        if (visitor.facility_hold == FacilityHold::Occupying) {
+                            needs.CatchUp(e.world().get_info()->world_time_total);
+                            const flecs::entity facility_entity = e.world().entity(visitor.target_facility_id);
+                            if (facility_entity.is_alive() && facility_entity.has<BuildingComponent>()) {
+                                const FacilityNeed& served = GetFacilityNeed(facility_entity.get<BuildingComponent>().type);
+                                if (served.serves_need) {
+                                    const float reduction_per_second = 40.0f / visitor.required_interaction_time;
+                                    needs.ReduceNeed(served.need, reduction_per_second * delta_time);
                                 }
                             }
-                        });
+                        }
                         
                         if (visitor.interaction_time >= visitor.required_interaction_time) {
                             visitor.is_interacting = false;
                             visitor.interaction_time = 0.0f;
                             visitor.time_at_destination = 0.0f;
+                            ReleaseFacility(e.world(), visitor);
                             
                             if (needs.GetHighestNeed() < 30.0f) {
                                 visitor.activity = VisitorActivity::Leaving;
@@ -188,7 +555,7 @@ namespace towerforge::core::Systems {
                 .kind(flecs::OnUpdate)
                 .interval(2.0f)
                 .each([](const flecs::entity e, const VisitorNeeds& needs, Satisfaction& satisfaction) {
-                    const float avg_need = (needs.hunger + needs.entertainment + needs.comfort + needs.shopping) / 4.0f;
+                    const float avg_need = needs.GetAverageNeed();
                     
                     const float target_satisfaction = 100.0f - avg_need;
                     
@@ -219,6 +586,11 @@ namespace towerforge::core::Systems {
                         visitor.activity = VisitorActivity::Leaving;
                         person.SetDestination(0, 5.0f, "Leaving tower");
                     }
+
+                    // Whatever sent them out (time up, needs met, an evacuation), their place is free again
+                    if (visitor.activity == VisitorActivity::Leaving && visitor.facility_hold != FacilityHold::None) {
+                        ReleaseFacility(e.world(), visitor);
+                    }
             
                     person.current_need = visitor.GetActivityString();
                 });
@@ -229,7 +601,7 @@ namespace towerforge::core::Systems {
                 .kind(flecs::OnUpdate)
                 .interval(1.0f)
                 .each([](const flecs::entity e, Person& person, VisitorInfo& visitor, const VisitorNeeds& needs) {
-                    person.current_need = std::string(visitor.GetActivityString()) + " - " + needs.GetHighestNeedType();
+                    person.current_need = std::string(visitor.GetActivityString()) + " - " + VisitorNeeds::GetNeedName(needs.GetHighestNeedType());
                 });
     }
 
@@ -237,7 +609,8 @@ namespace towerforge::core::Systems {
         world.system<Person, EmploymentInfo>()
                 .kind(flecs::OnUpdate)
                 .each([](const flecs::entity e, Person& person, EmploymentInfo& employment) {
-                    if (!e.world().has<TimeManager>()) return;
+                    // Nobody goes back in while the tower is being evacuated
+                    if (!e.world().has<TimeManager>() || e.has<Evacuee>()) return;
                     const TimeManager& time_mgr = e.world().get<TimeManager>();
 
                     const bool should_be_working = employment.ShouldBeWorking(time_mgr.current_hour, time_mgr.current_day);
@@ -272,128 +645,174 @@ namespace towerforge::core::Systems {
                 });
     }
 
+    void VisitorEmployeeSystems::RegisterFacilityIndexObservers(flecs::world& world) {
+        // Facility placed or changed: (re)index it under its type and floor
+        world.observer<const BuildingComponent>()
+                .event(flecs::OnSet)
+                .each([](const flecs::entity facility_entity, const BuildingComponent& facility) {
+                    if (!facility_entity.world().has<FacilityTypeIndex>()) return;
+                    facility_entity.world().get_mut<FacilityTypeIndex>().Add(facility_entity.id(), facility);
+                });
+
+        world.observer<const BuildingComponent>()
+                .event(flecs::OnRemove)
+                .each([](const flecs::entity facility_entity, const BuildingComponent&) {
+                    if (!facility_entity.world().has<FacilityTypeIndex>()) return;
+                    facility_entity.world().get_mut<FacilityTypeIndex>().Remove(facility_entity.id());
+                });
+    }
+
+    void VisitorEmployeeSystems::RegisterJobBoardObservers(flecs::world& world) {
+        // Facility placed or changed: post (or refresh) its positions, then take on any
+        // employees already assigned to its floor and columns without a workplace
+        world.observer<const BuildingComponent>()
+                .event(flecs::OnSet)
+                .each([](const flecs::entity facility_entity, const BuildingComponent& facility) {
+                    const flecs::world world = facility_entity.world();
+                    if (!world.has<JobBoard>()) return;
+                    auto& board = world.get_mut<JobBoard>();
+                    board.PostFacility(facility_entity.id(), facility, IsHireable(facility.type));
+                    if (board.GetPosting(facility_entity.id()) == nullptr) return;
+
+                    world.each([&](EmploymentInfo& employment) {
+                        if (employment.workplace_facility_id == 0 &&
+                            facility.Contains(employment.workplace_floor, static_cast<float>(employment.workplace_column))) {
+                            AssignWorkplace(world, employment, facility_entity.id());
+                        }
+                    });
+                });
+
+        // Facility removed: its posting goes with it
+        world.observer<const BuildingComponent>()
+                .event(flecs::OnRemove)
+                .each([](const flecs::entity facility_entity, const BuildingComponent&) {
+                    if (!facility_entity.world().has<JobBoard>()) return;
+                    auto& board = facility_entity.world().get_mut<JobBoard>();
+                    board.RemoveFacility(facility_entity.id());
+                });
+
+        // Employee placed directly (not hired from the board): find the facility at their
+        // workplace and count the position as filled
+        world.observer<const EmploymentInfo>()
+                .event(flecs::OnSet)
+                .each([](const flecs::entity employee_entity, const EmploymentInfo& employment) {
+                    if (employment.workplace_facility_id != 0) return;
+                    const flecs::world world = employee_entity.world();
+                    if (!world.has<FacilityTypeIndex>()) return;
+                    const std::uint64_t facility_id = world.get<FacilityTypeIndex>().FindAt(
+                        employment.workplace_floor, static_cast<float>(employment.workplace_column));
+                    AssignWorkplace(world, employee_entity.get_mut<EmploymentInfo>(), facility_id);
+                });
+
+        // Employee fired or despawned: reopen their position
+        world.observer<const EmploymentInfo>()
+                .event(flecs::OnRemove)
+                .each([](const flecs::entity employee_entity, const EmploymentInfo& employment) {
+                    if (employment.workplace_facility_id == 0) return;
+                    if (!employee_entity.world().has<JobBoard>()) return;
+                    auto& board = employee_entity.world().get_mut<JobBoard>();
+                    board.ReleasePosition(employment.workplace_facility_id);
+                });
+    }
+
+    void VisitorEmployeeSystems::RegisterSpawnerCounterObservers(flecs::world& world) {
+        world.observer<const VisitorInfo>()
+                .event(flecs::OnAdd)
+                .each([](const flecs::entity visitor_entity, const VisitorInfo&) {
+                    if (!visitor_entity.world().has<NPCSpawner>()) return;
+                    visitor_entity.world().get_mut<NPCSpawner>().active_visitor_count++;
+                });
+
+        world.observer<const VisitorInfo>()
+                .event(flecs::OnRemove)
+                .each([](const flecs::entity visitor_entity, const VisitorInfo&) {
+                    if (!visitor_entity.world().has<NPCSpawner>()) return;
+                    visitor_entity.world().get_mut<NPCSpawner>().active_visitor_count--;
+                });
+
+        world.observer<const BuildingComponent>()
+                .event(flecs::OnAdd)
+                .each([](const flecs::entity facility_entity, const BuildingComponent&) {
+                    if (!facility_entity.world().has<NPCSpawner>()) return;
+                    facility_entity.world().get_mut<NPCSpawner>().facility_count++;
+                });
+
+        // The facility type is only known once the component value is set
+        world.observer<const BuildingComponent>()
+                .event(flecs::OnSet)
+                .each([](const flecs::entity facility_entity, const BuildingComponent& facility) {
+                    if (!facility_entity.world().has<NPCSpawner>()) return;
+                    facility_entity.world().get_mut<NPCSpawner>().UpdateVisitableFacility(facility_entity.id(), facility.type);
+                });
+
+        world.observer<const BuildingComponent>()
+                .event(flecs::OnRemove)
+                .each([](const flecs::entity facility_entity, const BuildingComponent&) {
+                    if (!facility_entity.world().has<NPCSpawner>()) return;
+                    auto& spawner = facility_entity.world().get_mut<NPCSpawner>();
+                    spawner.facility_count--;
+                    spawner.RemoveVisitableFacility(facility_entity.id());
+                });
+    }
+
     void VisitorEmployeeSystems::RegisterJobOpeningTracking(flecs::world& world) {
         world.system<BuildingComponent>()
                 .kind(flecs::OnUpdate)
                 .interval(5.0f)
                 .each([](const flecs::entity facility_entity, BuildingComponent& facility) {
-                    const int required = facility.GetRequiredEmployees();
-                    if (required == 0) {
-                        facility.job_openings = 0;
-                        return;
-                    }
-            
-                    int current_employees = 0;
-                    const auto query = facility_entity.world().query<const Person, const EmploymentInfo>();
-                    query.each([&](flecs::entity e, const Person& person, const EmploymentInfo& emp) {
-                        if (emp.workplace_floor == facility.floor) {
-                            current_employees++;
-                        }
-                    });
-            
-                    facility.job_openings = std::max(0, required - current_employees);
+                    if (!facility_entity.world().has<JobBoard>()) return;
+                    auto& board = facility_entity.world().get_mut<JobBoard>();
+
+                    // Pick up capacity changes made in place, then mirror the board's count
+                    board.PostFacility(facility_entity.id(), facility, IsHireable(facility.type));
+                    facility.job_openings = board.GetOpenPositions(facility_entity.id());
                 });
     }
 
     void VisitorEmployeeSystems::RegisterVisitorSpawning(flecs::world& world) {
-        world.system<NPCSpawner>()
+        // Immediate so the batch can be bulk-created while the spawner is being iterated
+        world.system<NPCSpawner, const TimeManager>()
                 .kind(flecs::OnUpdate)
-                .each([](const flecs::entity e, NPCSpawner& spawner) {
-                    const float delta_time = e.world().delta_time();
-                    spawner.time_since_last_spawn += delta_time;
-            
-                    int active_visitor_count = 0;
-                    const auto visitor_count_query = e.world().query<const Person, const VisitorInfo>();
-                    visitor_count_query.each([&](const flecs::entity, const Person&, const VisitorInfo&) {
-                        active_visitor_count++;
-                    });
-            
-                    if (active_visitor_count >= spawner.max_active_visitors) {
+                .immediate()
+                .each([](const flecs::entity e, NPCSpawner& spawner, const TimeManager& time_mgr) {
+                    const flecs::world ecs_world = e.world();
+                    spawner.last_batch_size = 0;
+
+                    if (!spawner.counters_initialized) {
+                        SeedSpawnerCounters(ecs_world, spawner);
+                    }
+
+                    // No new arrivals while the tower is being evacuated
+                    if (ecs_world.has<Evacuation>() && ecs_world.get<Evacuation>().active) {
                         return;
                     }
-            
-                    int total_job_openings = 0;
-                    int facility_count = 0;
-                    std::vector<flecs::entity> visitable_facilities;
-                    const auto facility_query = e.world().query<const BuildingComponent>();
-                    facility_query.each([&](const flecs::entity facility_entity, const BuildingComponent& facility) {
-                        facility_count++;
-                        total_job_openings += facility.job_openings;
-                        
-                        if (facility.type == BuildingComponent::Type::RetailShop ||
-                            facility.type == BuildingComponent::Type::Restaurant ||
-                            facility.type == BuildingComponent::Type::Arcade ||
-                            facility.type == BuildingComponent::Type::Theater ||
-                            facility.type == BuildingComponent::Type::FlagshipStore) {
-                            visitable_facilities.push_back(facility_entity);
-                        }
-                    });
-            
-                    const float spawn_interval = spawner.GetDynamicSpawnInterval(facility_count);
-            
-                    if (spawner.time_since_last_spawn >= spawn_interval) {
-                        spawner.time_since_last_spawn = 0.0f;
-                
-                        VisitorActivity activity;
-                        if (total_job_openings > 0 && (rand() % 100) < 40) {
-                            activity = VisitorActivity::JobSeeking;
-                        } else {
-                            const int r = rand() % 100;
-                            if (r < 60) {
-                                activity = VisitorActivity::Shopping;
-                            } else {
-                                activity = VisitorActivity::Visiting;
-                            }
-                        }
-                
-                        std::string visitor_name = "Visitor" + std::to_string(spawner.next_visitor_id++);
-                        const auto visitor = e.world().entity(visitor_name.c_str());
-                        visitor.set<Person>({visitor_name, 0, 2.0f, 2.0f, NPCType::Visitor});
-                        visitor.set<VisitorInfo>({activity});
-                        visitor.set<Satisfaction>({75.0f});
-                        
-                        VisitorArchetype archetype;
-                        const int archetype_roll = rand() % 100;
-                        if (archetype_roll < 25) {
-                            archetype = VisitorArchetype::BusinessPerson;
-                        } else if (archetype_roll < 50) {
-                            archetype = VisitorArchetype::Tourist;
-                        } else if (archetype_roll < 75) {
-                            archetype = VisitorArchetype::Shopper;
-                        } else {
-                            archetype = VisitorArchetype::Casual;
-                        }
-                        visitor.set<VisitorNeeds>({archetype});
-                
-                        if ((activity == VisitorActivity::Shopping || activity == VisitorActivity::Visiting) 
-                            && !visitable_facilities.empty()) {
-                            const size_t random_index = static_cast<size_t>(rand()) % visitable_facilities.size();
-                            const auto target_facility = visitable_facilities[random_index];
-                            
-                            if (target_facility.has<BuildingComponent>()) {
-                                const auto& building = target_facility.ensure<BuildingComponent>();
-                                
-                                auto& person_ref = visitor.ensure<Person>();
-                                const int target_floor = building.floor;
-                                const float target_column = static_cast<float>(building.column) + (static_cast<float>(building.width) / 2.0f);
-                                person_ref.SetDestination(target_floor, target_column, activity == VisitorActivity::Shopping ? "Shopping" : "Visiting");
-                                
-                                auto& visitor_info = visitor.ensure<VisitorInfo>();
-                                visitor_info.target_facility_floor = target_floor;
-                                
-                                std::cout << "  [Spawned] " << visitor_name << " (" 
-                                        << (activity == VisitorActivity::Shopping ? "Shopping" : "Visiting")
-                                        << ") heading to Floor " << target_floor << std::endl;
-                            }
-                        } else {
-                            std::cout << "  [Spawned] " << visitor_name << " (" 
-                                    << (activity == VisitorActivity::JobSeeking ? "Job Seeking" : 
-                                            (activity == VisitorActivity::Shopping ? "Shopping" : "Visiting"))
-                                    << ")" << std::endl;
-                        }
-                
-                        spawner.total_visitors_spawned++;
+
+                    // TimeSimulation runs in PreUpdate, so this tick covers [hour - elapsed, hour)
+                    const float hours_elapsed = time_mgr.hours_per_second * time_mgr.simulation_speed * ecs_world.delta_time();
+                    if (hours_elapsed <= 0.0f) {
+                        return;
+                    }
+                    int start_day = time_mgr.current_day;
+                    float start_hour = time_mgr.current_hour - hours_elapsed;
+                    while (start_hour < 0.0f) {
+                        start_hour += 24.0f;
+                        start_day = (start_day + 6) % 7;
                     }
+
+                    const int arrivals = spawner.SampleArrivals(start_day, start_hour, hours_elapsed);
+                    const int cohort_members = ecs_world.has<CrowdSimulation>()
+                        ? ecs_world.get<CrowdSimulation>().GetMemberCount()
+                        : 0;
+                    const int room = spawner.max_active_visitors - spawner.active_visitor_count - cohort_members;
+                    const int batch_size = std::min(arrivals, room);
+                    if (batch_size <= 0) {
+                        return;
+                    }
+
+                    SpawnVisitorBatch(ecs_world, spawner, batch_size);
+
+                    std::cout << "  [Spawned] " << batch_size << " visitors at " << time_mgr.GetTimeString()
+                            << " (" << spawner.active_visitor_count << " active)" << std::endl;
                 });
     }
 
@@ -409,68 +828,48 @@ namespace towerforge::core::Systems {
                     if (person.current_floor != 0 || person.state != PersonState::Idle) {
                         return;
                     }
-            
-                    flecs::entity target_facility;
-                    int target_floor = -1;
-                    int target_column = -1;
+
+                    const flecs::world ecs_world = visitor_entity.world();
+                    if (!ecs_world.has<JobBoard>()) {
+                        return;
+                    }
+
+                    auto& board = ecs_world.get_mut<JobBoard>();
+                    std::uint64_t facility_id = 0;
+                    if (!board.ClaimOpening(facility_id)) {
+                        return;
+                    }
+
+                    const JobBoard::Posting* posting = board.GetPosting(facility_id);
                     std::string job_title;
                     float shift_start = 9.0f;
                     float shift_end = 17.0f;
+                    GetJobDetails(posting->type, job_title, shift_start, shift_end);
 
-                    const auto facility_query = visitor_entity.world().query<BuildingComponent>();
-                    facility_query.each([&](const flecs::entity facility_entity, BuildingComponent& facility) {
-                        if (target_floor != -1 || !facility.HasJobOpenings()) {
-                            return;
-                        }
-                
-                        switch (facility.type) {
-                            case BuildingComponent::Type::Office:
-                                job_title = "Office Worker";
-                                shift_start = 9.0f;
-                                shift_end = 17.0f;
-                                break;
-                            case BuildingComponent::Type::RetailShop:
-                                job_title = "Shop Clerk";
-                                shift_start = 10.0f;
-                                shift_end = 19.0f;
-                                break;
-                            case BuildingComponent::Type::Restaurant:
-                                job_title = "Restaurant Staff";
-                                shift_start = 11.0f;
-                                shift_end = 22.0f;
-                                break;
-                            case BuildingComponent::Type::Hotel:
-                                job_title = "Hotel Staff";
-                                shift_start = 8.0f;
-                                shift_end = 20.0f;
-                                break;
-                            default:
-                                return;
-                        }
-                
-                        target_facility = facility_entity;
-                        target_floor = facility.floor;
-                        target_column = facility.column + (facility.width / 2);
-                        facility.job_openings--;
-                    });
-            
-                    if (target_floor != -1) {
-                        visitor_entity.remove<VisitorInfo>();
-                
-                        const EmploymentInfo employment(job_title, target_floor, target_column, shift_start, shift_end);
-                        visitor_entity.set<EmploymentInfo>(employment);
-                
-                        person.npc_type = NPCType::Employee;
-                        person.current_need = "New hire: " + job_title;
-                
-                        if (visitor_entity.world().has<NPCSpawner>()) {
-                            auto& spawner = visitor_entity.world().get_mut<NPCSpawner>();
-                            spawner.total_employees_hired++;
-                        }
-                
-                        std::cout << "  [Hired] " << person.name << " as " << job_title 
-                                << " on Floor " << target_floor << std::endl;
+                    const int target_floor = posting->floor;
+                    const int target_column = posting->column + (posting->width / 2);
+
+                    const auto facility_entity = ecs_world.entity(facility_id);
+                    if (facility_entity.is_alive() && facility_entity.has<BuildingComponent>()) {
+                        facility_entity.get_mut<BuildingComponent>().job_openings = board.GetOpenPositions(facility_id);
                     }
+
+                    visitor_entity.remove<VisitorInfo>();
+
+                    EmploymentInfo employment(job_title, target_floor, target_column, shift_start, shift_end);
+                    employment.workplace_facility_id = facility_id;
+                    visitor_entity.set<EmploymentInfo>(employment);
+
+                    person.npc_type = NPCType::Employee;
+                    person.current_need = "New hire: " + job_title;
+
+                    if (ecs_world.has<NPCSpawner>()) {
+                        auto& spawner = ecs_world.get_mut<NPCSpawner>();
+                        spawner.total_employees_hired++;
+                    }
+
+                    std::cout << "  [Hired] " << person.name << " as " << job_title 
+                            << " on Floor " << target_floor << std::endl;
                 });
     }
 
@@ -482,8 +881,99 @@ namespace towerforge::core::Systems {
                     if (visitor.activity == VisitorActivity::Leaving && 
                         person.state == PersonState::AtDestination &&
                         person.current_floor == 0) {
-                        e.destruct();
+                        DespawnVisitor(e.world(), e);
+                    }
+                });
+    }
+
+    void VisitorEmployeeSystems::RegisterCrowdAggregation(flecs::world& world) {
+        world.system<CrowdSimulation, const NPCSpawner>()
+                .kind(flecs::OnUpdate)
+                .interval(1.0f)
+                .each([](const flecs::entity e, CrowdSimulation& crowd, const NPCSpawner& spawner) {
+                    if (!crowd.enabled) return;
+
+                    int excess = spawner.active_visitor_count - crowd.population_threshold;
+                    if (excess <= 0) return;
+
+                    const flecs::world ecs_world = e.world();
+                    ecs_world.each([&](const flecs::entity visitor_entity, const Person& person, const VisitorInfo& visitor,
+                                       const VisitorNeeds& needs, const Satisfaction& satisfaction) {
+                        if (excess <= 0) return;
+
+                        // Keep anyone on screen, riding or waiting for elevators, on the stairs, or on their way out
+                        if (crowd.IsFloorVisible(person.current_floor) ||
+                            person.state == PersonState::WaitingForElevator ||
+                            person.state == PersonState::InElevator ||
+                            person.state == PersonState::UsingStairs ||
+                            visitor.activity == VisitorActivity::Leaving ||
+                            visitor_entity.has<PersonElevatorRequest>() ||
+                            visitor_entity.has<StairsTrip>() ||
+                            visitor_entity.has<EmploymentInfo>()) {
+                            return;
+                        }
+
+                        CrowdCohort& cohort = crowd.GetCohort(person.current_floor, needs.archetype);
+                        cohort.Absorb(needs, satisfaction.satisfaction_score,
+                                      std::max(0.0f, visitor.max_visit_duration - visitor.visit_duration),
+                                      person.current_column);
+                        crowd.total_members += 1.0f;
+
+                        DespawnVisitor(ecs_world, visitor_entity);
+                        excess--;
+                    });
+                });
+    }
+
+    void VisitorEmployeeSystems::RegisterCrowdCohortUpdate(flecs::world& world) {
+        world.system<CrowdSimulation>()
+                .kind(flecs::OnUpdate)
+                .interval(1.0f)
+                .each([](CrowdSimulation& crowd) {
+                    constexpr float update_interval = 1.0f;
+
+                    for (size_t slot = 0; slot < crowd.cohorts.size();) {
+                        CrowdCohort& cohort = crowd.cohorts[slot];
+
+                        // Members leave at a steady rate that empties the cohort when the average visit runs out
+                        const float departures = cohort.CatchUp(update_interval);
+                        crowd.total_members -= departures;
+                        crowd.total_departed += departures;
+
+                        if (cohort.count < 0.5f) {
+                            crowd.total_members -= cohort.count;
+                            crowd.RemoveCohort(slot);
+                            continue;
+                        }
+                        ++slot;
+                    }
+                    crowd.total_members = std::max(0.0f, crowd.total_members);
+                });
+    }
+
+    void VisitorEmployeeSystems::RegisterCrowdMaterialization(flecs::world& world) {
+        // Immediate so members can be bulk-created while the crowd singleton is being iterated
+        world.system<CrowdSimulation, NPCSpawner>()
+                .kind(flecs::OnUpdate)
+                .interval(0.5f)
+                .immediate()
+                .each([](const flecs::entity e, CrowdSimulation& crowd, NPCSpawner& spawner) {
+                    // Below the threshold (with some hysteresis) everyone goes back to being an individual
+                    const bool release_all = !crowd.enabled ||
+                        spawner.active_visitor_count + crowd.GetMemberCount() < (crowd.population_threshold * 4) / 5;
+
+                    for (size_t slot = 0; slot < crowd.cohorts.size();) {
+                        const CrowdCohort cohort = crowd.cohorts[slot];
+                        if (!release_all && !crowd.IsFloorVisible(cohort.floor) && !crowd.IsMaterializeRequested(cohort.floor)) {
+                            ++slot;
+                            continue;
+                        }
+
+                        crowd.RemoveCohort(slot);
+                        crowd.total_members = std::max(0.0f, crowd.total_members - cohort.count);
+                        MaterializeCohort(e.world(), spawner, cohort, static_cast<int>(cohort.count + 0.5f));
                     }
+                    crowd.materialize_requests.clear();
                 });
     }
 
@@ -44,6 +44,7 @@ namespace towerforge::core {
         const int new_floor = GetHighestFloorIndex() + 1;
         floors_++;
         grid_[new_floor] = std::vector<GridCell>(columns_);
+        RecordChange(new_floor, 0, columns_);
         return new_floor;
     }
 
@@ -59,6 +60,7 @@ namespace towerforge::core {
         for (int i = 0; i < count; ++i) {
             const int new_floor = first_new_floor + i;
             grid_[new_floor] = std::vector<GridCell>(columns_);
+            RecordChange(new_floor, 0, columns_);
             floors_++;
         }
         return first_new_floor;
@@ -79,6 +81,7 @@ namespace towerforge::core {
     
         floors_--;
         grid_.erase(top_floor);
+        RecordChange(top_floor, 0, columns_);
         return true;
     }
 
@@ -94,6 +97,7 @@ namespace towerforge::core {
         // Add new floor at the bottom
         const int new_basement = ground_floor_index_ - basement_floors_;
         grid_[new_basement] = std::vector<GridCell>(columns_);
+        RecordChange(new_basement, 0, columns_);
     
         return new_basement;
     }
@@ -113,6 +117,7 @@ namespace towerforge::core {
             floors_++;
             const int new_basement = ground_floor_index_ - basement_floors_;
             grid_[new_basement] = std::vector<GridCell>(columns_);
+            RecordChange(new_basement, 0, columns_);
         }
     
         return first_new_basement;
@@ -139,6 +144,7 @@ namespace towerforge::core {
         basement_floors_--;
         floors_--;
         grid_.erase(bottom_floor);
+        RecordChange(bottom_floor, 0, columns_);
         return true;
     }
 
@@ -155,6 +161,7 @@ namespace towerforge::core {
         for (auto& [floor_num, floor_cells] : grid_) {
             floor_cells.resize(columns_);
         }
+        RecordChange(GridChange::ALL_FLOORS, columns_ - 1, 1);
         return columns_ - 1;
     }
 
@@ -172,6 +179,7 @@ namespace towerforge::core {
         for (auto& [floor_num, floor_cells] : grid_) {
             floor_cells.resize(columns_);
         }
+        RecordChange(GridChange::ALL_FLOORS, first_new_column, count);
         return first_new_column;
     }
 
@@ -190,6 +198,7 @@ namespace towerforge::core {
         for (auto& [floor_num, floor_cells] : grid_) {
             floor_cells.pop_back();
         }
+        RecordChange(GridChange::ALL_FLOORS, columns_, 1);
         return true;
     }
 
@@ -220,6 +229,7 @@ namespace towerforge::core {
             grid_[floor][column + i].facility_id = facility_id;
             grid_[floor][column + i].floor_built = true;
         }
+        RecordChange(floor, column, width);
     
         return true;
     }
@@ -244,6 +254,7 @@ namespace towerforge::core {
         for (int i = 0; i < actual_width; ++i) {
             grid_[floor][start_column + i].floor_built = true;
         }
+        RecordChange(floor, start_column, actual_width);
     
         return true;
     }
@@ -312,13 +323,20 @@ namespace towerforge::core {
         bool found = false;
     
         for (auto& [floor_num, floor_cells] : grid_) {
+            int first = -1;
+            int last = -1;
             for (int column = 0; column < columns_; ++column) {
                 if (floor_cells[column].facility_id == facility_id) {
                     floor_cells[column].occupied = false;
                     floor_cells[column].facility_id = -1;
                     found = true;
+                    if (first < 0) first = column;
+                    last = column;
                 }
             }
+            if (first >= 0) {
+                RecordChange(floor_num, first, last - first + 1);
+            }
         }
     
         return found;
@@ -416,6 +434,32 @@ namespace towerforge::core {
                 cell.facility_id = -1;
             }
         }
+        RecordChange(GridChange::ALL_FLOORS, 0, columns_);
+    }
+
+    // Change journal
+
+    bool TowerGrid::GetChangesSince(const std::uint64_t sequence, std::vector<GridChange>& changes) const {
+        changes.clear();
+        if (sequence >= change_sequence_) {
+            return true;
+        }
+
+        // Entries are contiguous, so the oldest kept sequence tells whether any were dropped
+        const bool complete = !journal_.empty() && journal_.front().sequence <= sequence + 1;
+        for (const auto& change : journal_) {
+            if (change.sequence > sequence) {
+                changes.push_back(change);
+            }
+        }
+        return complete;
+    }
+
+    void TowerGrid::RecordChange(const int floor, const int column, const int width) {
+        journal_.push_back({++change_sequence_, floor, column, width});
+        if (journal_.size() > JOURNAL_CAPACITY) {
+            journal_.pop_front();
+        }
     }
 
     // Private helper methods
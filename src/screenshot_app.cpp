@@ -109,7 +109,7 @@ int main(int argc, char* argv[]) {
     elevator_shaft.set<ElevatorShaft>({10, 0, 4, 1});  // Column 10, floors 0-4, 1 car
     
     auto elevator_car = ecs_world.CreateEntity("ElevatorCar");
-    elevator_car.set<ElevatorCar>({static_cast<int>(elevator_shaft.id()), 0, 8});  // Start at floor 0, capacity 8
+    elevator_car.set<ElevatorCar>({elevator_shaft.id(), 0, 8});  // Start at floor 0, capacity 8
     
     // Create some example people using the new Person component
     // Person 1: Spawning in lobby, going to office on floor 1
@@ -348,6 +348,12 @@ int main(int argc, char* argv[]) {
                 case PersonState::AtDestination:
                     person_color = GREEN;
                     break;
+                case PersonState::UsingStairs:
+                    person_color = BROWN;
+                    break;
+                case PersonState::Evacuating:
+                    person_color = RED;
+                    break;
                 default:
                     person_color = WHITE;
                     break;
@@ -0,0 +1,769 @@
+#include "core/ecs_world.hpp"
+#include "core/facility_manager.hpp"
+#include "core/components.hpp"
+#include "core/movement_kernels.hpp"
+#include "core/fast_forward.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace towerforge::core;
+
+// Headless simulation benchmarks
+// Usage: sim_benchmark <scenario> [options]
+
+namespace {
+
+    /**
+ * @brief Temporarily silences std::cout so simulation logging doesn't skew timings
+ */
+    class QuietOutput {
+    public:
+        QuietOutput() { std::cout.setstate(std::ios::failbit); }
+        ~QuietOutput() { std::cout.clear(); }
+    };
+
+    struct VisitorChurnResult {
+        int ticks = 0;
+        double wall_seconds = 0.0;
+        int visitors_spawned = 0;
+        int visitors_despawned = 0;
+        int visitors_recycled = 0;
+        int employees_hired = 0;
+        int peak_active_visitors = 0;
+    };
+
+    /**
+ * @brief Run visitors through a ground-floor tower at a fixed arrival rate
+ *
+ * @param use_pool Recycle departed visitors instead of destroying them
+ * @param sim_hours Simulated hours to run
+ * @param arrivals_per_hour Flat arrival rate across the whole day
+ */
+    VisitorChurnResult RunVisitorChurn(const bool use_pool, const float sim_hours, const float arrivals_per_hour) {
+        constexpr float tick_seconds = 0.1f;
+        constexpr float hours_per_second = 1.0f / 120.0f;  // One sim-hour every 120 simulated seconds
+
+        VisitorChurnResult result;
+        ECSWorld ecs_world;
+        {
+            QuietOutput quiet;
+            ecs_world.Initialize();
+        }
+
+        auto& facility_mgr = ecs_world.GetFacilityManager();
+        facility_mgr.CreateFacility(BuildingComponent::Type::RetailShop, 0, 0);
+        facility_mgr.CreateFacility(BuildingComponent::Type::Restaurant, 0, 4);
+        facility_mgr.CreateFacility(BuildingComponent::Type::Arcade, 0, 10);
+        constexpr int facility_count = 3;
+
+        auto& world = ecs_world.GetWorld();
+        world.set<TimeManager>({hours_per_second});
+        world.get_mut<VisitorPool>().enabled = use_pool;
+
+        NPCSpawner spawner(1.0f / NPCSpawner::GetFacilityDemandMultiplier(facility_count), 100000);
+        std::array<float, 24> flat_rates;
+        flat_rates.fill(arrivals_per_hour);
+        for (int day = 0; day < 7; ++day) {
+            spawner.arrival_profile.SetDailyRates(day, flat_rates);
+        }
+        world.set<NPCSpawner>(spawner);
+
+        const int total_ticks = static_cast<int>(sim_hours / (hours_per_second * tick_seconds));
+        const auto start = std::chrono::steady_clock::now();
+        {
+            QuietOutput quiet;
+            for (int tick = 0; tick < total_ticks; ++tick) {
+                ecs_world.Update(tick_seconds);
+                result.peak_active_visitors = std::max(result.peak_active_visitors,
+                                                       world.get<NPCSpawner>().active_visitor_count);
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const auto& final_spawner = world.get<NPCSpawner>();
+        result.ticks = total_ticks;
+        result.wall_seconds = std::chrono::duration<double>(end - start).count();
+        result.visitors_spawned = final_spawner.total_visitors_spawned;
+        result.employees_hired = final_spawner.total_employees_hired;
+        result.visitors_despawned = final_spawner.total_visitors_spawned - final_spawner.active_visitor_count -
+                                    final_spawner.total_employees_hired;
+        result.visitors_recycled = world.get<VisitorPool>().total_recycled;
+        return result;
+    }
+
+    void PrintVisitorChurn(const char* label, const VisitorChurnResult& result) {
+        const double churn_per_second = (result.visitors_spawned + result.visitors_despawned) / result.wall_seconds;
+        std::cout << std::fixed << std::setprecision(2)
+                << "  " << label << ":\n"
+                << "    wall time:          " << result.wall_seconds << " s (" << result.ticks / result.wall_seconds
+                << " ticks/s)\n"
+                << "    spawned/despawned:  " << result.visitors_spawned << " / " << result.visitors_despawned
+                << " (" << result.visitors_recycled << " recycled, " << result.employees_hired << " hired)\n"
+                << "    peak active:        " << result.peak_active_visitors << "\n"
+                << "    spawn+despawn rate: " << churn_per_second << " per wall-second" << std::endl;
+    }
+
+    int RunVisitorBenchmark(const int argc, char* argv[]) {
+        const float sim_hours = argc > 2 ? std::strtof(argv[2], nullptr) : 8.0f;
+        constexpr float arrivals_per_hour = 1000.0f;
+
+        std::cout << "Visitor spawn/despawn throughput: " << arrivals_per_hour << " arrivals per sim-hour for "
+                << sim_hours << " sim-hours" << std::endl;
+        PrintVisitorChurn("destroy on departure", RunVisitorChurn(false, sim_hours, arrivals_per_hour));
+        PrintVisitorChurn("visitor pool", RunVisitorChurn(true, sim_hours, arrivals_per_hour));
+        return 0;
+    }
+
+    struct ElevatorRushResult {
+        int riders = 0;
+        int delivered = 0;
+        double wall_seconds = 0.0;
+        float clearance_seconds = 0.0f;
+        float average_wait = 0.0f;
+        float p50_wait = 0.0f;
+        float p95_wait = 0.0f;
+        float p99_wait = 0.0f;
+        float average_ride = 0.0f;
+        float utilization = 0.0f;
+        int reassignments = 0;
+    };
+
+    /**
+ * @brief Send a morning rush of riders from the lobby to random floors of one shaft
+ *
+ * @param car_count Cars running in the shaft
+ * @param riders Riders arriving in the lobby, a few every second
+ */
+    ElevatorRushResult RunElevatorRush(const int car_count, const int riders) {
+        constexpr float tick_seconds = 0.1f;
+        constexpr int top_floor = 20;
+        constexpr int shaft_column = 10;
+        constexpr int riders_per_second = 2;
+        constexpr float time_limit = 3600.0f;
+
+        ElevatorRushResult result;
+        result.riders = riders;
+        ECSWorld ecs_world;
+        {
+            QuietOutput quiet;
+            ecs_world.Initialize();
+        }
+
+        auto& world = ecs_world.GetWorld();
+        auto shaft = world.entity();
+        shaft.set<ElevatorShaft>({shaft_column, 0, top_floor, car_count});
+        for (int i = 0; i < car_count; ++i) {
+            world.entity().set<ElevatorCar>({shaft.id(), 0, 8});
+        }
+
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int> floor_dist(1, top_floor);
+        int spawned = 0;
+        float elapsed = 0.0f;
+
+        const auto start = std::chrono::steady_clock::now();
+        {
+            QuietOutput quiet;
+            int tick = 0;
+            while (shaft.get<ElevatorTelemetry>().total_trips < static_cast<std::uint64_t>(riders) &&
+                   elapsed < time_limit) {
+                if (tick % static_cast<int>(1.0f / tick_seconds) == 0) {
+                    for (int i = 0; i < riders_per_second && spawned < riders; ++i, ++spawned) {
+                        Person person("Rider", 0, static_cast<float>(shaft_column), 2.0f, NPCType::Employee);
+                        person.SetDestination(floor_dist(rng), static_cast<float>(shaft_column));
+                        world.entity().set<Person>(person);
+                    }
+                }
+                ecs_world.Update(tick_seconds);
+                elapsed += tick_seconds;
+                tick++;
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        result.wall_seconds = std::chrono::duration<double>(end - start).count();
+        result.clearance_seconds = elapsed;
+        result.reassignments = shaft.get<ElevatorDispatcher>().total_calls_reassigned;
+
+        const auto& telemetry = shaft.get<ElevatorTelemetry>();
+        result.delivered = static_cast<int>(telemetry.total_trips);
+        result.average_wait = telemetry.wait_times.GetMean();
+        result.p50_wait = telemetry.wait_times.GetPercentile(0.50f);
+        result.p95_wait = telemetry.wait_times.GetPercentile(0.95f);
+        result.p99_wait = telemetry.wait_times.GetPercentile(0.99f);
+        result.average_ride = telemetry.ride_times.GetMean();
+        result.utilization = telemetry.GetUtilization();
+        return result;
+    }
+
+    void PrintElevatorRush(const int car_count, const ElevatorRushResult& result) {
+        std::cout << std::fixed << std::setprecision(2)
+                << "  " << car_count << (car_count == 1 ? " car" : " cars") << ":\n"
+                << "    delivered:          " << result.delivered << " / " << result.riders
+                << " in " << result.clearance_seconds << " sim-seconds\n"
+                << "    wait avg:           " << result.average_wait << " s\n"
+                << "    wait p50/p95/p99:   " << result.p50_wait << " / " << result.p95_wait << " / "
+                << result.p99_wait << " s\n"
+                << "    ride avg:           " << result.average_ride << " s\n"
+                << "    car utilization:    " << result.utilization * 100.0f << " %\n"
+                << "    reassigned calls:   " << result.reassignments << "\n"
+                << "    wall time:          " << result.wall_seconds << " s" << std::endl;
+    }
+
+    int RunElevatorBenchmark(const int argc, char* argv[]) {
+        const int riders = argc > 2 ? std::atoi(argv[2]) : 400;
+
+        std::cout << "Elevator dispatch: " << riders << " riders from the lobby of a 21-floor shaft" << std::endl;
+        for (const int car_count : {1, 2, 4}) {
+            PrintElevatorRush(car_count, RunElevatorRush(car_count, riders));
+        }
+        return 0;
+    }
+
+    struct ParkingDayResult {
+        int delivered = 0;
+        float average_wait = 0.0f;
+        float p95_wait = 0.0f;
+        int repositions = 0;
+        double wall_seconds = 0.0;
+    };
+
+    /**
+ * @brief Run office days through one shaft and measure waits on the last day
+ *
+ * Mornings bring riders up from the lobby, evenings take them back down, and
+ * a trickle of inter-floor trips fills the middle of the day. Earlier days
+ * let the parking policy learn where calls come from.
+ *
+ * @param parking Let idle cars park ahead of learned demand
+ * @param days Simulated days; only the last one is measured
+ */
+    ParkingDayResult RunParkingDays(const bool parking, const int days) {
+        constexpr float tick_seconds = 0.1f;
+        constexpr float hours_per_second = 1.0f / 120.0f;  // One sim-hour every 120 simulated seconds
+        constexpr int top_floor = 20;
+        constexpr int shaft_column = 10;
+        constexpr int car_count = 2;
+        constexpr float rush_riders_per_hour = 40.0f;
+        constexpr float midday_riders_per_hour = 10.0f;
+
+        ParkingDayResult result;
+        ECSWorld ecs_world;
+        {
+            QuietOutput quiet;
+            ecs_world.Initialize();
+        }
+
+        auto& world = ecs_world.GetWorld();
+        TimeManager time_mgr(hours_per_second);
+        time_mgr.current_hour = 0.0f;
+        world.set<TimeManager>(time_mgr);
+        world.get_mut<ElevatorParkingPolicy>().enabled = parking;
+
+        auto shaft = world.entity();
+        shaft.set<ElevatorShaft>({shaft_column, 0, top_floor, car_count});
+        for (int i = 0; i < car_count; ++i) {
+            world.entity().set<ElevatorCar>({shaft.id(), 0, 8});
+        }
+
+        std::mt19937 rng(4321);
+        std::uniform_int_distribution<int> floor_dist(1, top_floor);
+        std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+        auto SpawnRider = [&](const int from, const int to) {
+            Person person("Rider", from, static_cast<float>(shaft_column), 2.0f, NPCType::Employee);
+            person.SetDestination(to, static_cast<float>(shaft_column));
+            world.entity().set<Person>(person);
+        };
+
+        const int total_ticks = static_cast<int>(static_cast<float>(days) * 24.0f / (hours_per_second * tick_seconds));
+        const float tick_hours = hours_per_second * tick_seconds;
+        const auto start = std::chrono::steady_clock::now();
+        {
+            QuietOutput quiet;
+            for (int tick = 0; tick < total_ticks; ++tick) {
+                const float hour = world.get<TimeManager>().current_hour;
+                if (hour >= 8.0f && hour < 9.5f && chance(rng) < rush_riders_per_hour * tick_hours) {
+                    SpawnRider(0, floor_dist(rng));
+                } else if (hour >= 16.5f && hour < 18.0f && chance(rng) < rush_riders_per_hour * tick_hours) {
+                    SpawnRider(floor_dist(rng), 0);
+                } else if (hour >= 9.5f && hour < 16.5f && chance(rng) < midday_riders_per_hour * tick_hours) {
+                    const int from = floor_dist(rng);
+                    const int to = floor_dist(rng);
+                    if (from != to) {
+                        SpawnRider(from, to);
+                    }
+                }
+                ecs_world.Update(tick_seconds);
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const auto& telemetry = shaft.get<ElevatorTelemetry>();
+        const LatencyHistogram last_day = telemetry.GetRecentWaitTimes(world.get<TimeManager>().GetAbsoluteHour());
+        result.delivered = static_cast<int>(last_day.count);
+        result.average_wait = last_day.GetMean();
+        result.p95_wait = last_day.GetPercentile(0.95f);
+        result.repositions = world.get<ElevatorParkingPolicy>().total_repositions;
+        result.wall_seconds = std::chrono::duration<double>(end - start).count();
+        return result;
+    }
+
+    void PrintParkingDays(const char* label, const ParkingDayResult& result) {
+        std::cout << std::fixed << std::setprecision(2)
+                << "  " << label << ":\n"
+                << "    last-day trips:     " << result.delivered << "\n"
+                << "    wait avg / p95:     " << result.average_wait << " s / " << result.p95_wait << " s\n"
+                << "    cars repositioned:  " << result.repositions << "\n"
+                << "    wall time:          " << result.wall_seconds << " s" << std::endl;
+    }
+
+    int RunParkingBenchmark(const int argc, char* argv[]) {
+        const int days = std::max(2, argc > 2 ? std::atoi(argv[2]) : 3);
+
+        std::cout << "Idle car parking: " << days << " office days in a 21-floor shaft with 2 cars, last day measured"
+                << std::endl;
+        const ParkingDayResult stay = RunParkingDays(false, days);
+        const ParkingDayResult parked = RunParkingDays(true, days);
+        PrintParkingDays("cars stay at last stop", stay);
+        PrintParkingDays("demand-predictive parking", parked);
+        if (stay.average_wait > 0.0f) {
+            std::cout << "  mean wait change:     " << std::showpos
+                    << (parked.average_wait - stay.average_wait) / stay.average_wait * 100.0f << std::noshowpos
+                    << " %" << std::endl;
+        }
+        return 0;
+    }
+
+    struct RushHourResult {
+        int employees = 0;
+        int seated = 0;
+        int abandoned = 0;
+        int ticks = 0;
+        double wall_seconds = 0.0;
+        float clearance_seconds = 0.0f;
+        LatencyHistogram waits;
+        LatencyHistogram rides;
+        std::vector<float> shaft_utilization;
+    };
+
+    /**
+ * @brief Morning rush in a 60-floor office tower with 4 shafts of 3 cars each
+ *
+ * Employees arrive at the lobby entrance over the first ten minutes, walk to
+ * the nearest shaft and ride up to their desks. The run ends once everyone
+ * is seated (or gave up for lack of a route).
+ *
+ * @param zoned Each shaft serves the lobby plus one 15-floor zone instead of every floor
+ * @param employees Employees arriving in the wave
+ */
+    RushHourResult RunRushHour(const bool zoned, const int employees) {
+        constexpr float tick_seconds = 0.1f;
+        constexpr int office_floors = 60;
+        constexpr int shaft_count = 4;
+        constexpr int cars_per_shaft = 3;
+        constexpr int car_capacity = 12;
+        constexpr int first_shaft_column = 10;
+        constexpr float arrival_window = 600.0f;
+        constexpr float time_limit = 4.0f * 3600.0f;
+
+        RushHourResult result;
+        result.employees = employees;
+        ECSWorld ecs_world;
+        {
+            QuietOutput quiet;
+            ecs_world.Initialize();
+        }
+
+        auto& world = ecs_world.GetWorld();
+        std::vector<flecs::entity> shafts;
+        for (int s = 0; s < shaft_count; ++s) {
+            ElevatorShaft shaft(first_shaft_column + s * 2, 0, office_floors, cars_per_shaft);
+            if (zoned) {
+                constexpr int zone_size = office_floors / shaft_count;
+                std::vector<int> served = {0};
+                for (int floor = 1 + s * zone_size; floor <= (s + 1) * zone_size; ++floor) {
+                    served.push_back(floor);
+                }
+                shaft.SetServedFloors(served);
+            }
+            auto shaft_entity = world.entity();
+            shaft_entity.set<ElevatorShaft>(shaft);
+            for (int c = 0; c < cars_per_shaft; ++c) {
+                world.entity().set<ElevatorCar>({shaft_entity.id(), 0, car_capacity});
+            }
+            shafts.push_back(shaft_entity);
+        }
+
+        std::mt19937 rng(2024);
+        std::uniform_int_distribution<int> floor_dist(1, office_floors);
+        std::uniform_int_distribution<int> desk_dist(2, 30);
+        std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+        const float arrivals_per_tick = static_cast<float>(employees) / arrival_window * tick_seconds;
+        const auto people = world.query<const Person>();
+
+        int spawned = 0;
+        float elapsed = 0.0f;
+        const auto start = std::chrono::steady_clock::now();
+        {
+            QuietOutput quiet;
+            while (elapsed < time_limit) {
+                // Whole arrivals every tick, plus a chance at the fractional remainder
+                int arrivals = static_cast<int>(arrivals_per_tick);
+                if (chance(rng) < arrivals_per_tick - static_cast<float>(arrivals)) {
+                    arrivals++;
+                }
+                for (int i = 0; i < arrivals && spawned < employees; ++i, ++spawned) {
+                    Person person("Employee", 0, 0.0f, 1.5f, NPCType::Employee);
+                    person.SetDestination(floor_dist(rng), static_cast<float>(desk_dist(rng)), "Commuting");
+                    world.entity().set<Person>(person);
+                }
+
+                ecs_world.Update(tick_seconds);
+                elapsed += tick_seconds;
+                result.ticks++;
+
+                // Count who has reached their desk once per sim-second
+                if (spawned == employees && result.ticks % 10 == 0) {
+                    int seated = 0;
+                    int abandoned = 0;
+                    people.each([&](const Person& person) {
+                        if (person.state != PersonState::AtDestination) return;
+                        if (person.current_floor != 0) {
+                            seated++;
+                        } else {
+                            abandoned++;
+                        }
+                    });
+                    result.seated = seated;
+                    result.abandoned = abandoned;
+                    if (seated + abandoned == employees) break;
+                }
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        result.wall_seconds = std::chrono::duration<double>(end - start).count();
+        result.clearance_seconds = elapsed;
+        for (const auto& shaft : shafts) {
+            const auto& telemetry = shaft.get<ElevatorTelemetry>();
+            result.waits.Merge(telemetry.wait_times);
+            result.rides.Merge(telemetry.ride_times);
+            result.shaft_utilization.push_back(telemetry.GetUtilization());
+        }
+        return result;
+    }
+
+    void PrintRushHour(const char* label, const RushHourResult& result) {
+        std::cout << std::fixed << std::setprecision(2)
+                << "  " << label << ":\n"
+                << "    seated:             " << result.seated << " / " << result.employees
+                << " (" << result.abandoned << " without a route)\n"
+                << "    clearance time:     " << result.clearance_seconds << " sim-seconds ("
+                << result.clearance_seconds / 60.0f << " min)\n"
+                << "    sim speed:          " << result.ticks / result.wall_seconds << " ticks/s ("
+                << result.ticks << " ticks in " << result.wall_seconds << " s)\n"
+                << "    wait avg / max:     " << result.waits.GetMean() << " s / " << result.waits.max << " s\n"
+                << "    wait p50/p95/p99:   " << result.waits.GetPercentile(0.50f) << " / "
+                << result.waits.GetPercentile(0.95f) << " / " << result.waits.GetPercentile(0.99f) << " s\n"
+                << "    ride avg:           " << result.rides.GetMean() << " s\n"
+                << "    shaft utilization: ";
+        for (const float utilization : result.shaft_utilization) {
+            std::cout << " " << std::setprecision(0) << utilization * 100.0f << "%";
+        }
+        std::cout << "\n    wait distribution:\n";
+
+        // Fold the histogram buckets into bands that double in width
+        const std::uint32_t total = std::max<std::uint32_t>(result.waits.count, 1);
+        float low = 0.0f;
+        for (const float high : {30.0f, 60.0f, 120.0f, 240.0f, 480.0f, std::numeric_limits<float>::infinity()}) {
+            const std::uint32_t band_count = result.waits.CountBelow(high) - result.waits.CountBelow(low);
+            const std::string band = std::isinf(high)
+                                         ? std::to_string(static_cast<int>(low)) + "+ s"
+                                         : std::to_string(static_cast<int>(low)) + "-" +
+                                           std::to_string(static_cast<int>(high)) + " s";
+            std::cout << "      " << std::left << std::setw(10) << band << std::right
+                    << std::setw(6) << band_count << "  " << std::setprecision(1)
+                    << 100.0f * static_cast<float>(band_count) / static_cast<float>(total) << "%\n";
+            low = high;
+        }
+        std::cout << std::flush;
+    }
+
+    int RunRushHourBenchmark(const int argc, char* argv[]) {
+        const int employees = argc > 2 ? std::atoi(argv[2]) : 3000;
+
+        std::cout << "Morning rush: " << employees
+                << " employees into 60 office floors, 4 shafts x 3 cars, arrivals over 10 sim-minutes" << std::endl;
+        PrintRushHour("every shaft serves every floor", RunRushHour(false, employees));
+        PrintRushHour("zoned shafts (lobby + 15 floors each)", RunRushHour(true, employees));
+        return 0;
+    }
+
+    struct EvacuationResult {
+        int people = 0;
+        int evacuated = 0;
+        int trapped = 0;
+        int ticks = 0;
+        double wall_seconds = 0.0;
+        float time_to_clear = -1.0f;
+        int peak_density = 0;
+    };
+
+    /**
+ * @brief Evacuate a 40-floor, 100-column tower with 4 elevator shafts
+ *
+ * People are scattered over the upper floors, then everyone walks out over
+ * the fire stairs beside each shaft to the exits at either end of the
+ * ground floor.
+ *
+ * @param people People in the tower when the alarm goes off
+ */
+    EvacuationResult RunEvacuation(const int people) {
+        constexpr float tick_seconds = 0.1f;
+        constexpr int floors = 40;
+        constexpr int columns = 100;
+        constexpr float time_limit = 2.0f * 3600.0f;
+
+        EvacuationResult result;
+        result.people = people;
+        ECSWorld ecs_world;
+        {
+            QuietOutput quiet;
+            ecs_world.Initialize();
+        }
+
+        TowerGrid& grid = ecs_world.GetTowerGrid();
+        grid.AddFloors(floors - grid.GetFloorCount());
+        grid.AddColumns(columns - grid.GetColumnCount());
+        for (int floor = 0; floor < floors; ++floor) {
+            grid.BuildFloor(floor);
+        }
+
+        auto& world = ecs_world.GetWorld();
+        for (const int column : {20, 40, 60, 80}) {
+            world.entity().set<ElevatorShaft>({column, 0, floors - 1, 2});
+        }
+
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> floor_dist(1, floors - 1);
+        std::uniform_real_distribution<float> column_dist(0.0f, static_cast<float>(columns) - 0.01f);
+        for (int i = 0; i < people; ++i) {
+            world.entity().set<Person>(Person("Occupant", floor_dist(rng), column_dist(rng), 1.5f, NPCType::Employee));
+        }
+
+        world.get_mut<Evacuation>().Begin();
+        const auto start = std::chrono::steady_clock::now();
+        {
+            QuietOutput quiet;
+            float elapsed = 0.0f;
+            while (elapsed < time_limit) {
+                ecs_world.Update(tick_seconds);
+                elapsed += tick_seconds;
+                result.ticks++;
+                result.peak_density = std::max(result.peak_density, world.get<CrowdDensity>().peak_count);
+                if (world.get<Evacuation>().IsClear()) break;
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const auto& evacuation = world.get<Evacuation>();
+        result.wall_seconds = std::chrono::duration<double>(end - start).count();
+        result.evacuated = evacuation.evacuated;
+        result.trapped = evacuation.trapped;
+        result.time_to_clear = evacuation.time_to_clear;
+        return result;
+    }
+
+    int RunEvacuationBenchmark(const int argc, char* argv[]) {
+        const int people = std::max(1, argc > 2 ? std::atoi(argv[2]) : 20000);
+
+        std::cout << "Evacuation: " << people << " people in a 40-floor, 100-column tower, fire stairs beside 4 shafts"
+                << std::endl;
+        const EvacuationResult result = RunEvacuation(people);
+        std::cout << std::fixed << std::setprecision(2)
+                << "  evacuated:            " << result.evacuated << " / " << result.people
+                << " (" << result.trapped << " without a way out)\n"
+                << "  time to clear:        ";
+        if (result.time_to_clear >= 0.0f) {
+            std::cout << result.time_to_clear << " sim-seconds (" << result.time_to_clear / 60.0f << " min)\n";
+        } else {
+            std::cout << "not cleared\n";
+        }
+        std::cout << "  busiest cell:         " << result.peak_density << " people\n"
+                << "  sim speed:            " << result.ticks / result.wall_seconds << " ticks/s ("
+                << result.ticks << " ticks in " << result.wall_seconds << " s, "
+                << result.wall_seconds * 1000.0 / std::max(1, result.ticks) << " ms/tick)" << std::endl;
+        return 0;
+    }
+
+    /**
+ * @brief Time one movement kernel over repeated ticks of the same walkers
+ *
+ * @return Nanoseconds per element per tick
+ */
+    template <typename Kernel>
+    double TimeMovementKernel(Kernel kernel, const std::vector<float>& start, const std::vector<float>& targets,
+                              const std::vector<float>& steps, const int ticks, std::size_t& arrivals) {
+        std::vector<float> positions = start;
+        std::vector<std::uint8_t> arrived(start.size());
+        arrivals = 0;
+
+        const auto wall_start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < ticks; ++tick) {
+            // Restart the walk every 64 ticks so most elements stay in motion
+            if (tick % 64 == 0) {
+                positions = start;
+            }
+            arrivals += kernel(positions.data(), targets.data(), steps.data(), arrived.data(), positions.size());
+        }
+        const auto wall_end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::nano>(wall_end - wall_start).count() /
+               (static_cast<double>(start.size()) * ticks);
+    }
+
+    int RunKernelBenchmark(const int argc, char* argv[]) {
+        const int count = std::max(1, argc > 2 ? std::atoi(argv[2]) : 100000);
+        constexpr int ticks = 1000;
+
+        // Walkers spread across a 200-column floor at walking pace, 60 ticks per second
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> column(0.0f, 200.0f);
+        std::uniform_real_distribution<float> speed(1.0f, 2.0f);
+        std::vector<float> start(count);
+        std::vector<float> targets(count);
+        std::vector<float> steps(count);
+        for (int i = 0; i < count; ++i) {
+            start[i] = column(rng);
+            targets[i] = column(rng);
+            steps[i] = speed(rng) / 60.0f;
+        }
+
+        std::cout << "Movement kernel: " << count << " walkers x " << ticks << " ticks" << std::endl;
+        std::size_t scalar_arrivals = 0;
+        std::size_t batch_arrivals = 0;
+        const double scalar_ns = TimeMovementKernel(kernels::AdvanceTowardScalar, start, targets, steps, ticks,
+                                                    scalar_arrivals);
+        const double batch_ns = TimeMovementKernel(kernels::AdvanceToward, start, targets, steps, ticks,
+                                                   batch_arrivals);
+
+        std::cout << std::fixed << std::setprecision(3)
+                << "  scalar reference:     " << scalar_ns << " ns/element\n"
+                << "  " << std::left << std::setw(22) << (std::string(kernels::GetKernelName()) + " kernel:")
+                << std::right << batch_ns << " ns/element\n"
+                << "  speedup:              " << std::setprecision(2) << scalar_ns / batch_ns << "x\n"
+                << "  arrivals match:       " << (scalar_arrivals == batch_arrivals ? "yes" : "NO") << std::endl;
+        return scalar_arrivals == batch_arrivals ? 0 : 1;
+    }
+
+    int RunSkipBenchmark(const int argc, char* argv[]) {
+        const float sim_hours = std::max(1.0f, argc > 2 ? std::strtof(argv[2], nullptr) : 24.0f);
+        constexpr float tick_seconds = 0.1f;
+        constexpr float hours_per_second = 1.0f / 120.0f;  // One sim-hour every 120 simulated seconds
+
+        ECSWorld ecs_world;
+        {
+            QuietOutput quiet;
+            ecs_world.Initialize();
+        }
+
+        auto& facility_mgr = ecs_world.GetFacilityManager();
+        facility_mgr.CreateFacility(BuildingComponent::Type::RetailShop, 0, 0);
+        facility_mgr.CreateFacility(BuildingComponent::Type::Restaurant, 0, 4);
+        facility_mgr.CreateFacility(BuildingComponent::Type::Arcade, 0, 10);
+
+        auto& world = ecs_world.GetWorld();
+        world.set<TimeManager>({hours_per_second});
+        world.get_mut<VisitorPool>().enabled = true;
+        NPCSpawner spawner(1.0f / NPCSpawner::GetFacilityDemandMultiplier(3), 100000);
+        std::array<float, 24> flat_rates;
+        flat_rates.fill(500.0f);
+        for (int day = 0; day < 7; ++day) {
+            spawner.arrival_profile.SetDailyRates(day, flat_rates);
+        }
+        world.set<NPCSpawner>(spawner);
+
+        std::cout << "Skip to time: " << sim_hours << " sim-hours of a visited tower in " << tick_seconds
+                << " s steps on a worker thread" << std::endl;
+
+        const double target_hours = world.get<TimeManager>().GetAbsoluteHours() + sim_hours;
+        SimulationFastForward fast_forward;
+        SimulationFastForward::Result result;
+        {
+            QuietOutput quiet;
+            fast_forward.Start(ecs_world, target_hours, tick_seconds);
+            while (fast_forward.IsRunning()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                std::cerr << "\r  progress:             " << static_cast<int>(fast_forward.GetProgress() * 100.0f)
+                        << " %" << std::flush;
+            }
+            std::cerr << std::endl;
+            result = fast_forward.Finish();
+        }
+
+        std::cout << std::fixed << std::setprecision(2)
+                << "  reached target:       " << (result.reached_target ? "yes" : "no") << "\n"
+                << "  steps:                " << result.steps << " (" << result.sim_hours << " sim-hours)\n"
+                << "  wall time:            " << result.wall_seconds << " s\n"
+                << "  throughput:           " << result.GetSimHoursPerWallSecond() << " sim-hours per wall-second ("
+                << result.steps / result.wall_seconds << " steps/s)\n"
+                << "  visitors spawned:     " << world.get<NPCSpawner>().total_visitors_spawned << std::endl;
+        return result.reached_target ? 0 : 1;
+    }
+
+    void PrintUsage() {
+        std::cout << "Usage: sim_benchmark <scenario> [options]\n"
+                << "Scenarios:\n"
+                << "  visitors [sim_hours]   Visitor spawn/despawn throughput at 1,000 arrivals per sim-hour\n"
+                << "  elevators [riders]     Lobby rush wait times with 1, 2 and 4 dispatched cars\n"
+                << "  parking [days]         Office-day waits with and without idle car parking\n"
+                << "  rush [employees]       Morning rush clearance in a 60-floor tower, all-stop vs zoned shafts\n"
+                << "  kernels [walkers]      Scalar vs vectorized batch movement kernel throughput\n"
+                << "  evacuation [people]    Time to clear a 40-floor tower and sim speed while it empties\n"
+                << "  skip [sim_hours]       Skip-to-time throughput on a worker thread, in sim-hours per wall-second\n";
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        PrintUsage();
+        return 1;
+    }
+
+    const std::string scenario = argv[1];
+    if (scenario == "visitors") {
+        return RunVisitorBenchmark(argc, argv);
+    }
+    if (scenario == "elevators") {
+        return RunElevatorBenchmark(argc, argv);
+    }
+    if (scenario == "parking") {
+        return RunParkingBenchmark(argc, argv);
+    }
+    if (scenario == "rush") {
+        return RunRushHourBenchmark(argc, argv);
+    }
+    if (scenario == "kernels") {
+        return RunKernelBenchmark(argc, argv);
+    }
+    if (scenario == "evacuation") {
+        return RunEvacuationBenchmark(argc, argv);
+    }
+    if (scenario == "skip") {
+        return RunSkipBenchmark(argc, argv);
+    }
+
+    PrintUsage();
+    return 1;
+}
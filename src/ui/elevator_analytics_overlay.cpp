@@ -159,6 +159,19 @@ namespace towerforge::ui {
         );
         content_container_->AddChild(std::move(avg_wait_text));
 
+        // Wait time percentiles
+        std::ostringstream percentiles;
+        percentiles << "Wait p50/p95/p99: " << std::fixed << std::setprecision(1)
+                << data_.p50_wait_time << " / " << data_.p95_wait_time << " / " << data_.p99_wait_time << "s";
+        const Color tail_color = data_.p95_wait_time < 30.0f
+                                     ? GREEN
+                                     : (data_.p95_wait_time < 60.0f ? YELLOW : RED);
+        auto percentiles_text = std::make_unique<Text>(
+            0.0f, 0.0f, percentiles.str(), UITheme::FONT_SIZE_SMALL,
+            UITheme::ToEngineColor(tail_color)
+        );
+        content_container_->AddChild(std::move(percentiles_text));
+
         // Busiest Floor
         if (data_.busiest_floor_count > 0) {
             std::ostringstream busiest;
@@ -197,7 +210,13 @@ namespace towerforge::ui {
             for (const auto &elev: data_.elevators) {
                 // Elevator ID
                 std::ostringstream elev_id;
-                elev_id << "Elevator #" << elev.elevator_id;
+                elev_id << "Elevator Shaft #" << elev.elevator_id;
+                const int floor_range = elev.top_floor - elev.bottom_floor + 1;
+                if (elev.served_floor_count > 0 && elev.served_floor_count < floor_range) {
+                    elev_id << " (Express, " << elev.served_floor_count << " of " << floor_range << " floors)";
+                } else {
+                    elev_id << " (Floors " << elev.bottom_floor << "-" << elev.top_floor << ")";
+                }
                 auto elev_id_text = std::make_unique<Text>(
                     0.0f, 0.0f, elev_id.str(), UITheme::FONT_SIZE_SMALL,
                     UITheme::ToEngineColor(SKYBLUE)
@@ -248,6 +267,26 @@ namespace towerforge::ui {
                 );
                 content_container_->AddChild(std::move(wait_text));
 
+                // Wait time percentiles
+                std::ostringstream elev_percentiles;
+                elev_percentiles << "  Wait p50/p95/p99: " << std::fixed << std::setprecision(1)
+                        << elev.p50_wait_time << " / " << elev.p95_wait_time << " / " << elev.p99_wait_time << "s";
+                auto elev_percentiles_text = std::make_unique<Text>(
+                    0.0f, 0.0f, elev_percentiles.str(), UITheme::FONT_SIZE_SMALL,
+                    UITheme::ToEngineColor(LIGHTGRAY)
+                );
+                content_container_->AddChild(std::move(elev_percentiles_text));
+
+                // Ride time and throughput
+                std::ostringstream ride;
+                ride << "  Avg Ride: " << std::fixed << std::setprecision(1)
+                        << elev.average_ride_time << "s, " << elev.trips_per_hour << " trips/hr";
+                auto ride_text = std::make_unique<Text>(
+                    0.0f, 0.0f, ride.str(), UITheme::FONT_SIZE_SMALL,
+                    UITheme::ToEngineColor(LIGHTGRAY)
+                );
+                content_container_->AddChild(std::move(ride_text));
+
                 // Small spacer between elevators
                 auto elev_spacer = std::make_unique<Container>();
                 elev_spacer->SetSize(10, 5);
@@ -501,7 +501,7 @@ namespace towerforge::ui {
 
         RegisterTopic({
             "controls", "Getting Started", "Basic Controls",
-            "ESC - Pause menu | F1 - Toggle help | R - Research tree | N - Notifications | H - History panel | Mouse wheel - Zoom camera | Arrow keys - Pan camera",
+            "ESC - Pause menu | F1 - Toggle help | R - Research tree | N - Notifications | H - History panel | E - Elevator analytics | V - Evacuation drill | T - Skip to 09:00 (Shift+T: Monday) | Mouse wheel - Zoom camera | Arrow keys - Pan camera",
             {"Click on facilities or people to view detailed information", "Left-click to select and place facilities from the build menu", "Right-click to cancel placement mode"},
             true, 1
         });
@@ -518,6 +518,10 @@ namespace towerforge::ui {
         population_analytics_callback_ = std::move(callback);
     }
 
+    void HUD::SetElevatorAnalyticsCallback(std::function<ElevatorAnalytics()> callback) {
+        elevator_analytics_callback_ = std::move(callback);
+    }
+
     void HUD::RequestIncomeAnalytics() const {
         if (income_analytics_callback_) {
             const IncomeBreakdown data = income_analytics_callback_();
@@ -532,6 +536,13 @@ namespace towerforge::ui {
         }
     }
 
+    void HUD::RequestElevatorAnalytics() const {
+        if (elevator_analytics_callback_) {
+            const ElevatorAnalytics data = elevator_analytics_callback_();
+            ShowElevatorAnalytics(data);
+        }
+    }
+
     void HUD::SetActionBarCallback(ActionBarCallback callback) {
         action_bar_callback_ = callback;
 
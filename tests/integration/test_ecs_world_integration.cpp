@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "core/ecs_world.hpp"
 #include "core/components.hpp"
+#include "core/fast_forward.hpp"
+#include "core/offline_catch_up.hpp"
 
 using namespace towerforge::core;
 
@@ -225,3 +227,392 @@ TEST_F(ECSWorldIntegrationTest, SimulationWithTimeProgression) {
     EXPECT_GE(grid.GetOccupiedCellCount(), initial_occupied);
     EXPECT_TRUE(grid.IsOccupied(0, 0));
 }
+
+TEST_F(ECSWorldIntegrationTest, SpawnerCountersFollowFacilitiesAndVisitors) {
+    ecs_world->Initialize();
+    
+    auto& world = ecs_world->GetWorld();
+    auto& facility_mgr = ecs_world->GetFacilityManager();
+    
+    // Facility placed before the spawner exists is picked up by the seeding scan
+    auto shop = facility_mgr.CreateFacility(BuildingComponent::Type::RetailShop, 1, 0);
+    world.set<TimeManager>({1.0f});
+    world.set<NPCSpawner>({1.0f, 0});  // No room for arrivals, so only hand-made visitors are counted
+    EXPECT_TRUE(ecs_world->Update(0.016f));
+    
+    EXPECT_TRUE(world.get<NPCSpawner>().counters_initialized);
+    EXPECT_EQ(world.get<NPCSpawner>().facility_count, 1);
+    EXPECT_EQ(world.get<NPCSpawner>().visitable_facilities.size(), 1u);
+    
+    // From here on observers keep the counters live
+    auto office = facility_mgr.CreateFacility(BuildingComponent::Type::Office, 2, 0);
+    EXPECT_EQ(world.get<NPCSpawner>().facility_count, 2);
+    EXPECT_EQ(world.get<NPCSpawner>().visitable_facilities.size(), 1u);
+    
+    auto visitor = ecs_world->CreateEntity("CountedVisitor");
+    visitor.set<Person>({"CountedVisitor", 0, 2.0f, 2.0f, NPCType::Visitor});
+    visitor.set<VisitorInfo>({VisitorActivity::Visiting});
+    EXPECT_EQ(world.get<NPCSpawner>().active_visitor_count, 1);
+    
+    visitor.destruct();
+    EXPECT_EQ(world.get<NPCSpawner>().active_visitor_count, 0);
+    
+    EXPECT_TRUE(facility_mgr.RemoveFacility(shop));
+    EXPECT_EQ(world.get<NPCSpawner>().facility_count, 1);
+    EXPECT_TRUE(world.get<NPCSpawner>().visitable_facilities.empty());
+    EXPECT_TRUE(office.is_valid());
+}
+
+TEST_F(ECSWorldIntegrationTest, DepartedVisitorsAreRecycled) {
+    ecs_world->Initialize();
+    
+    auto& world = ecs_world->GetWorld();
+    
+    Person leaving_person("Departing", 0, 5.0f, 2.0f, NPCType::Visitor);
+    leaving_person.state = PersonState::AtDestination;
+    auto visitor = world.entity();
+    visitor.set<Person>(leaving_person);
+    visitor.set<VisitorInfo>({VisitorActivity::Leaving});
+    const auto visitor_id = visitor.id();
+    
+    // Visitor cleanup runs on a 2 second interval
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(ecs_world->Update(1.0f));
+    }
+    
+    EXPECT_TRUE(visitor.is_alive());
+    EXPECT_FALSE(visitor.enabled());
+    ASSERT_EQ(world.get<VisitorPool>().free_visitors.size(), 1u);
+    
+    // The next arrival reuses the pooled entity instead of creating a new one
+    world.set<TimeManager>({1.0f});
+    world.set<NPCSpawner>({100.0f, 1});
+    EXPECT_TRUE(ecs_world->Update(1.0f));
+    
+    EXPECT_EQ(world.get<VisitorPool>().total_recycled, 1);
+    EXPECT_TRUE(world.get<VisitorPool>().free_visitors.empty());
+    EXPECT_TRUE(world.entity(visitor_id).enabled());
+    EXPECT_EQ(world.entity(visitor_id).get<VisitorInfo>().visit_duration, 0.0f);
+    EXPECT_EQ(world.get<NPCSpawner>().active_visitor_count, 1);
+}
+
+TEST_F(ECSWorldIntegrationTest, OffscreenVisitorsFoldIntoCohorts) {
+    ecs_world->Initialize();
+    
+    auto& world = ecs_world->GetWorld();
+    world.set<TimeManager>({1.0f});
+    world.set<NPCSpawner>({1.0f, 0});
+    world.get_mut<CrowdSimulation>().population_threshold = 2;
+    
+    for (int i = 0; i < 6; ++i) {
+        auto visitor = world.entity();
+        visitor.set<Person>({"Crowd", 3, static_cast<float>(i), 2.0f, NPCType::Visitor});
+        visitor.set<VisitorInfo>({VisitorActivity::Visiting});
+        visitor.set<VisitorNeeds>({VisitorArchetype::Casual});
+        visitor.set<Satisfaction>({80.0f});
+    }
+    
+    // Nothing is on screen, so everyone above the threshold joins a cohort
+    EXPECT_TRUE(ecs_world->Update(1.0f));
+    
+    const auto& crowd = world.get<CrowdSimulation>();
+    EXPECT_EQ(world.get<NPCSpawner>().active_visitor_count, 2);
+    EXPECT_EQ(crowd.cohorts.size(), 1u);
+    EXPECT_EQ(crowd.GetMemberCount(), 4);
+    
+    // Scrolling floor 3 into view turns the cohort back into individuals
+    world.get_mut<CrowdSimulation>().SetVisibleFloors(0, 5);
+    EXPECT_TRUE(ecs_world->Update(1.0f));
+    
+    EXPECT_TRUE(world.get<CrowdSimulation>().cohorts.empty());
+    EXPECT_EQ(world.get<CrowdSimulation>().GetMemberCount(), 0);
+    EXPECT_EQ(world.get<NPCSpawner>().active_visitor_count, 6);
+}
+
+TEST_F(ECSWorldIntegrationTest, FacilityTypeIndexFollowsFacilities) {
+    ecs_world->Initialize();
+    
+    auto& world = ecs_world->GetWorld();
+    auto& facility_mgr = ecs_world->GetFacilityManager();
+    
+    auto low = facility_mgr.CreateFacility(BuildingComponent::Type::Restaurant, 1, 0);
+    auto high = facility_mgr.CreateFacility(BuildingComponent::Type::Restaurant, 6, 0);
+    facility_mgr.CreateFacility(BuildingComponent::Type::Arcade, 3, 0);
+    
+    const auto& index = world.get<FacilityTypeIndex>();
+    EXPECT_EQ(index.GetCount(BuildingComponent::Type::Restaurant), 2u);
+    EXPECT_EQ(index.GetCount(BuildingComponent::Type::Arcade), 1u);
+    EXPECT_EQ(index.GetCount(BuildingComponent::Type::Theater), 0u);
+    
+    // Entries stay sorted by floor
+    const auto& restaurants = index.by_type.at(BuildingComponent::Type::Restaurant);
+    EXPECT_EQ(restaurants.front().facility_id, low.id());
+    EXPECT_EQ(restaurants.back().facility_id, high.id());
+    
+    EXPECT_TRUE(facility_mgr.RemoveFacility(low));
+    EXPECT_EQ(world.get<FacilityTypeIndex>().GetCount(BuildingComponent::Type::Restaurant), 1u);
+}
+
+TEST_F(ECSWorldIntegrationTest, FacilityScoringPrefersNearbyFacilitiesWithRoom) {
+    FacilityTypeIndex index;
+    index.Add(1, BuildingComponent(BuildingComponent::Type::Restaurant, 2, 0, 4, 10));
+    index.Add(2, BuildingComponent(BuildingComponent::Type::Restaurant, 5, 0, 4, 10));
+    index.Add(3, BuildingComponent(BuildingComponent::Type::Restaurant, 10, 0, 4, 10));
+    index.Add(4, BuildingComponent(BuildingComponent::Type::Theater, 6, 0, 4, 10));
+    
+    int occupancy_on_five = 0;
+    const auto get_condition = [&](const std::uint64_t facility_id) {
+        return FacilityTypeIndex::Condition{true, facility_id == 2 ? occupancy_on_five : 0, 50.0f};
+    };
+    
+    // The restaurant on the visitor's own floor wins while it has room
+    FacilityTypeIndex::Choice choice;
+    index.FindBest(BuildingComponent::Type::Restaurant, 80.0f, 5, 2.0f, get_condition, choice);
+    EXPECT_EQ(choice.facility_id, 2u);
+    
+    // Once it is full the next nearest one is chosen
+    occupancy_on_five = 10;
+    choice = {};
+    index.FindBest(BuildingComponent::Type::Restaurant, 80.0f, 5, 2.0f, get_condition, choice);
+    EXPECT_EQ(choice.facility_id, 1u);
+    EXPECT_EQ(choice.floor, 2);
+    
+    // A more pressing need for a nearby theater outweighs hunger
+    index.FindBest(BuildingComponent::Type::Theater, 95.0f, 5, 2.0f, get_condition, choice);
+    EXPECT_EQ(choice.facility_id, 4u);
+    EXPECT_EQ(choice.type, BuildingComponent::Type::Theater);
+}
+
+TEST_F(ECSWorldIntegrationTest, HungryVisitorHeadsToNearestRestaurant) {
+    ecs_world->Initialize();
+    
+    auto& world = ecs_world->GetWorld();
+    auto& facility_mgr = ecs_world->GetFacilityManager();
+    facility_mgr.CreateFacility(BuildingComponent::Type::Restaurant, 1, 0);
+    facility_mgr.CreateFacility(BuildingComponent::Type::Restaurant, 8, 0);
+    
+    VisitorNeeds needs(VisitorArchetype::Casual);
+    needs[NeedType::Hunger] = 90.0f;
+    needs[NeedType::Entertainment] = 0.0f;
+    needs[NeedType::Comfort] = 0.0f;
+    needs[NeedType::Shopping] = 0.0f;
+    
+    auto visitor = world.entity();
+    visitor.set<Person>({"Hungry", 7, 2.0f, 2.0f, NPCType::Visitor});
+    visitor.set<VisitorInfo>({VisitorActivity::Visiting});
+    visitor.set<VisitorNeeds>(needs);
+    visitor.set<Satisfaction>({80.0f});
+    
+    // Needs-driven behavior runs on a 5 second interval
+    EXPECT_TRUE(ecs_world->Update(5.0f));
+    
+    EXPECT_EQ(visitor.get<VisitorInfo>().target_facility_floor, 8);
+    EXPECT_EQ(visitor.get<Person>().destination_floor, 8);
+}
+
+TEST_F(ECSWorldIntegrationTest, FacilityReservationsCountAgainstCapacity) {
+    BuildingComponent facility(BuildingComponent::Type::Restaurant, 1, 0, 4, 2);
+    
+    EXPECT_TRUE(facility.Reserve());
+    EXPECT_TRUE(facility.Reserve());
+    EXPECT_FALSE(facility.Reserve());
+    EXPECT_EQ(facility.GetFreeSlots(), 0);
+    
+    facility.ClaimReservation();
+    EXPECT_EQ(facility.current_occupancy, 1);
+    EXPECT_EQ(facility.reserved_slots, 1);
+    
+    facility.CancelReservation();
+    facility.Vacate();
+    EXPECT_EQ(facility.GetFreeSlots(), 2);
+    EXPECT_EQ(facility.current_occupancy, 0);
+}
+
+TEST_F(ECSWorldIntegrationTest, VisitorReservesOccupiesAndReleasesFacility) {
+    ecs_world->Initialize();
+    
+    auto& world = ecs_world->GetWorld();
+    auto restaurant = ecs_world->GetFacilityManager().CreateFacility(BuildingComponent::Type::Restaurant, 3, 0);
+    ASSERT_TRUE(restaurant.is_valid());
+    
+    VisitorNeeds needs(VisitorArchetype::Casual);
+    needs[NeedType::Hunger] = 90.0f;
+    needs[NeedType::Entertainment] = 0.0f;
+    needs[NeedType::Comfort] = 0.0f;
+    needs[NeedType::Shopping] = 0.0f;
+    
+    auto visitor = world.entity();
+    visitor.set<Person>({"Diner", 3, 20.0f, 2.0f, NPCType::Visitor});
+    visitor.set<VisitorInfo>({VisitorActivity::Visiting});
+    visitor.set<VisitorNeeds>(needs);
+    visitor.set<Satisfaction>({80.0f});
+    
+    // Choosing the restaurant holds a place there
+    EXPECT_TRUE(ecs_world->Update(5.0f));
+    EXPECT_EQ(visitor.get<VisitorInfo>().target_facility_id, restaurant.id());
+    EXPECT_EQ(visitor.get<VisitorInfo>().facility_hold, FacilityHold::Reserved);
+    EXPECT_EQ(restaurant.get<BuildingComponent>().reserved_slots, 1);
+    EXPECT_EQ(restaurant.get<BuildingComponent>().current_occupancy, 0);
+    
+    // Arriving turns the reservation into occupancy
+    auto& person = visitor.get_mut<Person>();
+    person.current_column = person.destination_column;
+    person.state = PersonState::AtDestination;
+    EXPECT_TRUE(ecs_world->Update(0.1f));
+    EXPECT_EQ(visitor.get<VisitorInfo>().facility_hold, FacilityHold::Occupying);
+    EXPECT_EQ(restaurant.get<BuildingComponent>().reserved_slots, 0);
+    EXPECT_EQ(restaurant.get<BuildingComponent>().current_occupancy, 1);
+    
+    // Leaving frees the place
+    visitor.get_mut<VisitorInfo>().activity = VisitorActivity::Leaving;
+    EXPECT_TRUE(ecs_world->Update(0.1f));
+    EXPECT_EQ(restaurant.get<BuildingComponent>().current_occupancy, 0);
+    EXPECT_EQ(restaurant.get<BuildingComponent>().reserved_slots, 0);
+}
+
+TEST_F(ECSWorldIntegrationTest, FullFacilityTurnsVisitorsAway) {
+    ecs_world->Initialize();
+    
+    auto& world = ecs_world->GetWorld();
+    auto restaurant = ecs_world->GetFacilityManager().CreateFacility(BuildingComponent::Type::Restaurant, 3, 0);
+    ASSERT_TRUE(restaurant.is_valid());
+    auto& building = restaurant.get_mut<BuildingComponent>();
+    building.current_occupancy = building.capacity;
+    const int capacity = building.capacity;
+    
+    VisitorNeeds needs(VisitorArchetype::Casual);
+    needs[NeedType::Hunger] = 90.0f;
+    needs[NeedType::Entertainment] = 0.0f;
+    needs[NeedType::Comfort] = 0.0f;
+    needs[NeedType::Shopping] = 0.0f;
+    
+    // A hungry visitor finds no place to reserve and stays put
+    auto visitor = world.entity();
+    visitor.set<Person>({"Hungry", 3, 20.0f, 2.0f, NPCType::Visitor});
+    visitor.set<VisitorInfo>({VisitorActivity::Visiting});
+    visitor.set<VisitorNeeds>(needs);
+    visitor.set<Satisfaction>({80.0f});
+    
+    EXPECT_TRUE(ecs_world->Update(5.0f));
+    EXPECT_EQ(visitor.get<VisitorInfo>().facility_hold, FacilityHold::None);
+    EXPECT_EQ(visitor.get<Person>().destination_column, 20.0f);
+    EXPECT_EQ(restaurant.get<BuildingComponent>().reserved_slots, 0);
+    
+    // One who walks in without a reservation is refused at the door
+    auto walk_in = world.entity();
+    walk_in.set<Person>({"Walk-in", 3, 2.0f, 2.0f, NPCType::Visitor});
+    walk_in.set<VisitorInfo>({VisitorActivity::Visiting});
+    walk_in.set<VisitorNeeds>(needs);
+    walk_in.set<Satisfaction>({80.0f});
+    walk_in.get_mut<Person>().state = PersonState::AtDestination;
+    
+    EXPECT_TRUE(ecs_world->Update(0.1f));
+    EXPECT_EQ(walk_in.get<VisitorInfo>().facility_hold, FacilityHold::None);
+    EXPECT_FALSE(walk_in.get<VisitorInfo>().is_interacting);
+    EXPECT_EQ(restaurant.get<BuildingComponent>().current_occupancy, capacity);
+}
+
+TEST_F(ECSWorldIntegrationTest, FastForwardTargetsNextOccurrence) {
+    TimeManager time(1.0f);
+    time.current_week = 1;
+    time.current_day = 2;  // Wednesday
+    time.current_hour = 10.0f;
+    const double now = time.GetAbsoluteHours();
+    
+    // 09:00 has passed today, so the next one is tomorrow
+    EXPECT_DOUBLE_EQ(SimulationFastForward::GetNextTimeOfDay(time, 9.0f), now + 23.0);
+    EXPECT_DOUBLE_EQ(SimulationFastForward::GetNextTimeOfDay(time, 18.0f), now + 8.0);
+    
+    // Monday 09:00 is five days minus an hour away
+    EXPECT_DOUBLE_EQ(SimulationFastForward::GetNextDayOfWeek(time, 0, 9.0f), now + 5 * 24.0 - 1.0);
+    EXPECT_DOUBLE_EQ(SimulationFastForward::GetNextDayOfWeek(time, 2, 9.0f), now + 7 * 24.0 - 1.0);
+    EXPECT_DOUBLE_EQ(SimulationFastForward::GetNextDayOfWeek(time, 2, 12.0f), now + 2.0);
+}
+
+TEST_F(ECSWorldIntegrationTest, FastForwardRunsToTargetOnWorkerThread) {
+    ecs_world->Initialize();
+    
+    auto& world = ecs_world->GetWorld();
+    world.set<TimeManager>({1.0f});
+    const auto& time = world.get<TimeManager>();
+    const double target = SimulationFastForward::GetNextTimeOfDay(time, 20.0f);
+    
+    SimulationFastForward fast_forward;
+    ASSERT_TRUE(fast_forward.Start(*ecs_world, target, 0.1f));
+    EXPECT_FALSE(fast_forward.Start(*ecs_world, target, 0.1f));
+    const auto result = fast_forward.Finish();
+    
+    EXPECT_TRUE(result.reached_target);
+    EXPECT_FALSE(fast_forward.IsRunning());
+    EXPECT_FLOAT_EQ(fast_forward.GetProgress(), 1.0f);
+    EXPECT_GE(world.get<TimeManager>().GetAbsoluteHours(), target);
+    EXPECT_NEAR(result.sim_hours, 12.0, 0.2);
+    EXPECT_NEAR(result.steps, 120, 2);
+    EXPECT_GT(result.GetSimHoursPerWallSecond(), 0.0);
+    
+    // The target is now behind the clock
+    EXPECT_FALSE(fast_forward.Start(*ecs_world, target, 0.1f));
+}
+
+TEST_F(ECSWorldIntegrationTest, FastForwardStopsAtStepCapWhenClockIsPaused) {
+    ecs_world->Initialize();
+    
+    auto& world = ecs_world->GetWorld();
+    world.set<TimeManager>({1.0f});
+    world.get_mut<TimeManager>().simulation_speed = 0.0f;
+    const double target = world.get<TimeManager>().GetAbsoluteHours() + 1.0;
+    
+    const auto result = SimulationFastForward::Run(*ecs_world, target, 0.1f, 50);
+    EXPECT_FALSE(result.reached_target);
+    EXPECT_EQ(result.steps, 50);
+    EXPECT_DOUBLE_EQ(result.sim_hours, 0.0);
+}
+
+TEST_F(ECSWorldIntegrationTest, OfflineCatchUpAdvancesTowerInOnePass) {
+    ecs_world->Initialize();
+    
+    auto& world = ecs_world->GetWorld();
+    world.set<TimeManager>({1.0f / 120.0f});  // One sim-hour every 120 seconds
+    world.set<TowerEconomy>({1000.0f});
+    world.get_mut<TowerEconomy>().last_processed_day = 7;
+    
+    auto office = ecs_world->GetFacilityManager().CreateFacility(BuildingComponent::Type::Office, 0, 0);
+    ASSERT_TRUE(office.is_valid());
+    FacilityEconomics economics(240.0f, 48.0f, 10);
+    economics.current_tenants = 5;
+    office.set<FacilityEconomics>(economics);
+    office.set<Satisfaction>({90.0f});
+    
+    auto visitor = world.entity();
+    VisitorNeeds needs(VisitorArchetype::Casual);
+    needs.levels.fill(10.0f);
+    visitor.set<VisitorNeeds>(needs);
+    
+    // Two sim-days away, starting at 08:00
+    constexpr float away = 2 * 24 * 120.0f;
+    const double start_hours = world.get<TimeManager>().GetAbsoluteHours();
+    const auto result = OfflineCatchUp::Apply(*ecs_world, away);
+    
+    EXPECT_EQ(result.facilities, 1);
+    EXPECT_EQ(result.visitors, 1);
+    EXPECT_NEAR(result.sim_hours, 48.0, 1e-3);
+    EXPECT_EQ(result.days_closed, 2);
+    EXPECT_NEAR(world.get<TimeManager>().GetAbsoluteHours(), start_hours + 48.0, 1e-3);
+    EXPECT_EQ(world.get<TowerEconomy>().last_processed_day, 9);
+    
+    // Tenants fill the office, and the closed days are on the books
+    EXPECT_EQ(office.get<FacilityEconomics>().current_tenants, 10);
+    EXPECT_GT(result.revenue, 0.0f);
+    const auto& economy = world.get<TowerEconomy>();
+    EXPECT_GT(economy.total_revenue, 0.0f);
+    EXPECT_NEAR(economy.total_revenue + economy.daily_revenue, result.revenue, 1e-2f);
+    EXPECT_NEAR(economy.total_expenses + economy.daily_expenses, result.expenses, 1e-2f);
+    
+    // Degradation and needs moved without any ticks, wear at the live frame-step pace
+    EXPECT_LT(office.get<FacilityStatus>().cleanliness, 100.0f);
+    EXPECT_FALSE(office.get<CleanlinessStatus>().NeedsCleaning());
+    EXPECT_FLOAT_EQ(visitor.get<VisitorNeeds>()[NeedType::Hunger], VisitorNeeds::max_level);
+    
+    // Nothing to do for an empty span
+    EXPECT_TRUE(OfflineCatchUp::Apply(*ecs_world, 0.0f).IsEmpty());
+}
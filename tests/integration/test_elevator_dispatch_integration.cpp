@@ -0,0 +1,652 @@
+#include <gtest/gtest.h>
+#include "core/ecs_world.hpp"
+#include "core/components.hpp"
+
+using namespace towerforge::core;
+
+// Integration tests for elevator routing and dispatch
+// These tests verify that the shaft routing table tracks which shafts connect
+// each floor pair, and that hall calls are tracked per floor and direction and
+// assigned to the car with the lowest estimated arrival time
+
+class ElevatorDispatchIntegrationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ecs_world = std::make_unique<ECSWorld>(1920, 1080, 64, 64);
+        ecs_world->Initialize();
+    }
+
+    flecs::entity CreateShaft(const int bottom, const int top, const int column = 5) const {
+        auto shaft = ecs_world->GetWorld().entity();
+        shaft.set<ElevatorShaft>({column, bottom, top, 2});
+        return shaft;
+    }
+
+    flecs::entity CreateStairs(const int bottom, const int column) const {
+        auto stairs = ecs_world->GetWorld().entity();
+        stairs.set<StairsConnector>({bottom, column});
+        return stairs;
+    }
+
+    const ShaftRoutingTable& GetRoutes() const {
+        return ecs_world->GetWorld().get<ShaftRoutingTable>();
+    }
+
+    flecs::entity CreateCar(const flecs::entity shaft, const int floor) const {
+        auto car = ecs_world->GetWorld().entity();
+        car.set<ElevatorCar>({shaft.id(), floor, 8});
+        return car;
+    }
+
+    flecs::entity CreateRider(const int floor, const int destination) const {
+        auto rider = ecs_world->GetWorld().entity();
+        Person person("Rider", floor, 5.0f, 2.0f, NPCType::Visitor);
+        person.SetDestination(destination, 5.0f);
+        rider.set<Person>(person);
+        return rider;
+    }
+
+    void Step(const int ticks) const {
+        for (int i = 0; i < ticks; ++i) {
+            ecs_world->Update(0.1f);
+        }
+    }
+
+    std::unique_ptr<ECSWorld> ecs_world;
+};
+
+TEST_F(ElevatorDispatchIntegrationTest, ShaftGetsDispatcherTrackingItsCars) {
+    auto shaft = CreateShaft(0, 10);
+    auto car_a = CreateCar(shaft, 0);
+    auto car_b = CreateCar(shaft, 10);
+
+    ASSERT_TRUE(shaft.has<ElevatorDispatcher>());
+    const auto& dispatcher = shaft.get<ElevatorDispatcher>();
+    EXPECT_EQ(dispatcher.hall_calls.size(), 22u);
+    ASSERT_EQ(dispatcher.cars.size(), 2u);
+    EXPECT_EQ(dispatcher.cars[0], car_a.id());
+    EXPECT_EQ(dispatcher.cars[1], car_b.id());
+
+    car_b.destruct();
+    EXPECT_EQ(shaft.get<ElevatorDispatcher>().cars.size(), 1u);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, NearestCarAnswersHallCall) {
+    auto shaft = CreateShaft(0, 10);
+    CreateCar(shaft, 0);
+    auto upper_car = CreateCar(shaft, 10);
+
+    CreateRider(9, 2);
+    Step(3);
+
+    const auto& dispatcher = shaft.get<ElevatorDispatcher>();
+    const HallCall* call = dispatcher.GetCall(9, false);
+    ASSERT_NE(call, nullptr);
+    EXPECT_TRUE(call->IsActive());
+    EXPECT_EQ(call->assigned_car, upper_car.id());
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, ArrivalEstimateFollowsSweepDirection) {
+    ElevatorCar car(1, 2, 8);
+    car.state = ElevatorState::MovingUp;
+    car.AddStop(8);
+
+    // A call ahead of the car in its direction is served on the way up
+    const float along = ElevatorDispatcher::EstimateArrivalTime(car, 5, true);
+    const float against = ElevatorDispatcher::EstimateArrivalTime(car, 5, false);
+    EXPECT_LT(along, against);
+
+    // Calls behind the car wait for the reversal
+    const float behind = ElevatorDispatcher::EstimateArrivalTime(car, 1, true);
+    EXPECT_GT(behind, against);
+
+    car.current_occupancy = car.max_capacity;
+    EXPECT_TRUE(std::isinf(ElevatorDispatcher::EstimateArrivalTime(car, 5, true)));
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, FullCarLosesItsCall) {
+    auto shaft = CreateShaft(0, 10);
+    auto first_car = CreateCar(shaft, 6);
+    auto second_car = CreateCar(shaft, 0);
+
+    CreateRider(5, 0);
+    Step(2);
+    ASSERT_EQ(shaft.get<ElevatorDispatcher>().GetAssignedCar(5, false), first_car.id());
+
+    first_car.get_mut<ElevatorCar>().current_occupancy = first_car.get<ElevatorCar>().max_capacity;
+    Step(1);
+
+    EXPECT_EQ(shaft.get<ElevatorDispatcher>().GetAssignedCar(5, false), second_car.id());
+    EXPECT_FALSE(first_car.get<ElevatorCar>().HasStop(5));
+    EXPECT_TRUE(second_car.get<ElevatorCar>().HasStop(5));
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, RiderIsDeliveredAndCallCleared) {
+    auto shaft = CreateShaft(0, 10);
+    CreateCar(shaft, 0);
+
+    auto rider = CreateRider(0, 4);
+    Step(100);
+
+    EXPECT_FALSE(rider.has<PersonElevatorRequest>());
+    EXPECT_EQ(rider.get<Person>().current_floor, 4);
+    EXPECT_FALSE(shaft.get<ElevatorDispatcher>().GetCall(0, true)->IsActive());
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, DepartedWaiterReleasesCall) {
+    auto shaft = CreateShaft(0, 10);
+    CreateCar(shaft, 10);
+
+    auto rider = CreateRider(3, 7);
+    Step(2);
+    ASSERT_TRUE(shaft.get<ElevatorDispatcher>().GetCall(3, true)->IsActive());
+
+    rider.destruct();
+    EXPECT_FALSE(shaft.get<ElevatorDispatcher>().GetCall(3, true)->IsActive());
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, RoutingTableListsConnectingShafts) {
+    auto low_shaft = CreateShaft(0, 10, 5);
+    auto high_shaft = CreateShaft(5, 20, 15);
+    Step(1);
+
+    ASSERT_EQ(GetRoutes().GetCandidates(0, 8).size(), 1u);
+    EXPECT_EQ(GetRoutes().GetCandidates(0, 8)[0].shaft_id, low_shaft.id());
+    ASSERT_EQ(GetRoutes().GetCandidates(12, 6).size(), 1u);
+    EXPECT_EQ(GetRoutes().GetCandidates(12, 6)[0].shaft_id, high_shaft.id());
+    EXPECT_EQ(GetRoutes().GetCandidates(6, 9).size(), 2u);
+    EXPECT_TRUE(GetRoutes().GetCandidates(0, 15).empty());
+    EXPECT_TRUE(GetRoutes().GetCandidates(-3, 4).empty());
+
+    const auto* nearest = GetRoutes().FindNearestShaft(6, 9, 14.0f);
+    ASSERT_NE(nearest, nullptr);
+    EXPECT_EQ(nearest->shaft_id, high_shaft.id());
+    EXPECT_EQ(nearest->column, 15);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, RoutingTableRebuildsOnlyWhenShaftsChange) {
+    auto low_shaft = CreateShaft(0, 10, 5);
+    auto high_shaft = CreateShaft(5, 20, 15);
+    Step(1);
+    const int rebuilds = GetRoutes().rebuild_count;
+
+    Step(5);
+    EXPECT_EQ(GetRoutes().rebuild_count, rebuilds);
+
+    high_shaft.set<ElevatorShaft>({15, 0, 20, 2});
+    Step(1);
+    EXPECT_EQ(GetRoutes().rebuild_count, rebuilds + 1);
+    ASSERT_EQ(GetRoutes().GetCandidates(0, 15).size(), 1u);
+    EXPECT_EQ(GetRoutes().GetCandidates(0, 15)[0].shaft_id, high_shaft.id());
+
+    low_shaft.destruct();
+    Step(1);
+    ASSERT_EQ(GetRoutes().GetCandidates(0, 8).size(), 1u);
+    EXPECT_EQ(GetRoutes().GetCandidates(0, 8)[0].shaft_id, high_shaft.id());
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, WaitingPersonUsesNearestConnectingShaft) {
+    CreateShaft(0, 10, 5);
+    auto far_shaft = CreateShaft(0, 10, 30);
+    Step(1);
+
+    auto rider = ecs_world->GetWorld().entity();
+    Person person("Rider", 2, 28.0f, 2.0f, NPCType::Visitor);
+    person.SetDestination(7, 28.0f);
+    rider.set<Person>(person);
+    Step(2);
+
+    ASSERT_TRUE(rider.has<PersonElevatorRequest>());
+    EXPECT_EQ(rider.get<PersonElevatorRequest>().shaft_entity_id, far_shaft.id());
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, TransferRouteChangesShaftsAtSharedFloor) {
+    auto low_shaft = CreateShaft(0, 10, 5);
+    auto high_shaft = CreateShaft(10, 20, 15);
+    Step(1);
+
+    auto& routes = ecs_world->GetWorld().get_mut<ShaftRoutingTable>();
+    const std::vector<TripLeg> legs = routes.FindRoute(2, 18, 5.0f);
+    ASSERT_EQ(legs.size(), 2u);
+    EXPECT_EQ(legs[0].shaft_id, low_shaft.id());
+    EXPECT_EQ(legs[0].board_floor, 2);
+    EXPECT_EQ(legs[0].alight_floor, 10);
+    EXPECT_EQ(legs[1].shaft_id, high_shaft.id());
+    EXPECT_EQ(legs[1].board_floor, 10);
+    EXPECT_EQ(legs[1].alight_floor, 18);
+    EXPECT_EQ(routes.route_cache.size(), 1u);
+
+    // Moving a shaft drops cached routes
+    high_shaft.set<ElevatorShaft>({15, 12, 20, 2});
+    Step(1);
+    EXPECT_TRUE(GetRoutes().route_cache.empty());
+    EXPECT_TRUE(ecs_world->GetWorld().get_mut<ShaftRoutingTable>().FindRoute(2, 18, 5.0f).empty());
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, RiderTransfersBetweenShafts) {
+    auto low_shaft = CreateShaft(0, 10, 5);
+    auto high_shaft = CreateShaft(10, 20, 15);
+    CreateCar(low_shaft, 0);
+    CreateCar(high_shaft, 20);
+
+    auto rider = ecs_world->GetWorld().entity();
+    Person person("Rider", 2, 5.0f, 2.0f, NPCType::Visitor);
+    person.SetDestination(18, 20.0f);
+    rider.set<Person>(person);
+    Step(600);
+
+    const auto& arrived = rider.get<Person>();
+    EXPECT_EQ(arrived.current_floor, 18);
+    EXPECT_EQ(arrived.state, PersonState::AtDestination);
+    EXPECT_NEAR(arrived.current_column, 20.0f, 0.1f);
+    EXPECT_FALSE(rider.has<TripItinerary>());
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, UnreachableTripIsAbandoned) {
+    CreateShaft(0, 5, 5);
+
+    auto rider = CreateRider(0, 8);
+    Step(3);
+
+    const auto& stranded = rider.get<Person>();
+    EXPECT_EQ(stranded.current_floor, 0);
+    EXPECT_EQ(stranded.state, PersonState::AtDestination);
+    EXPECT_FALSE(rider.has<PersonElevatorRequest>());
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, HallQueueBoardsInArrivalOrderUpToCapacity) {
+    auto shaft = CreateShaft(0, 10);
+    auto car = ecs_world->GetWorld().entity();
+    car.set<ElevatorCar>({shaft.id(), 6, 2});
+
+    auto first = CreateRider(0, 3);
+    Step(2);
+    auto second = CreateRider(0, 4);
+    Step(2);
+    auto third = CreateRider(0, 5);
+    Step(2);
+    ASSERT_EQ(shaft.get<ElevatorDispatcher>().GetCall(0, true)->GetWaitingCount(), 3);
+
+    // Car travels down six floors and opens its doors
+    for (int i = 0; i < 60 && car.get<ElevatorCar>().state != ElevatorState::DoorsOpen; ++i) {
+        Step(1);
+    }
+    ASSERT_EQ(car.get<ElevatorCar>().state, ElevatorState::DoorsOpen);
+
+    EXPECT_EQ(first.get<Person>().state, PersonState::InElevator);
+    EXPECT_EQ(second.get<Person>().state, PersonState::InElevator);
+    EXPECT_EQ(third.get<Person>().state, PersonState::WaitingForElevator);
+
+    const auto& riders = car.get<ElevatorCar>().riders;
+    ASSERT_EQ(riders.size(), 2u);
+    EXPECT_EQ(riders[0].person_id, first.id());
+    EXPECT_EQ(riders[1].person_id, second.id());
+    EXPECT_EQ(shaft.get<ElevatorDispatcher>().GetCall(0, true)->GetWaitingCount(), 1);
+    EXPECT_GT(first.get<PersonElevatorRequest>().wait_time, second.get<PersonElevatorRequest>().wait_time);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, FloorBitsetFindsStopsInBothDirections) {
+    FloorBitset stops;
+    stops.Set(3);
+    stops.Set(70);
+    stops.Set(-5);
+    stops.Set(219);
+
+    EXPECT_EQ(stops.count, 4);
+    EXPECT_EQ(stops.FindNextSet(4), 70);
+    EXPECT_EQ(stops.FindNextSet(71), 219);
+    EXPECT_EQ(stops.FindNextSet(220), FloorBitset::npos);
+    EXPECT_EQ(stops.FindPrevSet(69), 3);
+    EXPECT_EQ(stops.FindPrevSet(2), -5);
+    EXPECT_EQ(stops.FindPrevSet(-6), FloorBitset::npos);
+    EXPECT_EQ(stops.FindFirst(), -5);
+    EXPECT_EQ(stops.FindLast(), 219);
+
+    stops.Reset(70);
+    EXPECT_FALSE(stops.Test(70));
+    EXPECT_EQ(stops.FindNextSet(4), 219);
+    EXPECT_EQ(stops.ToVector(), (std::vector<int>{-5, 3, 219}));
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, CarServesStopsInSweepOrder) {
+    ElevatorCar car(1, 5, 8);
+    car.travel_direction = 1;
+    car.AddStop(9, true);
+    car.AddStop(7, false);   // Down call above the car waits for the way back
+    car.AddStop(2, false);
+
+    EXPECT_EQ(car.GetNextStop(), 9);
+
+    car.current_floor = 9.0f;
+    car.RemoveCurrentStop();
+    EXPECT_EQ(car.GetNextStop(), 7);
+
+    car.travel_direction = -1;
+    car.current_floor = 7.0f;
+    car.RemoveCurrentStop();
+    EXPECT_EQ(car.GetNextStop(), 2);
+
+    car.passenger_counts.Add(2);
+    car.passenger_counts.Add(2);
+    EXPECT_EQ(car.passenger_counts.Get(2), 2);
+    car.passenger_counts.Remove(2);
+    EXPECT_EQ(car.passenger_counts.Get(2), 1);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, HistogramReportsPercentiles) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 100; i++) {
+        histogram.Record(static_cast<float>(i) * 0.5f);   // 0 to 49.5 seconds
+    }
+    histogram.Record(500.0f);
+
+    EXPECT_EQ(histogram.count, 101u);
+    EXPECT_NEAR(histogram.GetPercentile(0.50f), 25.0f, 1.0f);
+    EXPECT_NEAR(histogram.GetPercentile(0.95f), 47.5f, 2.0f);
+    EXPECT_FLOAT_EQ(histogram.GetPercentile(1.0f), 500.0f);
+    EXPECT_LE(histogram.GetPercentile(0.50f), histogram.GetPercentile(0.95f));
+    EXPECT_LE(histogram.GetPercentile(0.95f), histogram.GetPercentile(0.99f));
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, ShaftTelemetryRecordsCompletedTrips) {
+    auto shaft = CreateShaft(0, 10);
+    CreateCar(shaft, 5);
+
+    CreateRider(0, 4);
+    Step(150);
+
+    ASSERT_TRUE(shaft.has<ElevatorTelemetry>());
+    const auto& telemetry = shaft.get<ElevatorTelemetry>();
+    EXPECT_EQ(telemetry.total_trips, 1u);
+    EXPECT_GT(telemetry.wait_times.GetMean(), 0.0f);        // The car had to come down from floor 5
+    EXPECT_GT(telemetry.ride_times.GetMean(), 0.0f);
+    EXPECT_GT(telemetry.GetUtilization(), 0.0f);
+    EXPECT_LT(telemetry.GetUtilization(), 1.0f);            // Idle once the rider is out
+    EXPECT_EQ(telemetry.GetRecentWaitTimes(0).count, 1u);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, CallOriginsAreLearnedPerHourOfDay) {
+    ElevatorTelemetry telemetry(0);
+    for (int i = 0; i < 4; i++) {
+        telemetry.RecordCallOrigin(8, 0);        // Day 0, 08:00 - lobby
+    }
+    telemetry.RecordCallOrigin(8, 12);
+    telemetry.RecordCallOrigin(17, 12);
+
+    EXPECT_EQ(telemetry.GetBusiestCallFloors(8, 2, 1.0f), (std::vector<int>{0, 12}));
+    EXPECT_EQ(telemetry.GetBusiestCallFloors(17, 2, 1.0f), (std::vector<int>{12}));
+    EXPECT_TRUE(telemetry.GetBusiestCallFloors(9, 2, 1.0f).empty());
+
+    // A new day fades what was learned before
+    for (int i = 0; i < 3; i++) {
+        telemetry.RecordCallOrigin(24 + 8, 12);
+    }
+    EXPECT_EQ(telemetry.GetBusiestCallFloors(8, 1, 1.0f), (std::vector<int>{12}));
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, IdleCarParksAtLearnedCallFloor) {
+    auto shaft = CreateShaft(0, 10);
+    auto car = CreateCar(shaft, 8);
+    Step(1);
+
+    // Without a TimeManager the world clock is hour 0
+    auto& telemetry = shaft.get_mut<ElevatorTelemetry>();
+    for (int i = 0; i < 3; i++) {
+        telemetry.RecordCallOrigin(0, 2);
+    }
+
+    Step(150);
+
+    EXPECT_EQ(car.get<ElevatorCar>().GetCurrentFloorInt(), 2);
+    EXPECT_EQ(ecs_world->GetWorld().get<ElevatorParkingPolicy>().total_repositions, 1);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, DisabledParkingLeavesIdleCarsInPlace) {
+    ecs_world->GetWorld().get_mut<ElevatorParkingPolicy>().enabled = false;
+    auto shaft = CreateShaft(0, 10);
+    auto car = CreateCar(shaft, 8);
+    Step(1);
+
+    auto& telemetry = shaft.get_mut<ElevatorTelemetry>();
+    for (int i = 0; i < 3; i++) {
+        telemetry.RecordCallOrigin(0, 2);
+    }
+
+    Step(150);
+
+    EXPECT_EQ(car.get<ElevatorCar>().GetCurrentFloorInt(), 8);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, ExpressShaftOnlyTakesCallsAtServedFloors) {
+    auto shaft = ecs_world->GetWorld().entity();
+    ElevatorShaft express(5, 0, 30, 1);
+    express.SetServedFloors({0, 20, 30});
+    shaft.set<ElevatorShaft>(express);
+
+    EXPECT_TRUE(express.ServesFloor(20));
+    EXPECT_FALSE(express.ServesFloor(10));
+    EXPECT_EQ(express.GetServedFloorCount(), 3);
+    EXPECT_EQ(express.CountServedFloorsBetween(0, 30), 1);
+
+    auto& dispatcher = shaft.get_mut<ElevatorDispatcher>();
+    EXPECT_NE(dispatcher.GetCall(20, true), nullptr);
+    EXPECT_EQ(dispatcher.GetCall(10, true), nullptr);
+    EXPECT_FALSE(dispatcher.RegisterCall(10, true, 1234, 0.0));
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, RouterPrefersExpressShaftForLongTrips) {
+    auto local = CreateShaft(0, 30, 5);
+    auto express = ecs_world->GetWorld().entity();
+    ElevatorShaft express_shaft(8, 0, 30, 1);
+    express_shaft.SetServedFloors({0, 30});
+    express.set<ElevatorShaft>(express_shaft);
+    Step(1);
+
+    // The express shaft is a few columns further but skips 29 possible stops
+    const std::vector<TripLeg> long_trip = ecs_world->GetWorld().get_mut<ShaftRoutingTable>().FindRoute(0, 30, 5.0f);
+    ASSERT_EQ(long_trip.size(), 1u);
+    EXPECT_EQ(long_trip.front().shaft_id, express.id());
+
+    // Floors the express passes by are only reachable on the local shaft
+    EXPECT_EQ(GetRoutes().GetCandidates(0, 15).size(), 1u);
+    const std::vector<TripLeg> short_trip = ecs_world->GetWorld().get_mut<ShaftRoutingTable>().FindRoute(0, 15, 8.0f);
+    ASSERT_EQ(short_trip.size(), 1u);
+    EXPECT_EQ(short_trip.front().shaft_id, local.id());
+
+    // Routes are returned by value, so the earlier one is untouched by the later lookup
+    EXPECT_EQ(long_trip.front().shaft_id, express.id());
+    EXPECT_EQ(long_trip.front().alight_floor, 30);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, RiderTakesExpressToSkyLobbyThenLocal) {
+    auto express = ecs_world->GetWorld().entity();
+    ElevatorShaft express_shaft(5, 0, 20, 1);
+    express_shaft.SetServedFloors({0, 20});
+    express.set<ElevatorShaft>(express_shaft);
+    auto upper_local = CreateShaft(20, 30, 7);
+    CreateCar(express, 0);
+    CreateCar(upper_local, 20);
+
+    auto rider = CreateRider(0, 25);
+    Step(600);
+
+    const auto& arrived = rider.get<Person>();
+    EXPECT_EQ(arrived.current_floor, 25);
+    EXPECT_EQ(arrived.state, PersonState::AtDestination);
+    EXPECT_EQ(express.get<ElevatorTelemetry>().total_trips, 1u);
+    EXPECT_EQ(upper_local.get<ElevatorTelemetry>().total_trips, 1u);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, ShortTripWalksOverStairs) {
+    auto shaft = CreateShaft(0, 10);
+    CreateCar(shaft, 0);
+    CreateStairs(3, 6);
+    CreateStairs(4, 6);
+
+    auto rider = CreateRider(3, 5);
+    Step(1);
+    ASSERT_TRUE(rider.has<StairsTrip>());
+    EXPECT_FALSE(rider.has<PersonElevatorRequest>());
+    EXPECT_EQ(rider.get<StairsTrip>().to_floor, 4);
+
+    // Two flights plus the walk to and from the stairs
+    Step(200);
+    const auto& person = rider.get<Person>();
+    EXPECT_EQ(person.current_floor, 5);
+    EXPECT_FLOAT_EQ(person.current_column, 5.0f);
+    EXPECT_EQ(person.state, PersonState::AtDestination);
+    EXPECT_FALSE(rider.has<StairsTrip>());
+    EXPECT_FALSE(shaft.get<ElevatorDispatcher>().GetCall(3, true)->IsActive());
+    EXPECT_EQ(shaft.get<ElevatorTelemetry>().total_trips, 0u);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, LongerTripsKeepRidingTheElevator) {
+    auto shaft = CreateShaft(0, 10);
+    CreateCar(shaft, 0);
+    for (int floor = 0; floor < 3; ++floor) {
+        CreateStairs(floor, 5);
+    }
+
+    auto rider = CreateRider(0, 3);
+    Step(1);
+    EXPECT_TRUE(rider.has<PersonElevatorRequest>());
+    EXPECT_FALSE(rider.has<StairsTrip>());
+
+    // A single floor down is quicker on foot
+    auto walker = CreateRider(2, 1);
+    Step(1);
+    EXPECT_TRUE(walker.has<StairsTrip>());
+    EXPECT_EQ(GetRoutes().FindStairsRoute(2, 1, 5.0f)->bottom_floor, 1);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, WalkersWaitAtGapsInTheFloor) {
+    TowerGrid& grid = ecs_world->GetTowerGrid();
+    ASSERT_TRUE(grid.BuildFloor(1, 0, 5));
+    ASSERT_TRUE(grid.BuildFloor(1, 8, 10));
+
+    auto walker = ecs_world->GetWorld().entity();
+    Person person("Walker", 1, 2.0f, 2.0f, NPCType::Visitor);
+    person.SetDestination(1, 9.0f);
+    walker.set<Person>(person);
+
+    auto neighbour = ecs_world->GetWorld().entity();
+    Person next_door("Neighbour", 1, 2.0f, 2.0f, NPCType::Visitor);
+    next_door.SetDestination(1, 4.0f);
+    neighbour.set<Person>(next_door);
+
+    // The walker stops in the last cell before the gap and keeps the trip instead of giving up
+    Step(60);
+    EXPECT_EQ(walker.get<Person>().state, PersonState::Walking);
+    EXPECT_NE(walker.get<Person>().current_need, "No route");
+    EXPECT_FLOAT_EQ(walker.get<Person>().current_column, 4.5f);
+    EXPECT_EQ(neighbour.get<Person>().state, PersonState::AtDestination);
+    EXPECT_FLOAT_EQ(neighbour.get<Person>().current_column, 4.0f);
+    EXPECT_GE(ecs_world->GetWorld().get<FloorFlowFields>().fields_built, 2);
+
+    // Filling in the gap rebuilds the floor's fields and the walker carries on
+    ASSERT_TRUE(grid.BuildFloor(1, 5, 3));
+    Step(60);
+    EXPECT_EQ(walker.get<Person>().state, PersonState::AtDestination);
+    EXPECT_FLOAT_EQ(walker.get<Person>().current_column, 9.0f);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, CrowdedCellsSlowWalkersDown) {
+    for (int i = 0; i < 7; ++i) {
+        auto bystander = ecs_world->GetWorld().entity();
+        bystander.set<Person>(Person("Bystander", 0, 10.5f));
+    }
+    auto walker = ecs_world->GetWorld().entity();
+    Person person("Walker", 0, 10.2f, 2.0f, NPCType::Visitor);
+    person.SetDestination(0, 20.0f);
+    walker.set<Person>(person);
+
+    auto free_walker = ecs_world->GetWorld().entity();
+    Person free_person("Free", 0, 0.2f, 2.0f, NPCType::Visitor);
+    free_person.SetDestination(0, 9.0f);
+    free_walker.set<Person>(free_person);
+
+    Step(2);
+    const auto& density = ecs_world->GetWorld().get<CrowdDensity>();
+    EXPECT_EQ(density.GetCount(0, 10), 8);
+    EXPECT_EQ(density.peak_count, 8);
+    EXPECT_FLOAT_EQ(density.GetSpeedFactor(0, 10), density.comfortable_per_cell / 8.0f);
+    EXPECT_FLOAT_EQ(density.GetSpeedFactor(0, 3), 1.0f);
+
+    // Two ticks at full speed cover 0.4 columns; squeezing through eight people covers far less
+    EXPECT_NEAR(free_walker.get<Person>().current_column, 0.6f, 0.01f);
+    EXPECT_LT(walker.get<Person>().current_column, 10.4f);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, HallQueueLinesUpAwayFromTheShaft) {
+    auto shaft = CreateShaft(0, 10);
+    auto car = CreateCar(shaft, 10);
+    car.get_mut<ElevatorCar>().floors_per_second = 0.01f;   // Keep the queue waiting
+
+    for (int i = 0; i < 10; ++i) {
+        CreateRider(0, 5);
+    }
+    Step(100);
+
+    // Everyone stands at their place in line: four at the doors, then one cell further per four people
+    const auto& density = ecs_world->GetWorld().get<CrowdDensity>();
+    const HallCall* call = shaft.get<ElevatorDispatcher>().GetCall(0, true);
+    ASSERT_EQ(call->GetWaitingCount(), 10);
+    for (int position = 0; position < 10; ++position) {
+        const auto& person = ecs_world->GetWorld().entity(call->queue[position].person_id).get<Person>();
+        EXPECT_EQ(person.state, PersonState::WaitingForElevator);
+        EXPECT_FLOAT_EQ(person.current_column, density.GetQueueColumn(5, true, position));
+    }
+    EXPECT_FLOAT_EQ(density.GetQueueColumn(5, true, 9), 3.0f);
+    EXPECT_EQ(density.GetCount(0, 5), density.queue_slots_per_cell);
+    EXPECT_EQ(density.GetCount(0, 3), 2);
+}
+
+TEST_F(ElevatorDispatchIntegrationTest, EvacuationClearsTheTowerOverFireStairs) {
+    TowerGrid& grid = ecs_world->GetTowerGrid();
+    for (int floor = 0; floor <= 5; ++floor) {
+        ASSERT_TRUE(grid.BuildFloor(floor));
+    }
+    auto shaft = CreateShaft(0, 3);
+    CreateCar(shaft, 0);
+
+    std::vector<flecs::entity> people;
+    for (const float column : {10.0f, 12.0f, 20.0f}) {
+        auto person = ecs_world->GetWorld().entity();
+        person.set<Person>(Person("Worker", 3, column));
+        people.push_back(person);
+    }
+    auto rider = CreateRider(0, 3);
+    people.push_back(rider);
+
+    // Floor 5 has no stairs or shaft down to it
+    auto stranded = ecs_world->GetWorld().entity();
+    stranded.set<Person>(Person("Stranded", 5, 10.0f));
+
+    ecs_world->GetWorld().get_mut<Evacuation>().Begin();
+    Step(1);
+    const auto& evacuation = ecs_world->GetWorld().get<Evacuation>();
+    EXPECT_TRUE(evacuation.active);
+    EXPECT_EQ(evacuation.evacuees, 5);
+    EXPECT_EQ(evacuation.trapped, 1);
+    EXPECT_FALSE(rider.has<PersonElevatorRequest>());
+    EXPECT_EQ(rider.get<Person>().state, PersonState::Evacuating);
+
+    // Three flights of fire stairs beside the shaft, then out at either end of the ground floor
+    Step(600);
+    EXPECT_TRUE(evacuation.IsClear());
+    EXPECT_EQ(evacuation.evacuated, 4);
+    EXPECT_GT(evacuation.time_to_clear, 3.0f * evacuation.fire_stairs_seconds_per_floor);
+    for (const auto& person_entity : people) {
+        const auto& person = person_entity.get<Person>();
+        EXPECT_EQ(person.state, PersonState::AtDestination);
+        EXPECT_EQ(person.current_floor, 0);
+        EXPECT_TRUE(person.current_column < 1.0f || person.current_column >= grid.GetColumnCount() - 1.0f);
+    }
+    EXPECT_EQ(stranded.get<Person>().current_floor, 5);
+
+    ecs_world->GetWorld().get_mut<Evacuation>().End();
+    Step(1);
+    EXPECT_FALSE(evacuation.active);
+    EXPECT_FALSE(rider.has<Evacuee>());
+    EXPECT_EQ(stranded.get<Person>().state, PersonState::AtDestination);
+}
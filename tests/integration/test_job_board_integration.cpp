@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "core/ecs_world.hpp"
+#include "core/facility_manager.hpp"
+#include "core/components.hpp"
+
+using namespace towerforge::core;
+
+// Integration tests for the JobBoard
+// These tests verify that open positions are tracked incrementally as facilities
+// are placed and removed, and as employees are hired, fired or despawned
+
+class JobBoardIntegrationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ecs_world = std::make_unique<ECSWorld>(1920, 1080, 64, 64);
+        ecs_world->Initialize();
+    }
+
+    const JobBoard& GetBoard() const {
+        return ecs_world->GetWorld().get<JobBoard>();
+    }
+
+    flecs::entity CreateJobSeeker(const char* name) const {
+        auto seeker = ecs_world->CreateEntity(name);
+        seeker.set<Person>({name, 0, 2.0f, 2.0f, NPCType::Visitor});
+        seeker.set<VisitorInfo>({VisitorActivity::JobSeeking});
+        return seeker;
+    }
+
+    std::unique_ptr<ECSWorld> ecs_world;
+};
+
+TEST_F(JobBoardIntegrationTest, FacilityPlacementPostsPositions) {
+    auto office = ecs_world->GetFacilityManager().CreateFacility(
+        BuildingComponent::Type::Office, 1, 0, 0
+    );
+    ASSERT_TRUE(office.is_valid());
+
+    const int required = office.get<BuildingComponent>().GetRequiredEmployees();
+    EXPECT_GT(required, 0);
+    EXPECT_EQ(GetBoard().GetOpenPositions(office.id()), required);
+    EXPECT_EQ(GetBoard().total_open_positions, required);
+}
+
+TEST_F(JobBoardIntegrationTest, FacilityRemovalDropsPosting) {
+    auto& facility_mgr = ecs_world->GetFacilityManager();
+    auto shop = facility_mgr.CreateFacility(BuildingComponent::Type::RetailShop, 1, 0, 0);
+    ASSERT_TRUE(shop.is_valid());
+    const auto shop_id = shop.id();
+
+    EXPECT_NE(GetBoard().GetPosting(shop_id), nullptr);
+
+    EXPECT_TRUE(facility_mgr.RemoveFacility(shop));
+    EXPECT_EQ(GetBoard().GetPosting(shop_id), nullptr);
+    EXPECT_EQ(GetBoard().total_open_positions, 0);
+}
+
+TEST_F(JobBoardIntegrationTest, JobSeekerIsHiredFromBoard) {
+    auto shop = ecs_world->GetFacilityManager().CreateFacility(
+        BuildingComponent::Type::RetailShop, 1, 0, 0
+    );
+    ASSERT_TRUE(shop.is_valid());
+    const int required = shop.get<BuildingComponent>().GetRequiredEmployees();
+
+    auto seeker = CreateJobSeeker("Seeker");
+
+    // Job assignment runs on a 2 second interval
+    for (int i = 0; i < 5; ++i) {
+        ecs_world->Update(1.0f);
+    }
+
+    ASSERT_TRUE(seeker.has<EmploymentInfo>());
+    EXPECT_FALSE(seeker.has<VisitorInfo>());
+
+    const auto& employment = seeker.get<EmploymentInfo>();
+    EXPECT_EQ(employment.workplace_facility_id, shop.id());
+    EXPECT_EQ(employment.workplace_floor, 1);
+    EXPECT_EQ(GetBoard().GetOpenPositions(shop.id()), required - 1);
+}
+
+TEST_F(JobBoardIntegrationTest, DespawnedEmployeeReopensPosition) {
+    auto shop = ecs_world->GetFacilityManager().CreateFacility(
+        BuildingComponent::Type::RetailShop, 1, 0, 0
+    );
+    ASSERT_TRUE(shop.is_valid());
+    const int required = shop.get<BuildingComponent>().GetRequiredEmployees();
+
+    auto seeker = CreateJobSeeker("Seeker");
+    for (int i = 0; i < 5; ++i) {
+        ecs_world->Update(1.0f);
+    }
+    ASSERT_TRUE(seeker.has<EmploymentInfo>());
+    EXPECT_EQ(GetBoard().GetOpenPositions(shop.id()), required - 1);
+
+    seeker.destruct();
+    EXPECT_EQ(GetBoard().GetOpenPositions(shop.id()), required);
+}
+
+TEST_F(JobBoardIntegrationTest, DirectlyPlacedEmployeeFillsPosition) {
+    auto office = ecs_world->GetFacilityManager().CreateFacility(
+        BuildingComponent::Type::Office, 1, 0, 0
+    );
+    ASSERT_TRUE(office.is_valid());
+    const int required = office.get<BuildingComponent>().GetRequiredEmployees();
+
+    auto employee = ecs_world->CreateEntity("Placed");
+    employee.set<Person>({"Placed", 0, 5.0f, 2.0f, NPCType::Employee});
+    employee.set<EmploymentInfo>({"Office Worker", 1, 2, 9.0f, 17.0f});
+
+    EXPECT_EQ(employee.get<EmploymentInfo>().workplace_facility_id, office.id());
+    EXPECT_EQ(GetBoard().GetOpenPositions(office.id()), required - 1);
+    EXPECT_EQ(GetBoard().total_open_positions, required - 1);
+
+    employee.destruct();
+    EXPECT_EQ(GetBoard().GetOpenPositions(office.id()), required);
+}
+
+TEST_F(JobBoardIntegrationTest, EmployeePlacedBeforeFacilityIsCounted) {
+    auto employee = ecs_world->CreateEntity("Early");
+    employee.set<Person>({"Early", 0, 5.0f, 2.0f, NPCType::Employee});
+    employee.set<EmploymentInfo>({"Office Worker", 1, 2, 9.0f, 17.0f});
+    EXPECT_EQ(employee.get<EmploymentInfo>().workplace_facility_id, 0u);
+
+    auto office = ecs_world->GetFacilityManager().CreateFacility(
+        BuildingComponent::Type::Office, 1, 0, 0
+    );
+    ASSERT_TRUE(office.is_valid());
+    const int required = office.get<BuildingComponent>().GetRequiredEmployees();
+
+    EXPECT_EQ(employee.get<EmploymentInfo>().workplace_facility_id, office.id());
+    EXPECT_EQ(GetBoard().GetOpenPositions(office.id()), required - 1);
+}
+
+TEST_F(JobBoardIntegrationTest, LeastStaffedFacilityIsFilledFirst) {
+    JobBoard board;
+    const BuildingComponent shop(BuildingComponent::Type::RetailShop, 1, 0, 4, 10);
+    const BuildingComponent restaurant(BuildingComponent::Type::Restaurant, 2, 0, 4, 10);
+
+    board.PostFacility(1, shop, true);
+    board.PostFacility(2, restaurant, true);
+    EXPECT_EQ(board.total_open_positions, shop.GetRequiredEmployees() + restaurant.GetRequiredEmployees());
+
+    std::uint64_t facility_id = 0;
+    ASSERT_TRUE(board.ClaimOpening(facility_id));
+    EXPECT_EQ(facility_id, 1u);
+
+    // Facility 1 now has one employee, so the unstaffed restaurant is next
+    ASSERT_TRUE(board.ClaimOpening(facility_id));
+    EXPECT_EQ(facility_id, 2u);
+
+    // Claiming every remaining position empties the board
+    int claimed = 2;
+    while (board.ClaimOpening(facility_id)) {
+        claimed++;
+    }
+    EXPECT_EQ(claimed, shop.GetRequiredEmployees() + restaurant.GetRequiredEmployees());
+    EXPECT_EQ(board.total_open_positions, 0);
+
+    board.ReleasePosition(2);
+    ASSERT_TRUE(board.ClaimOpening(facility_id));
+    EXPECT_EQ(facility_id, 2u);
+}
+
+TEST_F(JobBoardIntegrationTest, NonHireablePostingsAreNotClaimed) {
+    JobBoard board;
+    const BuildingComponent gym(BuildingComponent::Type::Gym, 1, 0, 4, 10);
+    board.PostFacility(7, gym, false);
+
+    EXPECT_EQ(board.GetOpenPositions(7), gym.GetRequiredEmployees());
+
+    std::uint64_t facility_id = 0;
+    EXPECT_FALSE(board.ClaimOpening(facility_id));
+}
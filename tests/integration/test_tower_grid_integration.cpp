@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "core/tower_grid.hpp"
+#include "core/components.hpp"
 
 using namespace towerforge::core;
 
@@ -229,3 +230,98 @@ TEST_F(TowerGridIntegrationTest, ClearAllFacilities) {
     EXPECT_FALSE(grid->IsOccupied(0, 0));
     EXPECT_FALSE(grid->IsOccupied(1, 2));
 }
+
+TEST_F(TowerGridIntegrationTest, ChangeJournalRecordsLayoutEdits) {
+    const std::uint64_t start = grid->GetChangeSequence();
+    ASSERT_TRUE(grid->BuildFloor(2, 0, 6));
+    ASSERT_TRUE(grid->PlaceFacility(2, 1, 3, 42));
+    ASSERT_TRUE(grid->RemoveFacility(42));
+    grid->AddColumn();
+
+    std::vector<GridChange> changes;
+    ASSERT_TRUE(grid->GetChangesSince(start, changes));
+    ASSERT_EQ(changes.size(), 4u);
+    EXPECT_EQ(changes[0].floor, 2);
+    EXPECT_EQ(changes[0].width, 6);
+    EXPECT_EQ(changes[1].column, 1);
+    EXPECT_EQ(changes[1].width, 3);
+    EXPECT_EQ(changes[2].column, 1);
+    EXPECT_EQ(changes[2].width, 3);
+    EXPECT_EQ(changes[3].floor, GridChange::ALL_FLOORS);
+    EXPECT_EQ(changes[3].sequence, grid->GetChangeSequence());
+
+    // Nothing new since the latest entry
+    EXPECT_TRUE(grid->GetChangesSince(grid->GetChangeSequence(), changes));
+    EXPECT_TRUE(changes.empty());
+
+    // Readers that fell behind the bounded journal are told to start over
+    for (size_t i = 0; i < TowerGrid::JOURNAL_CAPACITY; ++i) {
+        grid->BuildFloor(3, 0, 1);
+    }
+    EXPECT_FALSE(grid->GetChangesSince(start, changes));
+}
+
+TEST_F(TowerGridIntegrationTest, FlowFieldStopsAtGapsInTheFloor) {
+    ASSERT_TRUE(grid->BuildFloor(1, 0, 4));
+    ASSERT_TRUE(grid->BuildFloor(1, 6, 4));
+    ASSERT_TRUE(grid->PlaceFacility(1, 1, 2, 7));
+
+    FloorFlowFields flow_fields(grid.get());
+    const FloorFlowFields::Field* field = flow_fields.GetField(1, 0);
+    ASSERT_NE(field, nullptr);
+    EXPECT_EQ(field->step[3], -1);
+    EXPECT_FLOAT_EQ(field->cost[3], 1.0f + 2.0f * flow_fields.facility_cell_cost);
+    EXPECT_EQ(field->step[7], 0);
+    EXPECT_TRUE(std::isinf(field->cost[7]));
+
+    // Cells that are not built cannot be targets
+    EXPECT_EQ(flow_fields.GetField(1, 5), nullptr);
+
+    // Walkers heading to the same target share the cached field
+    EXPECT_EQ(flow_fields.GetField(1, 0), field);
+    EXPECT_EQ(flow_fields.fields_built, 1);
+}
+
+TEST_F(TowerGridIntegrationTest, FlowFieldsRebuildOnlyChangedFloors) {
+    ASSERT_TRUE(grid->BuildFloor(1, 0, 4));
+    ASSERT_TRUE(grid->BuildFloor(1, 6, 4));
+
+    FloorFlowFields flow_fields(grid.get());
+    flow_fields.Sync();
+    flow_fields.GetField(0, 9);
+    EXPECT_TRUE(std::isinf(flow_fields.GetField(1, 9)->cost[0]));
+
+    // Filling the gap on floor 1 leaves the ground floor's field alone
+    ASSERT_TRUE(grid->BuildFloor(1, 4, 2));
+    flow_fields.Sync();
+    EXPECT_EQ(flow_fields.floors_invalidated, 1);
+    EXPECT_EQ(flow_fields.GetField(1, 9)->step[0], 1);
+    EXPECT_EQ(flow_fields.fields_built, 3);
+}
+
+TEST_F(TowerGridIntegrationTest, EvacuationFieldLeadsDownStairwellsToTheExit) {
+    for (int floor = 0; floor <= 2; ++floor) {
+        ASSERT_TRUE(grid->BuildFloor(floor));
+    }
+    const std::vector<StairsConnector> stairwells = {{0, 8, 5.0f}, {1, 2, 5.0f}};
+
+    EvacuationField field;
+    field.Build(*grid, stairwells, {0}, 2.0f, 1.5f);
+    EXPECT_EQ(field.exit_count, 1);
+    EXPECT_EQ(field.stairwell_count, 2);
+
+    // Floor 2 walks left to the stairwell at column 2, floor 1 right to column 8, the ground floor left to the exit
+    const int start = field.GetIndex(2, 5);
+    EXPECT_EQ(field.step[start], EvacuationField::Step::Left);
+    EXPECT_EQ(field.waypoint[start], 2);
+    EXPECT_EQ(field.step[field.GetIndex(2, 2)], EvacuationField::Step::Down);
+    EXPECT_EQ(field.waypoint[field.GetIndex(1, 2)], 8);
+    EXPECT_EQ(field.step[field.GetIndex(1, 8)], EvacuationField::Step::Down);
+    EXPECT_EQ(field.waypoint[field.GetIndex(0, 8)], 0);
+    EXPECT_EQ(field.step[field.GetIndex(0, 0)], EvacuationField::Step::Exit);
+    EXPECT_FLOAT_EQ(field.cost[start], 1.5f + 5.0f + 3.0f + 5.0f + 4.0f);
+
+    // Floors with no stairwell down have no way out
+    EXPECT_TRUE(std::isinf(field.cost[field.GetIndex(3, 5)]));
+    EXPECT_EQ(field.step[field.GetIndex(3, 5)], EvacuationField::Step::None);
+}
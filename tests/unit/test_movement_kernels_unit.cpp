@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "core/movement_kernels.hpp"
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace towerforge::core;
+
+// Unit tests for the batch movement kernels
+// These tests verify the vectorized path matches the scalar reference exactly
+
+class MovementKernelsUnitTest : public ::testing::Test {
+protected:
+    void Fill(const std::size_t count, const unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> column(-50.0f, 250.0f);
+        std::uniform_real_distribution<float> step(0.0f, 4.0f);
+
+        positions.resize(count);
+        targets.resize(count);
+        steps.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            positions[i] = column(rng);
+            // Every few elements start on or right next to their target
+            targets[i] = i % 5 == 0 ? positions[i] + (i % 10 == 0 ? 0.0f : 0.001f) : column(rng);
+            steps[i] = step(rng);
+        }
+    }
+
+    void ExpectMatchesScalar() const {
+        std::vector<float> scalar_positions = positions;
+        std::vector<float> batch_positions = positions;
+        std::vector<std::uint8_t> scalar_arrived(positions.size(), 7);
+        std::vector<std::uint8_t> batch_arrived(positions.size(), 7);
+
+        const std::size_t scalar_count = kernels::AdvanceTowardScalar(
+            scalar_positions.data(), targets.data(), steps.data(), scalar_arrived.data(), positions.size());
+        const std::size_t batch_count = kernels::AdvanceToward(
+            batch_positions.data(), targets.data(), steps.data(), batch_arrived.data(), positions.size());
+
+        EXPECT_EQ(scalar_count, batch_count);
+        EXPECT_EQ(scalar_arrived, batch_arrived);
+        // Bitwise equal, not just close
+        ASSERT_EQ(scalar_positions.size(), batch_positions.size());
+        EXPECT_EQ(0, std::memcmp(scalar_positions.data(), batch_positions.data(), sizeof(float) * positions.size()))
+            << "kernel: " << kernels::GetKernelName();
+    }
+
+    std::vector<float> positions;
+    std::vector<float> targets;
+    std::vector<float> steps;
+};
+
+TEST_F(MovementKernelsUnitTest, ScalarStepsTowardTarget) {
+    float position[3] = {10.0f, 10.0f, 10.0f};
+    const float target[3] = {15.0f, 5.0f, 10.5f};
+    const float step[3] = {1.0f, 1.0f, 1.0f};
+    std::uint8_t arrived[3] = {};
+
+    EXPECT_EQ(1u, kernels::AdvanceTowardScalar(position, target, step, arrived, 3));
+    EXPECT_FLOAT_EQ(position[0], 11.0f);
+    EXPECT_FLOAT_EQ(position[1], 9.0f);
+    EXPECT_FLOAT_EQ(position[2], 10.5f);
+    EXPECT_EQ(arrived[0], 0);
+    EXPECT_EQ(arrived[1], 0);
+    EXPECT_EQ(arrived[2], 1);
+}
+
+TEST_F(MovementKernelsUnitTest, ZeroStepArrivesOnlyWhenAlreadyThere) {
+    float position[2] = {3.0f, 3.0f};
+    const float target[2] = {3.0f, 4.0f};
+    const float step[2] = {0.0f, 0.0f};
+    std::uint8_t arrived[2] = {};
+
+    EXPECT_EQ(1u, kernels::AdvanceToward(position, target, step, arrived, 2));
+    EXPECT_EQ(arrived[0], 1);
+    EXPECT_EQ(arrived[1], 0);
+    EXPECT_FLOAT_EQ(position[1], 3.0f);
+}
+
+TEST_F(MovementKernelsUnitTest, VectorPathMatchesScalarReference) {
+    Fill(4096, 1);
+    ExpectMatchesScalar();
+}
+
+TEST_F(MovementKernelsUnitTest, TailsMatchScalarReference) {
+    // Lengths around the 4- and 8-wide block sizes exercise the scalar tail
+    for (std::size_t count = 0; count <= 19; ++count) {
+        Fill(count, static_cast<unsigned>(count) + 100);
+        ExpectMatchesScalar();
+    }
+}
+
+TEST_F(MovementKernelsUnitTest, RepeatedTicksStayInLockstep) {
+    Fill(1001, 7);
+    std::vector<float> scalar_positions = positions;
+    std::vector<float> batch_positions = positions;
+    std::vector<std::uint8_t> scalar_arrived(positions.size());
+    std::vector<std::uint8_t> batch_arrived(positions.size());
+
+    for (int tick = 0; tick < 200; ++tick) {
+        kernels::AdvanceTowardScalar(scalar_positions.data(), targets.data(), steps.data(), scalar_arrived.data(),
+                                     positions.size());
+        kernels::AdvanceToward(batch_positions.data(), targets.data(), steps.data(), batch_arrived.data(),
+                               positions.size());
+    }
+
+    EXPECT_EQ(scalar_positions, batch_positions);
+    EXPECT_EQ(scalar_arrived, batch_arrived);
+}
@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include "core/components.hpp"
+#include "core/ecs_world.hpp"
+#include "core/facility_manager.hpp"
+#include "core/offline_catch_up.hpp"
+#include <memory>
+
+using namespace towerforge::core;
+
+// Unit tests for the closed-form catch-up paths on components
+// These tests verify one long step matches the per-second updates it replaces,
+// and that a pass starts from the tower as it was saved
+
+class OfflineCatchUpUnitTest : public ::testing::Test {
+protected:
+    // Mirror of the once-a-second churn and revenue systems
+    static float StepTenants(FacilityEconomics& economics, const int seconds, const float satisfaction_score,
+                             const bool has_room) {
+        float revenue = 0.0f;
+        for (int i = 0; i < seconds; ++i) {
+            if (satisfaction_score > 70.0f && economics.current_tenants < economics.max_tenants) {
+                if (has_room) {
+                    economics.current_tenants++;
+                }
+            } else if (satisfaction_score < 30.0f && economics.current_tenants > 0) {
+                economics.current_tenants--;
+            }
+            economics.quality_multiplier = 0.5f + (satisfaction_score / 100.0f) * 1.5f;
+            revenue += economics.CalculateDailyRevenue() / (24.0f * 3600.0f);
+        }
+        return revenue;
+    }
+};
+
+TEST_F(OfflineCatchUpUnitTest, TenantRampMatchesPerSecondChurn) {
+    for (const float satisfaction : {85.0f, 50.0f, 20.0f}) {
+        for (const int seconds : {3, 7, 40}) {
+            FacilityEconomics stepped(120.0f, 20.0f, 12);
+            stepped.current_tenants = 4;
+            FacilityEconomics caught_up = stepped;
+
+            const float stepped_revenue = StepTenants(stepped, seconds, satisfaction, true);
+            const float caught_up_revenue = caught_up.CatchUp(static_cast<float>(seconds), satisfaction, true);
+
+            EXPECT_EQ(caught_up.current_tenants, stepped.current_tenants) << satisfaction << " / " << seconds;
+            EXPECT_NEAR(caught_up_revenue, stepped_revenue, 1e-3f) << satisfaction << " / " << seconds;
+            EXPECT_FLOAT_EQ(caught_up.quality_multiplier, stepped.quality_multiplier);
+        }
+    }
+}
+
+TEST_F(OfflineCatchUpUnitTest, FullFacilityTakesNoNewTenants) {
+    FacilityEconomics economics(100.0f, 20.0f, 10);
+    economics.current_tenants = 3;
+    economics.CatchUp(60.0f, 90.0f, false);
+    EXPECT_EQ(economics.current_tenants, 3);
+}
+
+TEST_F(OfflineCatchUpUnitTest, AccrueSpanClosesCrossedDays) {
+    TowerEconomy economy(1000.0f);
+    economy.daily_revenue = 50.0f;
+
+    // Three quarters of the span fell before the last day boundary
+    economy.AccrueSpan(400.0f, 100.0f, 2, 0.25f);
+    EXPECT_FLOAT_EQ(economy.total_balance, 1000.0f + 50.0f + 300.0f - 75.0f);
+    EXPECT_FLOAT_EQ(economy.total_revenue, 350.0f);
+    EXPECT_FLOAT_EQ(economy.total_expenses, 75.0f);
+    EXPECT_FLOAT_EQ(economy.daily_revenue, 100.0f);
+    EXPECT_FLOAT_EQ(economy.daily_expenses, 25.0f);
+
+    // Within one day everything stays on the open day
+    economy.AccrueSpan(10.0f, 5.0f, 0, 1.0f);
+    EXPECT_FLOAT_EQ(economy.daily_revenue, 110.0f);
+    EXPECT_FLOAT_EQ(economy.total_revenue, 350.0f);
+}
+
+TEST_F(OfflineCatchUpUnitTest, StatusDegradationIsLinear) {
+    FacilityStatus stepped;
+    FacilityStatus caught_up;
+    for (int i = 0; i < 600; ++i) {
+        stepped.Update(1.0f, 4);
+    }
+    caught_up.Update(600.0f, 4);
+    EXPECT_NEAR(caught_up.cleanliness, stepped.cleanliness, 1e-3f);
+    EXPECT_NEAR(caught_up.maintenance_level, stepped.maintenance_level, 1e-3f);
+
+    MaintenanceStatus maintenance;
+    maintenance.Update(5.0f * 3600.0f, 1.0f);
+    EXPECT_TRUE(maintenance.IsBroken());
+}
+
+TEST_F(OfflineCatchUpUnitTest, TowerPointsMatchHourlySteps) {
+    ResearchTree stepped;
+    stepped.UpdateManagementStaffCount(3);
+    ResearchTree caught_up = stepped;
+
+    for (int i = 0; i < 10; ++i) {
+        stepped.GenerateTowerPoints(0.5f);
+    }
+    caught_up.GenerateTowerPoints(5.0f);
+    EXPECT_EQ(caught_up.total_points_earned, stepped.total_points_earned);
+    EXPECT_EQ(caught_up.total_points_earned, 15);
+}
+
+TEST_F(OfflineCatchUpUnitTest, CohortEmptiesWhenVisitsRunOut) {
+    CrowdCohort cohort(3, VisitorArchetype::Tourist);
+    cohort.count = 100.0f;
+    cohort.remaining_visit_time = 400.0f;
+
+    EXPECT_FLOAT_EQ(cohort.CatchUp(100.0f), 25.0f);
+    EXPECT_FLOAT_EQ(cohort.count, 75.0f);
+    EXPECT_FLOAT_EQ(cohort.remaining_visit_time, 300.0f);
+
+    EXPECT_FLOAT_EQ(cohort.CatchUp(1000.0f), 75.0f);
+    EXPECT_FLOAT_EQ(cohort.count, 0.0f);
+}
+
+TEST_F(OfflineCatchUpUnitTest, ClockRoundTripsThroughAbsoluteHours) {
+    TimeManager time(1.0f);
+    const double start = time.GetAbsoluteHours();
+
+    time.SetAbsoluteHours(start + 24.0 * 9 + 3.5);
+    EXPECT_EQ(time.current_week, 2);
+    EXPECT_EQ(time.current_day, 2);
+    EXPECT_FLOAT_EQ(time.current_hour, 11.5f);
+    EXPECT_DOUBLE_EQ(time.GetAbsoluteHours(), start + 24.0 * 9 + 3.5);
+}
+
+TEST_F(OfflineCatchUpUnitTest, PausedSaveIsNotCaughtUp) {
+    TimeManager clock(1.0f);
+    EXPECT_FLOAT_EQ(OfflineCatchUp::GetSpan(1000, 4600, 8.0f * 3600.0f, clock), 3600.0f);
+    EXPECT_FLOAT_EQ(OfflineCatchUp::GetSpan(0, 100000, 3600.0f, clock), 3600.0f);
+    EXPECT_FLOAT_EQ(OfflineCatchUp::GetSpan(4600, 1000, 3600.0f, clock), 0.0f);
+
+    clock.simulation_speed = 0.0f;
+    EXPECT_FLOAT_EQ(OfflineCatchUp::GetSpan(1000, 4600, 8.0f * 3600.0f, clock), 0.0f);
+
+    // Applying directly to a paused tower leaves its clock and books alone
+    auto ecs_world = std::make_unique<ECSWorld>(1920, 1080, 64, 64);
+    ecs_world->Initialize();
+    auto& world = ecs_world->GetWorld();
+    world.set<TimeManager>(clock);
+    world.set<TowerEconomy>({1000.0f});
+    const double start_hours = world.get<TimeManager>().GetAbsoluteHours();
+
+    EXPECT_TRUE(OfflineCatchUp::Apply(*ecs_world, 3600.0f).IsEmpty());
+    EXPECT_DOUBLE_EQ(world.get<TimeManager>().GetAbsoluteHours(), start_hours);
+    EXPECT_FLOAT_EQ(world.get<TowerEconomy>().total_balance, 1000.0f);
+}
+
+TEST_F(OfflineCatchUpUnitTest, CatchUpUsesOccupancyAtSaveTime) {
+    auto ecs_world = std::make_unique<ECSWorld>(1920, 1080, 64, 64);
+    ecs_world->Initialize();
+    ecs_world->GetWorld().set<TimeManager>({1.0f});
+
+    auto& facility_mgr = ecs_world->GetFacilityManager();
+    auto full = facility_mgr.CreateFacility(BuildingComponent::Type::Office, 1, 0);
+    auto empty = facility_mgr.CreateFacility(BuildingComponent::Type::Office, 2, 0);
+    ASSERT_TRUE(full.is_valid());
+    ASSERT_TRUE(empty.is_valid());
+    for (auto facility : {full, empty}) {
+        FacilityEconomics economics(240.0f, 48.0f, 10);
+        economics.current_tenants = 3;
+        facility.set<FacilityEconomics>(economics);
+        facility.set<Satisfaction>({90.0f});
+    }
+    auto& building = full.get_mut<BuildingComponent>();
+    building.current_occupancy = building.capacity;
+
+    OfflineCatchUp::Apply(*ecs_world, 600.0f);
+
+    // The full office is worn by its occupants and has no room for new tenants
+    EXPECT_LT(full.get<FacilityStatus>().cleanliness, empty.get<FacilityStatus>().cleanliness);
+    EXPECT_EQ(full.get<FacilityEconomics>().current_tenants, 3);
+    EXPECT_EQ(empty.get<FacilityEconomics>().current_tenants, 10);
+}
+
+TEST_F(OfflineCatchUpUnitTest, DegradationRunsAtTheLiveFrameStep) {
+    auto ecs_world = std::make_unique<ECSWorld>(1920, 1080, 64, 64);
+    ecs_world->Initialize();
+    ecs_world->GetWorld().set<TimeManager>({1.0f});
+
+    auto office = ecs_world->GetFacilityManager().CreateFacility(BuildingComponent::Type::Office, 1, 0);
+    ASSERT_TRUE(office.is_valid());
+    FacilityStatus expected = office.get<FacilityStatus>();
+
+    // An hour away wears the office as much as an hour of once-a-second frame steps
+    OfflineCatchUp::Apply(*ecs_world, 3600.0f);
+    expected.Update(3600.0f / OfflineCatchUp::frame_step_period, office.get<BuildingComponent>().current_occupancy);
+    EXPECT_FLOAT_EQ(office.get<FacilityStatus>().cleanliness, expected.cleanliness);
+    EXPECT_FLOAT_EQ(office.get<MaintenanceStatus>().time_since_last_service, 60.0f);
+}
+
+TEST_F(OfflineCatchUpUnitTest, StaffOnShiftServiceTheirFloor) {
+    auto ecs_world = std::make_unique<ECSWorld>(1920, 1080, 64, 64);
+    ecs_world->Initialize();
+    auto& world = ecs_world->GetWorld();
+    world.set<TimeManager>({1.0f});
+
+    auto& facility_mgr = ecs_world->GetFacilityManager();
+    auto staffed = facility_mgr.CreateFacility(BuildingComponent::Type::Office, 1, 0);
+    auto unstaffed = facility_mgr.CreateFacility(BuildingComponent::Type::Office, 2, 0);
+    ASSERT_TRUE(staffed.is_valid());
+    ASSERT_TRUE(unstaffed.is_valid());
+    for (auto facility : {staffed, unstaffed}) {
+        facility.get_mut<FacilityStatus>().degradation_rate = 20.0f;
+    }
+    world.entity().set<StaffAssignment>(StaffAssignment(StaffRole::Janitor, 1));
+    world.entity().set<StaffAssignment>(StaffAssignment(StaffRole::Maintenance, 1));
+
+    // Five hours of frame-step wear
+    OfflineCatchUp::Apply(*ecs_world, 5.0f * 3600.0f * OfflineCatchUp::frame_step_period);
+
+    EXPECT_TRUE(unstaffed.get<CleanlinessStatus>().IsDirty());
+    EXPECT_TRUE(unstaffed.get<MaintenanceStatus>().IsBroken());
+    EXPECT_TRUE(unstaffed.get<FacilityStatus>().NeedsCleaning());
+    EXPECT_TRUE(unstaffed.get<FacilityStatus>().NeedsMaintenance());
+
+    EXPECT_FALSE(staffed.get<CleanlinessStatus>().NeedsCleaning());
+    EXPECT_FALSE(staffed.get<MaintenanceStatus>().NeedsService());
+    EXPECT_FALSE(staffed.get<FacilityStatus>().NeedsCleaning());
+    EXPECT_FALSE(staffed.get<FacilityStatus>().NeedsMaintenance());
+}
+
+TEST_F(OfflineCatchUpUnitTest, FractionalDeparturesAddUp) {
+    auto ecs_world = std::make_unique<ECSWorld>(1920, 1080, 64, 64);
+    ecs_world->Initialize();
+    auto& world = ecs_world->GetWorld();
+    world.set<TimeManager>({1.0f});
+
+    auto& crowd = world.get_mut<CrowdSimulation>();
+    CrowdCohort& cohort = crowd.GetCohort(3, VisitorArchetype::Tourist);
+    cohort.count = 100.0f;
+    cohort.remaining_visit_time = 1000.0f;
+    crowd.total_members = 100.0f;
+
+    // A tenth of a member leaves each second, which rounds to nobody on its own
+    for (int i = 0; i < 10; ++i) {
+        OfflineCatchUp::Apply(*ecs_world, 1.0f);
+    }
+    EXPECT_NEAR(world.get<CrowdSimulation>().total_departed, 1.0f, 1e-3f);
+    EXPECT_EQ(world.get<CrowdSimulation>().GetDepartedCount(), 1);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include "core/components.hpp"
+#include <cstring>
+
+using namespace towerforge::core;
+
+// Unit tests for VisitorNeeds growth
+// These tests verify the packed update is closed-form: one long step equals many short ones
+
+class VisitorNeedsUnitTest : public ::testing::Test {
+protected:
+    static VisitorNeeds MakeNeeds(const VisitorArchetype archetype, const float level) {
+        VisitorNeeds needs(archetype);
+        needs.levels.fill(level);
+        return needs;
+    }
+};
+
+TEST_F(VisitorNeedsUnitTest, LevelsArePackedAndAligned) {
+    const VisitorNeeds needs;
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(needs.levels.data()) % 16, 0u);
+    EXPECT_EQ(sizeof(needs.levels), 4 * sizeof(float));
+    EXPECT_EQ(&needs[NeedType::Shopping], &needs.levels[3]);
+}
+
+TEST_F(VisitorNeedsUnitTest, GrowsAtArchetypeRates) {
+    VisitorNeeds needs = MakeNeeds(VisitorArchetype::BusinessPerson, 10.0f);
+    needs.Grow(2.0f * VisitorNeeds::growth_period);
+
+    EXPECT_FLOAT_EQ(needs[NeedType::Hunger], 16.0f);
+    EXPECT_FLOAT_EQ(needs[NeedType::Entertainment], 13.0f);
+    EXPECT_FLOAT_EQ(needs[NeedType::Comfort], 12.0f);
+    EXPECT_FLOAT_EQ(needs[NeedType::Shopping], 12.0f);
+
+    VisitorNeeds shopper = MakeNeeds(VisitorArchetype::Shopper, 10.0f);
+    shopper.Grow(2.0f * VisitorNeeds::growth_period);
+    EXPECT_FLOAT_EQ(shopper[NeedType::Shopping], 15.0f);
+}
+
+TEST_F(VisitorNeedsUnitTest, GrowthClampsAtMaximum) {
+    VisitorNeeds needs = MakeNeeds(VisitorArchetype::Tourist, 95.0f);
+    needs.Grow(1000.0f);
+
+    for (const float level : needs.levels) {
+        EXPECT_EQ(level, VisitorNeeds::max_level);
+    }
+}
+
+TEST_F(VisitorNeedsUnitTest, OneLongStepMatchesManyShortOnes) {
+    // Powers of two keep the float sums exact, so the results must be bitwise equal
+    VisitorNeeds stepped = MakeNeeds(VisitorArchetype::Casual, 20.0f);
+    VisitorNeeds jumped = stepped;
+
+    for (int tick = 0; tick < 96; ++tick) {
+        stepped.Grow(0.5f * VisitorNeeds::growth_period);
+    }
+    jumped.Grow(48.0f * VisitorNeeds::growth_period);
+
+    EXPECT_EQ(0, std::memcmp(stepped.levels.data(), jumped.levels.data(), sizeof(stepped.levels)));
+    EXPECT_EQ(jumped[NeedType::Hunger], VisitorNeeds::max_level);
+    EXPECT_FLOAT_EQ(jumped[NeedType::Comfort], 68.0f);
+}
+
+TEST_F(VisitorNeedsUnitTest, CatchUpGrowsOverSkippedTime) {
+    VisitorNeeds needs = MakeNeeds(VisitorArchetype::Casual, 10.0f);
+
+    // The first touch only stamps the time
+    needs.CatchUp(100.0);
+    EXPECT_FLOAT_EQ(needs[NeedType::Hunger], 10.0f);
+
+    needs.CatchUp(700.0);
+    EXPECT_FLOAT_EQ(needs[NeedType::Hunger], 30.0f);
+    EXPECT_FLOAT_EQ(needs[NeedType::Comfort], 20.0f);
+
+    // Touching again at the same time (or earlier) changes nothing
+    needs.CatchUp(700.0);
+    needs.CatchUp(400.0);
+    EXPECT_FLOAT_EQ(needs[NeedType::Hunger], 30.0f);
+    EXPECT_EQ(needs.updated_at, 700.0);
+}
+
+TEST_F(VisitorNeedsUnitTest, PerSecondRateMatchesOriginalFrameStep) {
+    // The original system grew needs once a second by one 60 fps frame's delta
+    constexpr float frame_delta = 1.0f / 60.0f;
+    for (const VisitorArchetype archetype : {VisitorArchetype::BusinessPerson, VisitorArchetype::Tourist,
+                                             VisitorArchetype::Shopper, VisitorArchetype::Casual}) {
+        VisitorNeeds needs = MakeNeeds(archetype, 10.0f);
+        needs.CatchUp(0.0);
+        needs.CatchUp(1.0);
+        for (std::size_t i = 0; i < VisitorNeeds::need_count; ++i) {
+            EXPECT_FLOAT_EQ(needs.levels[i], 10.0f + needs.GetGrowthRates()[i] * frame_delta);
+        }
+    }
+
+    // A hungry business visitor takes about half an hour, not half a minute, to go from 10 to 100
+    VisitorNeeds needs = MakeNeeds(VisitorArchetype::BusinessPerson, 10.0f);
+    needs.Grow(60.0f);
+    EXPECT_FLOAT_EQ(needs[NeedType::Hunger], 13.0f);
+}
+
+TEST_F(VisitorNeedsUnitTest, ReduceNeedByTypeClampsAtZero) {
+    VisitorNeeds needs = MakeNeeds(VisitorArchetype::Casual, 30.0f);
+    needs.ReduceNeed(NeedType::Comfort, 12.5f);
+    needs.ReduceNeed(NeedType::Shopping, 50.0f);
+
+    EXPECT_FLOAT_EQ(needs[NeedType::Comfort], 17.5f);
+    EXPECT_EQ(needs[NeedType::Shopping], 0.0f);
+    EXPECT_FLOAT_EQ(needs[NeedType::Hunger], 30.0f);
+}
+
+TEST_F(VisitorNeedsUnitTest, HighestNeedTypeIsAnEnum) {
+    VisitorNeeds needs = MakeNeeds(VisitorArchetype::Casual, 10.0f);
+    needs[NeedType::Entertainment] = 70.0f;
+    EXPECT_EQ(needs.GetHighestNeedType(), NeedType::Entertainment);
+    EXPECT_STREQ(VisitorNeeds::GetNeedName(needs.GetHighestNeedType()), "Entertainment");
+
+    // Ties go to the first need
+    needs[NeedType::Hunger] = 70.0f;
+    EXPECT_EQ(needs.GetHighestNeedType(), NeedType::Hunger);
+}
+
+TEST_F(VisitorNeedsUnitTest, FacilityNeedTablesAreInverses) {
+    // Both tables are built at compile time
+    static_assert(GetFacilityNeed(BuildingComponent::Type::Restaurant).serves_need);
+    static_assert(GetFacilityNeed(BuildingComponent::Type::Theater).need == NeedType::Entertainment);
+    static_assert(!GetFacilityNeed(BuildingComponent::Type::Office).serves_need);
+    static_assert(GetNeedFacilityTypes(NeedType::Shopping).count == 2);
+
+    std::size_t serving_types = 0;
+    for (std::size_t need = 0; need < VisitorNeeds::need_count; ++need) {
+        const NeedFacilityTypes& serving = GetNeedFacilityTypes(static_cast<NeedType>(need));
+        EXPECT_GT(serving.count, 0u);
+        for (std::size_t i = 0; i < serving.count; ++i) {
+            const FacilityNeed& served = GetFacilityNeed(serving.types[i]);
+            EXPECT_TRUE(served.serves_need);
+            EXPECT_EQ(served.need, static_cast<NeedType>(need));
+        }
+        serving_types += serving.count;
+    }
+    EXPECT_EQ(serving_types, 6u);
+}
+
+TEST_F(VisitorNeedsUnitTest, ArchetypeDrawsRepeatForTheSameSeed) {
+    std::mt19937 first_rng(7);
+    std::mt19937 second_rng(7);
+    for (int i = 0; i < 50; ++i) {
+        VisitorNeeds first(VisitorArchetype::Tourist);
+        VisitorNeeds second(VisitorArchetype::Tourist);
+        first.InitializeForArchetype(first_rng);
+        second.InitializeForArchetype(second_rng);
+        EXPECT_EQ(first.levels, second.levels);
+
+        // Tourists draw entertainment from 40 up to 69
+        EXPECT_GE(first[NeedType::Entertainment], 40.0f);
+        EXPECT_LE(first[NeedType::Entertainment], 69.0f);
+    }
+}